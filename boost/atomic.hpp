@@ -73,8 +73,9 @@ private:
 	void * operator=(const atomic &);
 };
 
-/* FIXME: pointer arithmetic still missing */
-
+/* pointer arithmetic is performed on an intptr_t, the operand is scaled by
+sizeof(T), so fetch_add and fetch_sub map to a single atomic addition, e.g.
+lock xadd on x86 */
 template<typename T>
 class atomic<T *> : private detail::atomic::internal_atomic<intptr_t> {
 public:
@@ -138,18 +139,26 @@ public:
 	
 	T * fetch_add(ptrdiff_t diff, memory_order order=memory_order_seq_cst) volatile
 	{
-		return (T*)super::fetch_add(diff*sizeof(T), order);
+		return (T*)super::fetch_add(scale(diff), order);
 	}
 	T * fetch_sub(ptrdiff_t diff, memory_order order=memory_order_seq_cst) volatile
 	{
-		return (T*)super::fetch_sub(diff*sizeof(T), order);
+		return (T*)super::fetch_sub(scale(diff), order);
 	}
 	
+	T *operator+=(ptrdiff_t diff) volatile {return fetch_add(diff)+diff;}
+	T *operator-=(ptrdiff_t diff) volatile {return fetch_sub(diff)-diff;}
+	
 	T *operator++(void) volatile {return fetch_add(1)+1;}
 	T *operator++(int) volatile {return fetch_add(1);}
 	T *operator--(void) volatile {return fetch_sub(1)-1;}
 	T *operator--(int) volatile {return fetch_sub(1);}
 private:
+	static intptr_t scale(ptrdiff_t diff)
+	{
+		return (intptr_t)(diff*(ptrdiff_t)sizeof(T));
+	}
+	
 	atomic(const atomic &);
 	T * operator=(const atomic &);
 };
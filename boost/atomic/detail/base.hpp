@@ -8,6 +8,8 @@
 //  http://www.boost.org/LICENSE_1_0.txt)
 
 #include <boost/atomic/detail/fallback.hpp>
+#include <boost/atomic/detail/seqlock.hpp>
+#include <boost/atomic/detail/wait.hpp>
 #include <boost/atomic/detail/builder.hpp>
 #include <boost/atomic/detail/valid_integral_types.hpp>
 
@@ -25,23 +27,41 @@ static inline memory_order calculate_failure_order(memory_order order)
 }
 
 template<typename T, unsigned short Size=sizeof(T)>
-class platform_atomic : public fallback_atomic<T> {
+class platform_atomic_integral : public build_atomic_from_exchange<fallback_atomic<T> > {
 public:
-	typedef fallback_atomic<T> super;
+	typedef build_atomic_from_exchange<fallback_atomic<T> > super;
 
-	explicit platform_atomic(T v) : super(v) {}
-	platform_atomic() {}
+	explicit platform_atomic_integral(T v) : super(v) {}
+	platform_atomic_integral() {}
 protected:
 	typedef typename super::integral_type integral_type;
 };
 
+/* the waiter pool is only instantiated, when wait or notify is used */
+template<typename T>
+struct select_waiter_pool {
+	typedef waiter_pool<platform_atomic_integral<unsigned int> > type;
+};
+
+/* types, which are not supported by the platform, are protected by the
+spinlock pool, unless a seqlock is requested via atomic_use_seqlock */
+template<typename T, bool Seqlock=atomic_use_seqlock<T>::value>
+struct select_fallback_atomic {
+	typedef fallback_atomic<T> type;
+};
+
+template<typename T>
+struct select_fallback_atomic<T, true> {
+	typedef seqlock_atomic<T, platform_atomic_integral<unsigned int> > type;
+};
+
 template<typename T, unsigned short Size=sizeof(T)>
-class platform_atomic_integral : public build_atomic_from_exchange<fallback_atomic<T> > {
+class platform_atomic : public select_fallback_atomic<T>::type {
 public:
-	typedef build_atomic_from_exchange<fallback_atomic<T> > super;
+	typedef typename select_fallback_atomic<T>::type super;
 
-	explicit platform_atomic_integral(T v) : super(v) {}
-	platform_atomic_integral() {}
+	explicit platform_atomic(T v) : super(v) {}
+	platform_atomic() {}
 protected:
 	typedef typename super::integral_type integral_type;
 };
@@ -137,6 +157,22 @@ public:
 	integral_type operator--(void) volatile {return fetch_sub(1)-1;}
 	integral_type operator--(int) volatile {return fetch_sub(1);}
 
+	/* blocks until the value differs from old, may return spuriously */
+	void wait(integral_type old, memory_order order=memory_order_seq_cst) const volatile
+	{
+		select_waiter_pool<T>::type::wait(*this, old, order);
+	}
+	/* wakes at least one thread, which waits for a change of the value */
+	void notify_one(void) volatile
+	{
+		select_waiter_pool<T>::type::notify(*this, false);
+	}
+	/* wakes all threads, which wait for a change of the value */
+	void notify_all(void) volatile
+	{
+		select_waiter_pool<T>::type::notify(*this, true);
+	}
+
 	bool compare_exchange_strong(
 		integral_type &expected,
 		integral_type desired,
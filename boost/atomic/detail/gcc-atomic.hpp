@@ -0,0 +1,233 @@
+#ifndef BOOST_DETAIL_ATOMIC_GCC_ATOMIC_HPP
+#define BOOST_DETAIL_ATOMIC_GCC_ATOMIC_HPP
+
+//  Copyright (c) 2026 Tim Blechmann
+//
+//  Distributed under the Boost Software License, Version 1.0.
+//  See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <string.h>
+
+#include <boost/memory_order.hpp>
+#include <boost/atomic/detail/base.hpp>
+#include <boost/atomic/detail/builder.hpp>
+
+/* implementation for all targets of compilers, which provide the __atomic
+builtins (gcc >= 4.7, clang). The compiler emits the instructions and fences,
+which are required for each memory order on the target architecture.
+
+The builtins only honor the memory order, if it is a compile-time constant
+after inlining, otherwise they are sequentially consistent. */
+
+namespace boost {
+namespace detail {
+namespace atomic {
+
+static inline int gcc_memory_order(memory_order order)
+{
+	switch(order) {
+		case memory_order_relaxed: return __ATOMIC_RELAXED;
+		case memory_order_consume: return __ATOMIC_CONSUME;
+		case memory_order_acquire: return __ATOMIC_ACQUIRE;
+		case memory_order_release: return __ATOMIC_RELEASE;
+		case memory_order_acq_rel: return __ATOMIC_ACQ_REL;
+		default: return __ATOMIC_SEQ_CST;
+	}
+}
+
+/* the failure order of a compare_exchange can not contain a release */
+static inline int gcc_failure_order(memory_order order)
+{
+	switch(order) {
+		case memory_order_release: return __ATOMIC_RELAXED;
+		case memory_order_acq_rel: return __ATOMIC_ACQUIRE;
+		default: return gcc_memory_order(order);
+	}
+}
+
+template<>
+inline void platform_atomic_thread_fence(memory_order order)
+{
+	__atomic_thread_fence(gcc_memory_order(order));
+}
+
+template<typename T>
+class atomic_gcc {
+public:
+	explicit atomic_gcc(T v) : i(v) {}
+	atomic_gcc() {}
+	T load(memory_order order=memory_order_seq_cst) const volatile
+	{
+		return __atomic_load_n(&i, gcc_memory_order(order));
+	}
+	void store(T v, memory_order order=memory_order_seq_cst) volatile
+	{
+		__atomic_store_n(&i, v, gcc_memory_order(order));
+	}
+	bool compare_exchange_strong(
+		T &expected,
+		T desired,
+		memory_order success_order,
+		memory_order failure_order) volatile
+	{
+		return __atomic_compare_exchange_n(&i, &expected, desired, false,
+			gcc_memory_order(success_order), gcc_failure_order(failure_order));
+	}
+	bool compare_exchange_weak(
+		T &expected,
+		T desired,
+		memory_order success_order,
+		memory_order failure_order) volatile
+	{
+		return __atomic_compare_exchange_n(&i, &expected, desired, true,
+			gcc_memory_order(success_order), gcc_failure_order(failure_order));
+	}
+	T exchange(T r, memory_order order=memory_order_seq_cst) volatile
+	{
+		return __atomic_exchange_n(&i, r, gcc_memory_order(order));
+	}
+	T fetch_add(T c, memory_order order=memory_order_seq_cst) volatile
+	{
+		return __atomic_fetch_add(&i, c, gcc_memory_order(order));
+	}
+	T fetch_sub(T c, memory_order order=memory_order_seq_cst) volatile
+	{
+		return __atomic_fetch_sub(&i, c, gcc_memory_order(order));
+	}
+	T fetch_and(T c, memory_order order=memory_order_seq_cst) volatile
+	{
+		return __atomic_fetch_and(&i, c, gcc_memory_order(order));
+	}
+	T fetch_or(T c, memory_order order=memory_order_seq_cst) volatile
+	{
+		return __atomic_fetch_or(&i, c, gcc_memory_order(order));
+	}
+	T fetch_xor(T c, memory_order order=memory_order_seq_cst) volatile
+	{
+		return __atomic_fetch_xor(&i, c, gcc_memory_order(order));
+	}
+
+	bool is_lock_free(void) const volatile {return __atomic_always_lock_free(sizeof(T), 0);}
+protected:
+	typedef T integral_type;
+private:
+	T i;
+} __attribute__((aligned(sizeof(T))));
+
+/* sizes, for which the target does not provide a native compare-and-swap, use
+the spinlock-based fallback instead of calls into libatomic */
+
+#ifdef __GCC_HAVE_SYNC_COMPARE_AND_SWAP_1
+template<typename T>
+class platform_atomic_integral<T, 1> : public atomic_gcc<T> {
+public:
+	typedef atomic_gcc<T> super;
+	explicit platform_atomic_integral(T v) : super(v) {}
+	platform_atomic_integral(void) {}
+};
+#endif
+
+#ifdef __GCC_HAVE_SYNC_COMPARE_AND_SWAP_2
+template<typename T>
+class platform_atomic_integral<T, 2> : public atomic_gcc<T> {
+public:
+	typedef atomic_gcc<T> super;
+	explicit platform_atomic_integral(T v) : super(v) {}
+	platform_atomic_integral(void) {}
+};
+#endif
+
+#ifdef __GCC_HAVE_SYNC_COMPARE_AND_SWAP_4
+template<typename T>
+class platform_atomic_integral<T, 4> : public atomic_gcc<T> {
+public:
+	typedef atomic_gcc<T> super;
+	explicit platform_atomic_integral(T v) : super(v) {}
+	platform_atomic_integral(void) {}
+};
+#endif
+
+#ifdef __GCC_HAVE_SYNC_COMPARE_AND_SWAP_8
+template<typename T>
+class platform_atomic_integral<T, 8> : public atomic_gcc<T> {
+public:
+	typedef atomic_gcc<T> super;
+	explicit platform_atomic_integral(T v) : super(v) {}
+	platform_atomic_integral(void) {}
+};
+#endif
+
+#if defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_16) && defined(__SIZEOF_INT128__)
+/* arbitrary trivially copyable 16 byte types, e.g. pointers with a tag. The
+16 byte __atomic builtins are not inlined on all targets, so the __sync
+compare-and-swap is used, which is a full barrier for every memory order. A
+load is a compare-and-swap, which does not modify the value. */
+template<typename T>
+class platform_atomic<T, 16> {
+public:
+	platform_atomic() {}
+	explicit platform_atomic(T t) {memcpy(&i, &t, sizeof(T));}
+
+	void store(T t, memory_order order=memory_order_seq_cst) volatile
+	{
+		exchange(t, order);
+	}
+	T load(memory_order order=memory_order_seq_cst) volatile const
+	{
+		storage_type v=__sync_val_compare_and_swap(const_cast<volatile storage_type *>(&i), 0, 0);
+		return from_storage(v);
+	}
+	bool compare_exchange_strong(
+		T &expected,
+		T desired,
+		memory_order success_order,
+		memory_order failure_order) volatile
+	{
+		storage_type e, d;
+		memcpy(&e, &expected, sizeof(T));
+		memcpy(&d, &desired, sizeof(T));
+		storage_type prev=__sync_val_compare_and_swap(&i, e, d);
+		expected=from_storage(prev);
+		return prev==e;
+	}
+	bool compare_exchange_weak(
+		T &expected,
+		T desired,
+		memory_order success_order,
+		memory_order failure_order) volatile
+	{
+		return compare_exchange_strong(expected, desired, success_order, failure_order);
+	}
+	T exchange(T replacement, memory_order order=memory_order_seq_cst) volatile
+	{
+		T prev=load(memory_order_relaxed);
+		do {} while(!compare_exchange_strong(prev, replacement, order, memory_order_relaxed));
+		return prev;
+	}
+
+	operator T(void) const volatile {return load();}
+	T operator=(T v) volatile {store(v); return v;}
+
+	bool is_lock_free(void) const volatile {return true;}
+protected:
+	typedef T integral_type;
+private:
+	typedef unsigned __int128 storage_type;
+
+	static T from_storage(storage_type v)
+	{
+		T t;
+		memcpy(&t, &v, sizeof(T));
+		return t;
+	}
+
+	storage_type i;
+} __attribute__((aligned(16)));
+#endif
+
+}
+}
+}
+
+#endif
@@ -12,6 +12,8 @@
 
 #include <boost/cstdint.hpp>
 
+#include <string.h>
+
 #define __BOOST_AMD_64 defined(__amd64__) || defined(__x86_64__)
 
 namespace boost {
@@ -41,21 +43,25 @@ static inline void fence_after(memory_order order)
 	}
 }
 
+/* a locked read-modify-write of the top of the stack is a full barrier, which
+is considerably cheaper than mfence. the stack slot is in the cache of the
+executing core and it is not modified, so it is safe within the red zone */
 static inline void full_fence(void)
 {
 #if __BOOST_AMD_64
-			__asm__ __volatile__("mfence" ::: "memory");
+			__asm__ __volatile__("lock; orq $0, (%%rsp)" ::: "memory", "cc");
 #else
-			/* could use mfence iff i686, but it does not appear to matter much */
-			__asm__ __volatile__("lock; addl $0, (%%esp)"  ::: "memory");
+			__asm__ __volatile__("lock; orl $0, (%%esp)" ::: "memory", "cc");
 #endif
 }
 
+/* seq_cst stores are xchg instructions, which are full barriers, so a store
+can not be reordered with a subsequent seq_cst load. loads are plain movs,
+which already have acquire semantics on x86, for all memory orders */
 static inline void fence_after_load(memory_order order)
 {
 	switch(order) {
 		case memory_order_seq_cst:
-			full_fence();
 		case memory_order_acquire:
 		case memory_order_acq_rel:
 			__asm__ __volatile__ ("" ::: "memory");
@@ -121,12 +127,12 @@ public:
 	{
 		return compare_exchange_strong(expected, desired, success_order, failure_order);
 	}
-	T exchange(T r, memory_order order=memory_order_seq_cst) volatile
+	T exchange(T r, memory_order /*order*/=memory_order_seq_cst) volatile
 	{
 		__asm__ __volatile__("xchgb %0, %1\n" : "=q" (r) : "m"(i), "0" (r) : "memory");
 		return r;
 	}
-	T fetch_add(T c, memory_order order=memory_order_seq_cst) volatile
+	T fetch_add(T c, memory_order /*order*/=memory_order_seq_cst) volatile
 	{
 		__asm__ __volatile__("lock; xaddb %0, %1" : "+q" (c), "+m" (i) :: "memory");
 		return c;
@@ -190,12 +196,12 @@ public:
 	{
 		return compare_exchange_strong(expected, desired, success_order, failure_order);
 	}
-	T exchange(T r, memory_order order=memory_order_seq_cst) volatile
+	T exchange(T r, memory_order /*order*/=memory_order_seq_cst) volatile
 	{
 		__asm__ __volatile__("xchgw %0, %1\n" : "=r" (r) : "m"(i), "0" (r) : "memory");
 		return r;
 	}
-	T fetch_add(T c, memory_order order=memory_order_seq_cst) volatile
+	T fetch_add(T c, memory_order /*order*/=memory_order_seq_cst) volatile
 	{
 		__asm__ __volatile__("lock; xaddw %0, %1" : "+r" (c), "+m" (i) :: "memory");
 		return c;
@@ -259,12 +265,12 @@ public:
 	{
 		return compare_exchange_strong(expected, desired, success_order, failure_order);
 	}
-	T exchange(T r, memory_order order=memory_order_seq_cst) volatile
+	T exchange(T r, memory_order /*order*/=memory_order_seq_cst) volatile
 	{
 		__asm__ __volatile__("xchgl %0, %1\n" : "=r" (r) : "m"(i), "0" (r) : "memory");
 		return r;
 	}
-	T fetch_add(T c, memory_order order=memory_order_seq_cst) volatile
+	T fetch_add(T c, memory_order /*order*/=memory_order_seq_cst) volatile
 	{
 		__asm__ __volatile__("lock; xaddl %0, %1" : "+r" (c), "+m" (i) :: "memory");
 		return c;
@@ -329,12 +335,12 @@ public:
 	{
 		return compare_exchange_strong(expected, desired, success_order, failure_order);
 	}
-	T exchange(T r, memory_order order=memory_order_seq_cst) volatile
+	T exchange(T r, memory_order /*order*/=memory_order_seq_cst) volatile
 	{
 		__asm__ __volatile__("xchgq %0, %1\n" : "=r" (r) : "m"(i), "0" (r) : "memory");
 		return r;
 	}
-	T fetch_add(T c, memory_order order=memory_order_seq_cst) volatile
+	T fetch_add(T c, memory_order /*order*/=memory_order_seq_cst) volatile
 	{
 		__asm__ __volatile__("lock; xaddq %0, %1" : "+r" (c), "+m" (i) :: "memory");
 		return c;
@@ -460,76 +466,172 @@ public:
 };
 #endif
 
-#if __BOOST_AMD_64 && defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_16)
+#if defined(__amd64__) || defined(__x86_64__)
+/* 16 byte operations are built on cmpxchg16b, which is available on all x86_64
+processors except for the earliest AMD64 ones. It is issued via inline assembly,
+so -mcx16 is not required. As a locked instruction, it is a full barrier, so no
+additional fences are needed. */
+static inline bool cmpxchg16b(volatile void * ptr, boost::uint64_t * expected, const boost::uint64_t * desired)
+{
+	bool success;
+	__asm__ __volatile__(
+		"lock; cmpxchg16b %1\n"
+		"sete %0\n"
+		: "=q" (success), "+m" (*(volatile boost::uint64_t (*)[2])ptr), "+a" (expected[0]), "+d" (expected[1])
+		: "b" (desired[0]), "c" (desired[1])
+		: "memory", "cc");
+	return success;
+}
+
+/* there is no 16 byte load instruction, which is guaranteed to be atomic. a
+cmpxchg16b with equal expected and desired values either fails and returns the
+current value, or succeeds without modifying the memory */
+static inline void load16(const volatile void * ptr, boost::uint64_t * value)
+{
+	value[0] = value[1] = 0;
+	cmpxchg16b(const_cast<volatile void *>(ptr), value, value);
+}
+
 template<typename T>
 class atomic_x86_128 {
 public:
-    explicit atomic_x86_128(T v) : i(v) {}
-    atomic_x86_128() {}
-    T load(memory_order order=memory_order_seq_cst) const volatile
-    {
-        T v=*reinterpret_cast<volatile const T *>(&i);
-        fence_after_load(order);
-        return v;
-    }
-    void store(T v, memory_order order=memory_order_seq_cst) volatile
-    {
-        if (order!=memory_order_seq_cst) {
-            fence_before(order);
-            *reinterpret_cast<volatile T *>(&i)=v;
-        } else {
-            exchange(v);
-        }
-    }
-    bool compare_exchange_strong(
-        T &expected,
-        T desired,
-        memory_order success_order,
-        memory_order failure_order) volatile
-    {
-        T prev = __sync_val_compare_and_swap_16(&i, expected, desired);
-        bool success=(prev==expected);
-        if (success) fence_after(success_order);
-        else fence_after(failure_order);
-        expected=prev;
-        return success;
-    }
-    bool compare_exchange_weak(
-        T &expected,
-        T desired,
-        memory_order success_order,
-        memory_order failure_order) volatile
-    {
-        return compare_exchange_strong(expected, desired, success_order, failure_order);
-    }
-    T exchange(T r, memory_order order=memory_order_seq_cst) volatile
-    {
-        while (!__sync_bool_compare_and_swap_16(&i, i, r))
-        {};
-
-        return r;
-    }
-    T fetch_add(T c, memory_order order=memory_order_seq_cst) volatile
-    {
-        __sync_fetch_and_add(&i, c);
-        return c;
-    }
-
-    bool is_lock_free(void) const volatile {return true;}
+	explicit atomic_x86_128(T v) : i(v) {}
+	atomic_x86_128() {}
+	T load(memory_order /*order*/=memory_order_seq_cst) const volatile
+	{
+		boost::uint64_t v[2];
+		load16(&i, v);
+		return from_words(v);
+	}
+	void store(T v, memory_order order=memory_order_seq_cst) volatile
+	{
+		exchange(v, order);
+	}
+	bool compare_exchange_strong(
+		T &expected,
+		T desired,
+		memory_order /*success_order*/,
+		memory_order /*failure_order*/) volatile
+	{
+		boost::uint64_t e[2], d[2];
+		to_words(expected, e);
+		to_words(desired, d);
+		bool success=cmpxchg16b(&i, e, d);
+		expected=from_words(e);
+		return success;
+	}
+	bool compare_exchange_weak(
+		T &expected,
+		T desired,
+		memory_order success_order,
+		memory_order failure_order) volatile
+	{
+		return compare_exchange_strong(expected, desired, success_order, failure_order);
+	}
+	T exchange(T r, memory_order order=memory_order_seq_cst) volatile
+	{
+		T prev=load(memory_order_relaxed);
+		do {} while(!compare_exchange_strong(prev, r, order, memory_order_relaxed));
+		return prev;
+	}
+	T fetch_add(T c, memory_order order=memory_order_seq_cst) volatile
+	{
+		T expected=load(memory_order_relaxed), desired;
+		do {
+			desired=expected+c;
+		} while(!compare_exchange_strong(expected, desired, order, memory_order_relaxed));
+		return expected;
+	}
+
+	bool is_lock_free(void) const volatile {return true;}
 protected:
-    typedef T integral_type;
+	typedef T integral_type;
 private:
-    T i;
+	static void to_words(T const & t, boost::uint64_t * words)
+	{
+		memcpy(words, &t, sizeof(T));
+	}
+	static T from_words(const boost::uint64_t * words)
+	{
+		T t;
+		memcpy(static_cast<void*>(&t), words, sizeof(T));
+		return t;
+	}
+
+	T i;
 } __attribute__((aligned(16)));
 
 template<typename T>
 class platform_atomic_integral<T, 16> : public build_atomic_from_add<atomic_x86_128<T> >{
 public:
-    typedef build_atomic_from_add<atomic_x86_128<T> > super;
-    explicit platform_atomic_integral(T v) : super(v) {}
-    platform_atomic_integral(void) {}
+	typedef build_atomic_from_add<atomic_x86_128<T> > super;
+	explicit platform_atomic_integral(T v) : super(v) {}
+	platform_atomic_integral(void) {}
 };
 
+/* arbitrary trivially copyable 16 byte types, e.g. the tagged pointers of
+boost.lockfree, which are not compressed */
+template<typename T>
+class platform_atomic<T, 16> {
+public:
+	platform_atomic() {}
+	explicit platform_atomic(T t) {memcpy(i, &t, sizeof(T));}
+
+	void store(T t, memory_order order=memory_order_seq_cst) volatile
+	{
+		exchange(t, order);
+	}
+	T load(memory_order /*order*/=memory_order_seq_cst) volatile const
+	{
+		boost::uint64_t v[2];
+		load16(i, v);
+		return from_words(v);
+	}
+	bool compare_exchange_strong(
+		T &expected,
+		T desired,
+		memory_order /*success_order*/,
+		memory_order /*failure_order*/) volatile
+	{
+		boost::uint64_t e[2], d[2];
+		memcpy(e, &expected, sizeof(T));
+		memcpy(d, &desired, sizeof(T));
+		bool success=cmpxchg16b(i, e, d);
+		expected=from_words(e);
+		return success;
+	}
+	bool compare_exchange_weak(
+		T &expected,
+		T desired,
+		memory_order success_order,
+		memory_order failure_order) volatile
+	{
+		return compare_exchange_strong(expected, desired, success_order, failure_order);
+	}
+	T exchange(T replacement, memory_order order=memory_order_seq_cst) volatile
+	{
+		T prev=load(memory_order_relaxed);
+		do {} while(!compare_exchange_strong(prev, replacement, order, memory_order_relaxed));
+		return prev;
+	}
+
+	operator T(void) const volatile {return load();}
+	T operator=(T v) volatile {store(v); return v;}
+
+	bool is_lock_free(void) const volatile {return true;}
+protected:
+	typedef T integral_type;
+private:
+	static T from_words(const boost::uint64_t * words)
+	{
+		T t;
+		memcpy(static_cast<void*>(&t), words, sizeof(T));
+		return t;
+	}
+
+	boost::uint64_t i[2];
+} __attribute__((aligned(16)));
+
 #endif
 
 }
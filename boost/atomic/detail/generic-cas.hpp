@@ -123,15 +123,15 @@ public:
 		do { } while(!const_cast<this_type *>(this)->compare_exchange_weak(expected, expected, order, memory_order_relaxed));
 		return expected;
 	}
-	void store(T v, memory_order order=memory_order_seq_cst) volatile
+	void store(T v, memory_order /*order*/=memory_order_seq_cst) volatile
 	{
 		exchange(v);
 	}
 	bool compare_exchange_strong(
 		T &expected,
 		T desired,
-		memory_order success_order,
-		memory_order failure_order) volatile
+		memory_order /*success_order*/,
+		memory_order /*failure_order*/) volatile
 	{
 		T found;
 		found=(T)fenced_compare_exchange_strong_32(&i, (int32_t)expected, (int32_t)desired);
@@ -0,0 +1,134 @@
+#ifndef BOOST_DETAIL_ATOMIC_SEQLOCK_HPP
+#define BOOST_DETAIL_ATOMIC_SEQLOCK_HPP
+
+//  Copyright (c) 2026 Tim Blechmann
+//
+//  Distributed under the Boost Software License, Version 1.0.
+//  See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <string.h>
+
+#include <boost/memory_order.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/smart_ptr/detail/yield_k.hpp>
+
+namespace boost {
+
+/* specialize atomic_use_seqlock<T> as true_type for a trivially copyable type
+T, to implement atomic<T> as a seqlock instead of the spinlock pool, if the
+platform has no lock-free implementation for the size of T. readers of a
+seqlock never write to shared memory, so they do not contend with each other,
+but they retry while a store is in progress. this suits large types, which are
+read much more often than they are modified. */
+template<typename T>
+struct atomic_use_seqlock : public false_type {};
+
+namespace detail {
+namespace atomic {
+
+template<typename T>
+static inline void platform_atomic_thread_fence(T order);
+
+/* the sequence counter is odd, while a writer modifies the value. a reader
+copies the value and retries, if the counter was odd or has changed in the
+meantime. writers exclude each other by incrementing the counter from an even
+value with a compare_exchange. Counter is an atomic integral type. */
+template<typename T, typename Counter>
+class seqlock_atomic {
+public:
+	seqlock_atomic(void) : seq(0) {}
+	explicit seqlock_atomic(const T &t) : seq(0) {memcpy(&i, &t, sizeof(T));}
+
+	void store(const T &t, memory_order order=memory_order_seq_cst) volatile
+	{
+		unsigned int s=lock();
+		memcpy((void*)&i, &t, sizeof(T));
+		unlock(s, order);
+	}
+	T load(memory_order order=memory_order_seq_cst) volatile const
+	{
+		const memory_order load_order=(order==memory_order_seq_cst) ? memory_order_seq_cst : memory_order_acquire;
+		T tmp;
+		for (unsigned int k=0;; ++k) {
+			unsigned int s=seq.load(load_order);
+			if (s & 1) {
+				boost::detail::yield(k);
+				continue;
+			}
+			memcpy(&tmp, (const T*)&i, sizeof(T));
+			platform_atomic_thread_fence<memory_order>(memory_order_acquire);
+			if (seq.load(memory_order_relaxed)==s)
+				return tmp;
+		}
+	}
+	bool compare_exchange_strong(
+		T &expected,
+		T desired,
+		memory_order success_order,
+		memory_order /*failure_order*/) volatile
+	{
+		unsigned int s=lock();
+		if (memcmp((void*)&i, &expected, sizeof(T))==0) {
+			memcpy((void*)&i, &desired, sizeof(T));
+			unlock(s, success_order);
+			return true;
+		} else {
+			memcpy(&expected, (void*)&i, sizeof(T));
+			/* the value is unchanged, so the counter is restored */
+			unlock(s-2, memory_order_release);
+			return false;
+		}
+	}
+	bool compare_exchange_weak(
+		T &expected,
+		T desired,
+		memory_order success_order,
+		memory_order failure_order) volatile
+	{
+		return compare_exchange_strong(expected, desired, success_order, failure_order);
+	}
+	T exchange(T replacement, memory_order order=memory_order_seq_cst) volatile
+	{
+		unsigned int s=lock();
+		T tmp;
+		memcpy(&tmp, (void*)&i, sizeof(T));
+		memcpy((void*)&i, &replacement, sizeof(T));
+		unlock(s, order);
+		return tmp;
+	}
+	bool is_lock_free(void) const volatile {return false;}
+protected:
+	typedef T integral_type;
+private:
+	/* returns the even value, to which the counter has to be set by unlock */
+	unsigned int lock(void) volatile
+	{
+		unsigned int s=seq.load(memory_order_relaxed);
+		for (unsigned int k=0;; ++k) {
+			if (s & 1) {
+				boost::detail::yield(k);
+				s=seq.load(memory_order_relaxed);
+				continue;
+			}
+			if (seq.compare_exchange_weak(s, s+1, memory_order_acquire, memory_order_relaxed))
+				break;
+		}
+		/* the modification of the value must not become visible before the odd counter */
+		platform_atomic_thread_fence<memory_order>(memory_order_release);
+		return s+2;
+	}
+	void unlock(unsigned int s, memory_order order) volatile
+	{
+		seq.store(s, (order==memory_order_seq_cst) ? memory_order_seq_cst : memory_order_release);
+	}
+
+	Counter seq;
+	T i;
+};
+
+}
+}
+}
+
+#endif
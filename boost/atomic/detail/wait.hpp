@@ -0,0 +1,150 @@
+#ifndef BOOST_DETAIL_ATOMIC_WAIT_HPP
+#define BOOST_DETAIL_ATOMIC_WAIT_HPP
+
+//  Copyright (c) 2026 Tim Blechmann
+//
+//  Distributed under the Boost Software License, Version 1.0.
+//  See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cstddef>
+#include <limits.h>
+
+#include <boost/memory_order.hpp>
+#include <boost/smart_ptr/detail/yield_k.hpp>
+
+#if defined(__linux__) && !defined(BOOST_ATOMIC_NO_FUTEX)
+#define BOOST_ATOMIC_HAS_FUTEX
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/* blocking wait for a change of the value of an atomic object.
+
+Waiters are registered in a bucket of a pool, which is selected by the address
+of the atomic object, so notify only enters the kernel if a thread waits on an
+object of the same bucket.
+
+On Linux, the waiters of 4 byte objects sleep on a futex on the object itself.
+Other objects share the futex of their bucket, which is advanced by every
+notify, and all of its waiters are woken, as they may wait on different
+objects. Without futex, waiters poll the value with an increasing backoff. */
+
+namespace boost {
+namespace detail {
+namespace atomic {
+
+template<typename T>
+static inline void platform_atomic_thread_fence(T order);
+
+#ifdef BOOST_ATOMIC_HAS_FUTEX
+static inline void futex_wait(const volatile void * address, unsigned int expected, unsigned int /*k*/)
+{
+	syscall(SYS_futex, const_cast<void *>(address), FUTEX_WAIT_PRIVATE, expected, NULL, NULL, 0);
+}
+
+static inline void futex_wake(const volatile void * address, int count)
+{
+	syscall(SYS_futex, const_cast<void *>(address), FUTEX_WAKE_PRIVATE, count, NULL, NULL, 0);
+}
+#else
+static inline void futex_wait(const volatile void * /*address*/, unsigned int /*expected*/, unsigned int k)
+{
+	boost::detail::yield(k);
+}
+
+static inline void futex_wake(const volatile void * /*address*/, int /*count*/)
+{}
+#endif
+
+#if defined(__GNUC__)
+#define BOOST_ATOMIC_WAITER_ALIGNMENT __attribute__((aligned(64)))
+#elif defined(_MSC_VER)
+#define BOOST_ATOMIC_WAITER_ALIGNMENT __declspec(align(64))
+#else
+#define BOOST_ATOMIC_WAITER_ALIGNMENT
+#endif
+
+/* Counter is an atomic unsigned int, each bucket occupies a cache line of its
+own, so the buckets of the pool are aligned at cache line boundaries */
+template<typename Counter>
+struct BOOST_ATOMIC_WAITER_ALIGNMENT waiter_bucket {
+	Counter waiters;
+	Counter sequence;
+	char padding[64 - 2 * sizeof(Counter)];
+};
+
+#undef BOOST_ATOMIC_WAITER_ALIGNMENT
+
+template<typename Counter, int M=0>
+class waiter_pool {
+public:
+	static waiter_bucket<Counter> & bucket_for(const volatile void * address)
+	{
+		std::size_t i = reinterpret_cast<std::size_t>(address);
+		return pool_[(i ^ (i >> 7)) % 41];
+	}
+
+	template<typename Atomic, typename T>
+	static void wait(const volatile Atomic & a, T old, memory_order order)
+	{
+		waiter_bucket<Counter> & bucket = bucket_for(&a);
+		for (unsigned int k=0; a.load(order)==old; ++k) {
+			bucket.waiters.fetch_add(1, memory_order_seq_cst);
+			if (uses_object_futex<Atomic, T>()) {
+				/* the kernel only blocks, if the object still contains the old value */
+				if (a.load(memory_order_seq_cst)==old)
+					futex_wait(&a, to_futex_word(old), k);
+			} else {
+				const unsigned int sequence = bucket.sequence.load(memory_order_seq_cst);
+				if (a.load(memory_order_seq_cst)==old)
+					futex_wait(&bucket.sequence, sequence, k);
+			}
+			bucket.waiters.fetch_sub(1, memory_order_relaxed);
+		}
+	}
+
+	template<typename Atomic>
+	static void notify(const volatile Atomic & a, bool all)
+	{
+		waiter_bucket<Counter> & bucket = bucket_for(&a);
+		/* orders the modification of the object before the load of the waiter
+		count, a waiter either observes the modification or is counted */
+		platform_atomic_thread_fence<memory_order>(memory_order_seq_cst);
+		if (bucket.waiters.load(memory_order_relaxed)==0)
+			return;
+
+		if (uses_object_futex<Atomic, typename Atomic::integral_type>())
+			futex_wake(&a, all ? INT_MAX : 1);
+		else {
+			bucket.sequence.fetch_add(1, memory_order_seq_cst);
+			futex_wake(&bucket.sequence, INT_MAX);
+		}
+	}
+
+private:
+	/* the futex word has to be the value of the object */
+	template<typename Atomic, typename T>
+	static bool uses_object_futex(void)
+	{
+		return sizeof(Atomic)==4 && sizeof(T)==4;
+	}
+
+	template<typename T>
+	static unsigned int to_futex_word(T value)
+	{
+		return (unsigned int)value;
+	}
+
+	static waiter_bucket<Counter> pool_[41];
+};
+
+template<typename Counter, int M>
+waiter_bucket<Counter> waiter_pool<Counter, M>::pool_[41];
+
+}
+}
+}
+
+#endif
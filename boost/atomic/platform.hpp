@@ -6,8 +6,26 @@
 
 #include <boost/config.hpp>
 
-#if (defined(__GNUC__) || defined(__INTEL_COMPILER)) && (defined(__i386__) || defined(__amd64__) || defined(__x86_64__) \
-		|| !defined(__GXX_EXPERIMENTAL_CXX0X__) || !defined(__GXX_EXPERIMENTAL_CXX11__))
+// Define BOOST_ATOMIC_USE_FALLBACK or BOOST_ATOMIC_USE_GENERIC_CAS to select
+// the spinlock pool or the compare-and-swap based implementation on any
+// platform, e.g. to compare them with the native implementation.
+#if defined(BOOST_ATOMIC_USE_FALLBACK)
+
+	#include <boost/atomic/detail/base.hpp>
+
+#elif defined(BOOST_ATOMIC_USE_GENERIC_CAS)
+
+	#include <boost/atomic/detail/generic-cas.hpp>
+
+// The __atomic builtins are used on all targets except for x86, which has a
+// hand-written implementation. Define BOOST_ATOMIC_USE_GCC_ATOMIC to use them
+// on x86 as well.
+#elif defined(BOOST_ATOMIC_USE_GCC_ATOMIC) || (defined(__GNUC__) && defined(__ATOMIC_RELAXED) \
+		&& !defined(__i386__) && !defined(__amd64__) && !defined(__x86_64__))
+
+	#include <boost/atomic/detail/gcc-atomic.hpp>
+
+#elif (defined(__GNUC__) || defined(__INTEL_COMPILER)) && (defined(__i386__) || defined(__amd64__) || defined(__x86_64__))
 
 	#include <boost/atomic/detail/gcc-x86.hpp>
 
@@ -0,0 +1,382 @@
+//  coroutine awaitables for lock-free queues
+//
+//  Copyright (C) 2026 Tim Blechmann
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  Disclaimer: Not a Boost library.
+
+#ifndef BOOST_LOCKFREE_AWAITABLE_QUEUE_HPP_INCLUDED
+#define BOOST_LOCKFREE_AWAITABLE_QUEUE_HPP_INCLUDED
+
+#if !defined(__cpp_impl_coroutine) || (__cpp_impl_coroutine < 201902L)
+#error "boost/lockfree/awaitable_queue.hpp requires c++20 coroutines"
+#endif
+
+#include <coroutine>
+#include <cstddef>              /* for std::size_t */
+
+#include <boost/noncopyable.hpp>
+
+#include <boost/lockfree/detail/atomic.hpp>
+#include <boost/lockfree/detail/prefix.hpp>
+#include <boost/lockfree/fifo.hpp>
+#include <boost/lockfree/stack.hpp>
+
+namespace boost {
+namespace lockfree {
+namespace detail {
+
+template <typename Queue, typename T>
+bool try_enqueue(Queue & queue, T const & t)
+{
+    return queue.enqueue(t);
+}
+
+template <typename T, typename freelist_t, typename Alloc>
+bool try_enqueue(stack<T, freelist_t, Alloc> & queue, T const & t)
+{
+    return queue.push(t);
+}
+
+template <typename Queue, typename T>
+bool try_dequeue(Queue & queue, T & ret)
+{
+    return queue.dequeue(ret);
+}
+
+template <typename T, typename freelist_t, typename Alloc>
+bool try_dequeue(stack<T, freelist_t, Alloc> & queue, T & ret)
+{
+    return queue.pop(ret);
+}
+
+template <typename T>
+struct awaitable_waiter
+{
+    awaitable_waiter * next;
+    std::coroutine_handle<> handle;
+    T value;
+};
+
+/* intrusive fifo of waiters, only accessed by the thread, which is servicing the waiters */
+template <typename T>
+struct waiter_backlog
+{
+    typedef awaitable_waiter<T> waiter;
+
+    waiter_backlog(void):
+        head(NULL), tail(NULL)
+    {}
+
+    /* appends a list, which is in reverse order of registration */
+    void append_reversed(waiter * list)
+    {
+        waiter * reversed = NULL;
+        waiter * last = list;
+        while (list) {
+            waiter * next = list->next;
+            list->next = reversed;
+            reversed = list;
+            list = next;
+        }
+
+        if (!reversed)
+            return;
+
+        if (tail)
+            tail->next = reversed;
+        else
+            head = reversed;
+        tail = last;
+    }
+
+    waiter * pop_front(void)
+    {
+        waiter * ret = head;
+        head = head->next;
+        if (!head)
+            tail = NULL;
+        return ret;
+    }
+
+    waiter * head;
+    waiter * tail;
+};
+
+} /* namespace detail */
+
+/** The awaitable_queue class provides c++20 awaitables for boost::lockfree::fifo, boost::lockfree::stack and
+ *  boost::lockfree::ringbuffer.
+ *
+ *  co_await pop() suspends the calling coroutine while the queue is empty, co_await push(v) suspends while the queue
+ *  is full (i.e. the freelist of a fifo/stack or the ringbuffer is exhausted). If the operation can be performed
+ *  immediately, the coroutine is not suspended and no memory is allocated. The waiter is stored in the coroutine
+ *  frame and registered in a lock-free list.
+ *
+ *  Suspended coroutines are resumed by the coroutine or thread, which changes the state of the queue: the element is
+ *  transferred to or from the waiter and the waiter is resumed inline. No thread is ever blocked. Waiters are served
+ *  in the order of their registration, however a concurrent push/pop, which does not need to suspend, may overtake
+ *  them.
+ *
+ *  \b Limitation: With a boost::lockfree::ringbuffer, only a single producer and a single consumer coroutine are
+ *  allowed, which may however be resumed on different threads.
+ *
+ *  \warning The awaitable_queue must not be destroyed while coroutines are suspended on it.
+ * */
+template <typename Queue>
+class awaitable_queue:
+    boost::noncopyable
+{
+public:
+    typedef typename Queue::value_type value_type;
+
+private:
+#ifndef BOOST_DOXYGEN_INVOKED
+    typedef detail::awaitable_waiter<value_type> waiter;
+    typedef detail::waiter_backlog<value_type> backlog;
+
+    static void register_waiter(atomic<waiter*> & list, waiter * w)
+    {
+        waiter * head = list.load(memory_order_relaxed);
+        do {
+            w->next = head;
+        } while (!list.compare_exchange_weak(head, w));
+    }
+
+    /* the thread, which increments service_requests_ from 0 services all pending waiters and keeps servicing, until
+     * all concurrent requests have been handled. this serializes access to the backlogs, without blocking any
+     * thread */
+    waiter * request_service(void)
+    {
+        if (service_requests_.fetch_add(1) != 0)
+            return NULL;
+
+        waiter * ready = NULL;
+        long pending = 1;
+        for (;;) {
+            service(ready);
+
+            long remaining = service_requests_.fetch_sub(pending) - pending;
+            if (remaining == 0)
+                return ready;
+            pending = remaining;
+        }
+    }
+
+    void service(waiter *& ready)
+    {
+        consumer_backlog_.append_reversed(consumers_.exchange(NULL));
+        producer_backlog_.append_reversed(producers_.exchange(NULL));
+
+        for (bool progress = true; progress;) {
+            progress = false;
+
+            while (consumer_backlog_.head && detail::try_dequeue(queue_, consumer_backlog_.head->value)) {
+                waiter * w = consumer_backlog_.pop_front();
+                w->next = ready;
+                ready = w;
+                consumer_count_.fetch_sub(1, memory_order_relaxed);
+                progress = true;
+            }
+
+            while (producer_backlog_.head && detail::try_enqueue(queue_, producer_backlog_.head->value)) {
+                waiter * w = producer_backlog_.pop_front();
+                w->next = ready;
+                ready = w;
+                producer_count_.fetch_sub(1, memory_order_relaxed);
+                progress = true;
+            }
+        }
+    }
+
+    /* resumes all ready waiters, but self. returns true, if self has been ready */
+    static bool resume(waiter * ready, waiter * self)
+    {
+        bool self_ready = false;
+        while (ready) {
+            waiter * next = ready->next;
+            if (ready == self)
+                self_ready = true;
+            else
+                ready->handle.resume();
+            ready = next;
+        }
+        return self_ready;
+    }
+
+    void notify(atomic<long> const & waiter_count)
+    {
+        /* pairs with the registration of a waiter: either we see the waiter or the service sees our change */
+        atomic_thread_fence(memory_order_seq_cst);
+        if (waiter_count.load(memory_order_relaxed) != 0)
+            resume(request_service(), NULL);
+    }
+
+    bool suspend(atomic<waiter*> & list, atomic<long> & waiter_count, waiter * self)
+    {
+        waiter_count.fetch_add(1);
+        register_waiter(list, self);
+
+        /* self must not be dereferenced from here on, it may be resumed by another thread */
+        return !resume(request_service(), self);
+    }
+#endif
+
+public:
+    /** Awaitable, returned by awaitable_queue::pop()
+     * */
+    class pop_awaiter:
+        waiter
+    {
+    public:
+        explicit pop_awaiter(awaitable_queue & queue):
+            queue_(queue)
+        {}
+
+        bool await_ready(void)
+        {
+            return queue_.try_pop(waiter::value);
+        }
+
+        bool await_suspend(std::coroutine_handle<> handle)
+        {
+            waiter::handle = handle;
+            awaitable_queue & queue = queue_;
+            return queue.suspend(queue.consumers_, queue.consumer_count_, this);
+        }
+
+        value_type await_resume(void)
+        {
+            return waiter::value;
+        }
+
+    private:
+        awaitable_queue & queue_;
+    };
+
+    /** Awaitable, returned by awaitable_queue::push()
+     * */
+    class push_awaiter:
+        waiter
+    {
+    public:
+        push_awaiter(awaitable_queue & queue, value_type const & t):
+            queue_(queue)
+        {
+            waiter::value = t;
+        }
+
+        bool await_ready(void)
+        {
+            return queue_.try_push(waiter::value);
+        }
+
+        bool await_suspend(std::coroutine_handle<> handle)
+        {
+            waiter::handle = handle;
+            awaitable_queue & queue = queue_;
+            return queue.suspend(queue.producers_, queue.producer_count_, this);
+        }
+
+        void await_resume(void)
+        {}
+
+    private:
+        awaitable_queue & queue_;
+    };
+
+    //! Construct awaitable_queue.
+    awaitable_queue(void):
+        consumers_(NULL), consumer_count_(0), producers_(NULL), producer_count_(0), service_requests_(0)
+    {}
+
+    //! Construct awaitable_queue, passing arg to the constructor of the underlying queue
+    template <typename Argument>
+    explicit awaitable_queue(Argument const & arg):
+        queue_(arg), consumers_(NULL), consumer_count_(0), producers_(NULL), producer_count_(0),
+        service_requests_(0)
+    {}
+
+    //! \copydoc boost::lockfree::stack::is_lock_free
+    bool is_lock_free(void) const
+    {
+        return queue_.is_lock_free() && consumers_.is_lock_free() && service_requests_.is_lock_free();
+    }
+
+    /** Check if the underlying queue is empty
+     *
+     * \warning Not thread-safe, use for debugging purposes only
+     * */
+    bool empty(void)
+    {
+        return queue_.empty();
+    }
+
+    /** \returns awaitable, which pops an object from the queue and suspends the awaiting coroutine while the queue is
+     *           empty. The result of the co_await expression is the popped object.
+     * */
+    pop_awaiter pop(void)
+    {
+        return pop_awaiter(*this);
+    }
+
+    /** \returns awaitable, which pushes t to the queue and suspends the awaiting coroutine while the queue is full.
+     * */
+    push_awaiter push(value_type const & t)
+    {
+        return push_awaiter(*this, t);
+    }
+
+    /** Pushes t to the queue without suspending. Waiting consumers are resumed inline.
+     *
+     * \returns true, if the push operation is successful.
+     * */
+    bool try_push(value_type const & t)
+    {
+        if (!detail::try_enqueue(queue_, t))
+            return false;
+
+        notify(consumer_count_);
+        return true;
+    }
+
+    /** Pops object from the queue without suspending. Waiting producers are resumed inline.
+     *
+     * \returns true, if the pop operation is successful, false if the queue was empty.
+     * */
+    bool try_pop(value_type & ret)
+    {
+        if (!detail::try_dequeue(queue_, ret))
+            return false;
+
+        notify(producer_count_);
+        return true;
+    }
+
+private:
+#ifndef BOOST_DOXYGEN_INVOKED
+    Queue queue_;
+
+    static const int padding_size = BOOST_LOCKFREE_CACHELINE_BYTES - sizeof(atomic<waiter*>) - sizeof(atomic<long>);
+
+    char padding1[BOOST_LOCKFREE_CACHELINE_BYTES];
+    atomic<waiter*> consumers_;
+    atomic<long> consumer_count_;
+    char padding2[padding_size];
+    atomic<waiter*> producers_;
+    atomic<long> producer_count_;
+    char padding3[padding_size];
+    atomic<long> service_requests_;
+
+    backlog consumer_backlog_;
+    backlog producer_backlog_;
+#endif
+};
+
+} /* namespace lockfree */
+} /* namespace boost */
+
+#endif /* BOOST_LOCKFREE_AWAITABLE_QUEUE_HPP_INCLUDED */
@@ -0,0 +1,270 @@
+//  lock-free single-producer/multi-consumer broadcast ringbuffer
+//
+//  Copyright (C) 2026 Tim Blechmann
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  Disclaimer: Not a Boost library.
+
+#ifndef BOOST_LOCKFREE_BROADCAST_RINGBUFFER_HPP_INCLUDED
+#define BOOST_LOCKFREE_BROADCAST_RINGBUFFER_HPP_INCLUDED
+
+#include <boost/assert.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <boost/lockfree/detail/atomic.hpp>
+#include <boost/lockfree/detail/cursor.hpp>
+#include <boost/lockfree/detail/freelist.hpp>
+#include <boost/lockfree/detail/prefix.hpp>
+
+#include <algorithm>
+#include <cstddef>              /* for std::size_t */
+#include <memory>               /* for std::allocator */
+#include <new>
+
+namespace boost {
+namespace lockfree {
+
+/** The broadcast_ringbuffer class provides a single-writer/multi-reader queue, where every consumer receives every
+ *  element. Pushing and popping is wait-free.
+ *
+ *  The number of consumers is fixed at construction, each consumer is identified by an index in [0, consumers()[ and
+ *  owns a read cursor on a cache line of its own. Each element is written once and read in place by all consumers. The
+ *  producer can only reuse a slot, after the slowest consumer has read it.
+ *
+ *  \b Requirements: T must be copy-constructible
+ * */
+template <typename T, typename Alloc = std::allocator<T> >
+class broadcast_ringbuffer:
+    boost::noncopyable
+{
+#ifndef BOOST_DOXYGEN_INVOKED
+    typedef std::size_t size_t;
+
+    typedef typename detail::rebind_allocator<Alloc, T>::type slot_allocator;
+
+    size_t slowest_cursor(void) const
+    {
+        size_t ret = cursors_[0].load(memory_order_acquire);
+        for (size_t i = 1; i != consumers_; ++i)
+            ret = (std::min)(ret, cursors_[i].load(memory_order_acquire));
+        return ret;
+    }
+
+    /* returns the number of slots, which can be written, without scanning the cursors if possible */
+    size_t write_available(size_t write_position)
+    {
+        if (write_position - gate_ < max_size_)
+            return max_size_ - (write_position - gate_);
+
+        gate_ = slowest_cursor();
+        return max_size_ - (write_position - gate_);
+    }
+
+    T * slot(size_t position) const
+    {
+        return slots_ + position % max_size_;
+    }
+#endif
+
+public:
+    typedef T value_type;
+
+    /** Constructs a broadcast_ringbuffer for max_size elements and the given number of consumers
+     *
+     * \pre consumers must be at least 1
+     * */
+    broadcast_ringbuffer(size_t max_size, size_t consumers):
+        max_size_(max_size), consumers_(consumers), slots_(alloc_.allocate(max_size)), cursors_(consumers, alloc_),
+        write_position_(0), gate_(0)
+    {
+        BOOST_ASSERT(consumers > 0);
+    }
+
+    //! Constructs a broadcast_ringbuffer for max_size elements and the given number of consumers, allocating its
+    //! storage from alloc
+    broadcast_ringbuffer(size_t max_size, size_t consumers, Alloc const & alloc):
+        alloc_(alloc), max_size_(max_size), consumers_(consumers), slots_(alloc_.allocate(max_size)),
+        cursors_(consumers, alloc_), write_position_(0), gate_(0)
+    {
+        BOOST_ASSERT(consumers > 0);
+    }
+
+    //! Destroys the broadcast_ringbuffer and all remaining objects
+    ~broadcast_ringbuffer(void)
+    {
+        const size_t write_position = write_position_.load(memory_order_relaxed);
+        const size_t first = write_position > max_size_ ? write_position - max_size_ : 0;
+        for (size_t position = first; position != write_position; ++position)
+            slot(position)->~T();
+
+        alloc_.deallocate(slots_, max_size_);
+    }
+
+    //! \returns number of consumers
+    size_t consumers(void) const
+    {
+        return consumers_;
+    }
+
+    /** Enqueues object t to the ringbuffer. Enqueueing may fail, if the slowest consumer has not read the oldest
+     *  element.
+     *
+     * \return true, if the enqueue operation is successful.
+     *
+     * \note Only to be called from the producer thread. Wait-free
+     * */
+    bool enqueue(T const & t)
+    {
+        const size_t write_position = write_position_.load(memory_order_relaxed); // only written from enqueue thread
+        if (write_available(write_position) == 0)
+            return false;
+
+        T * p = slot(write_position);
+        if (write_position >= max_size_)
+            p->~T();            /* all consumers have read the previous element */
+        new (p) T(t);
+
+        write_position_.store(write_position + 1, memory_order_release);
+        return true;
+    }
+
+    /** Enqueues size objects from the array t to the ringbuffer.
+     *
+     *  Will enqueue as many objects as there is space available
+     *
+     * \Returns number of enqueued items
+     *
+     * \note Only to be called from the producer thread. Wait-free
+     */
+    size_t enqueue(T const * t, size_t size)
+    {
+        const size_t write_position = write_position_.load(memory_order_relaxed); // only written from enqueue thread
+        const size_t count = (std::min)(size, write_available(write_position));
+
+        for (size_t i = 0; i != count; ++i) {
+            T * p = slot(write_position + i);
+            if (write_position + i >= max_size_)
+                p->~T();
+            new (p) T(t[i]);
+        }
+
+        write_position_.store(write_position + count, memory_order_release);
+        return count;
+    }
+
+    /** Dequeue object from ringbuffer for the given consumer.
+     *
+     * If dequeue operation is successful, object is copied to memory location denoted by ret.
+     *
+     * \return true, if the dequeue operation is successful, false if no element is available for this consumer.
+     *
+     * \note Only to be called from the thread of this consumer. Wait-free
+     */
+    bool dequeue(size_t consumer, T & ret)
+    {
+        atomic<size_t> & read_position = cursors_[consumer];
+        const size_t position = read_position.load(memory_order_relaxed); // only written from this consumer
+        if (position == write_position_.load(memory_order_acquire))
+            return false;
+
+        ret = *slot(position);
+        read_position.store(position + 1, memory_order_release);
+        return true;
+    }
+
+    /** Dequeue a maximum of size objects from ringbuffer for the given consumer.
+     *
+     * \return number of dequeued items
+     *
+     * \note Only to be called from the thread of this consumer. Wait-free
+     * */
+    size_t dequeue(size_t consumer, T * ret, size_t size)
+    {
+        atomic<size_t> & read_position = cursors_[consumer];
+        const size_t position = read_position.load(memory_order_relaxed); // only written from this consumer
+        const size_t count = (std::min)(size, write_position_.load(memory_order_acquire) - position);
+
+        for (size_t i = 0; i != count; ++i)
+            ret[i] = *slot(position + i);
+
+        read_position.store(position + count, memory_order_release);
+        return count;
+    }
+
+    /** Applies f to all elements, which are available for the given consumer, without copying them. The slots are
+     *  released for the producer, after f has been applied to all elements.
+     *
+     * \return number of consumed elements
+     *
+     * \note Only to be called from the thread of this consumer. Wait-free, if f is wait-free
+     * */
+    template <typename Functor>
+    size_t consume_all(size_t consumer, Functor & f)
+    {
+        return consume_all_impl<Functor&>(consumer, f);
+    }
+
+    //! \copydoc boost::lockfree::broadcast_ringbuffer::consume_all(size_t, Functor &)
+    template <typename Functor>
+    size_t consume_all(size_t consumer, Functor const & f)
+    {
+        return consume_all_impl<Functor const &>(consumer, f);
+    }
+
+private:
+#ifndef BOOST_DOXYGEN_INVOKED
+    template <typename Functor>
+    size_t consume_all_impl(size_t consumer, Functor f)
+    {
+        atomic<size_t> & read_position = cursors_[consumer];
+        const size_t position = read_position.load(memory_order_relaxed); // only written from this consumer
+        const size_t count = write_position_.load(memory_order_acquire) - position;
+
+        for (size_t i = 0; i != count; ++i) {
+            T const & element = *slot(position + i);
+            f(element);
+        }
+
+        read_position.store(position + count, memory_order_release);
+        return count;
+    }
+#endif
+
+public:
+    /** Check if no element is available for the given consumer
+     *
+     * \warning Not thread-safe, use for debugging purposes only
+     * */
+    bool empty(size_t consumer)
+    {
+        return cursors_[consumer].load(memory_order_relaxed) == write_position_.load(memory_order_relaxed);
+    }
+
+    //! \copydoc boost::lockfree::stack::is_lock_free
+    bool is_lock_free(void) const
+    {
+        return write_position_.is_lock_free();
+    }
+
+private:
+#ifndef BOOST_DOXYGEN_INVOKED
+    slot_allocator alloc_;
+    const size_t max_size_;
+    const size_t consumers_;
+    T * const slots_;
+    detail::cursor_array<slot_allocator> cursors_;
+
+    char padding1[BOOST_LOCKFREE_CACHELINE_BYTES]; /* force write_position_ to a different cache line */
+    atomic<size_t> write_position_;
+    size_t gate_;       /* cached position of the slowest consumer, only accessed by the producer */
+    char padding2[BOOST_LOCKFREE_CACHELINE_BYTES - sizeof(atomic<size_t>) - sizeof(size_t)];
+#endif
+};
+
+} /* namespace lockfree */
+} /* namespace boost */
+
+#endif /* BOOST_LOCKFREE_BROADCAST_RINGBUFFER_HPP_INCLUDED */
@@ -1,6 +1,8 @@
 #ifndef BOOST_LOCKFREE_DETAIL_ATOMIC_HPP
 #define BOOST_LOCKFREE_DETAIL_ATOMIC_HPP
 
+#include <boost/lockfree/detail/prefix.hpp>
+
 #ifdef __GNUC__
 # if __GNUC__ < 4 || (__GNUC__ == 4 && __GNUC_MINOR__ < 6) || !defined(__GXX_EXPERIMENTAL_CXX0X__)
 #  define BOOST_NO_0X_HDR_ATOMIC
@@ -9,7 +11,14 @@
 # define BOOST_NO_0X_HDR_ATOMIC
 #endif
 
-#ifdef BOOST_NO_0X_HDR_ATOMIC
+/* without pointer compression, a tagged_ptr of a 64 bit target has 16 bytes. std::atomic calls the 16 byte functions
+ * of libatomic for it, boost::atomic inlines the 16 byte compare-and-swap of the target */
+#if defined(BOOST_NO_0X_HDR_ATOMIC) || (!defined(BOOST_LOCKFREE_PTR_COMPRESSION) && \
+                                        (defined(_WIN64) || (defined(__SIZEOF_POINTER__) && __SIZEOF_POINTER__ == 8)))
+# define BOOST_LOCKFREE_USE_BOOST_ATOMIC
+#endif
+
+#ifdef BOOST_LOCKFREE_USE_BOOST_ATOMIC
 #include <boost/atomic.hpp>
 #else
 #include <atomic>
@@ -19,26 +28,35 @@ namespace boost {
 namespace lockfree {
 namespace detail {
 
-#ifdef BOOST_NO_0X_HDR_ATOMIC
+#ifdef BOOST_LOCKFREE_USE_BOOST_ATOMIC
 using boost::atomic;
+using boost::atomic_thread_fence;
+using boost::memory_order_acq_rel;
 using boost::memory_order_acquire;
 using boost::memory_order_consume;
 using boost::memory_order_relaxed;
 using boost::memory_order_release;
+using boost::memory_order_seq_cst;
 #else
 using std::atomic;
+using std::atomic_thread_fence;
+using std::memory_order_acq_rel;
 using std::memory_order_acquire;
 using std::memory_order_consume;
 using std::memory_order_relaxed;
 using std::memory_order_release;
+using std::memory_order_seq_cst;
 #endif
 
 }
 using detail::atomic;
+using detail::atomic_thread_fence;
+using detail::memory_order_acq_rel;
 using detail::memory_order_acquire;
 using detail::memory_order_consume;
 using detail::memory_order_relaxed;
 using detail::memory_order_release;
+using detail::memory_order_seq_cst;
 
 }}
 
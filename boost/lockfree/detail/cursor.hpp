@@ -0,0 +1,79 @@
+//  cache-line aligned cursors of single-producer ringbuffers
+//
+//  Copyright (C) 2026 Tim Blechmann
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  Disclaimer: Not a Boost library.
+
+#ifndef BOOST_LOCKFREE_DETAIL_CURSOR_HPP_INCLUDED
+#define BOOST_LOCKFREE_DETAIL_CURSOR_HPP_INCLUDED
+
+#include <boost/noncopyable.hpp>
+
+#include <boost/lockfree/detail/atomic.hpp>
+#include <boost/lockfree/detail/freelist.hpp>
+#include <boost/lockfree/detail/prefix.hpp>
+
+#include <cstddef>              /* for std::size_t */
+#include <new>
+
+namespace boost {
+namespace lockfree {
+namespace detail {
+
+/* a fixed number of positions, each on a cache line of its own. positions are monotonically increasing sequence
+ * numbers, the element at position p is stored in the slot p % max_size */
+template <typename Alloc>
+class cursor_array:
+    boost::noncopyable
+{
+    struct cursor
+    {
+        atomic<std::size_t> position;
+        char padding[BOOST_LOCKFREE_CACHELINE_BYTES - sizeof(atomic<std::size_t>)];
+    };
+
+    typedef typename rebind_allocator<Alloc, char>::type byte_allocator;
+
+    std::size_t bytes(void) const
+    {
+        /* one additional cache line for the alignment */
+        return (size_ + 1) * sizeof(cursor);
+    }
+
+public:
+    cursor_array(std::size_t size, Alloc const & alloc):
+        alloc_(alloc), size_(size), storage_(alloc_.allocate(bytes()))
+    {
+        const std::size_t aligned = (reinterpret_cast<std::size_t>(storage_) + BOOST_LOCKFREE_CACHELINE_BYTES - 1)
+                                    / BOOST_LOCKFREE_CACHELINE_BYTES * BOOST_LOCKFREE_CACHELINE_BYTES;
+        cursors_ = reinterpret_cast<cursor*>(aligned);
+        for (std::size_t i = 0; i != size_; ++i)
+            new (&cursors_[i].position) atomic<std::size_t>(0);
+    }
+
+    ~cursor_array(void)
+    {
+        alloc_.deallocate(storage_, bytes());
+    }
+
+    atomic<std::size_t> & operator[](std::size_t index) const
+    {
+        return cursors_[index].position;
+    }
+
+private:
+    byte_allocator alloc_;
+    const std::size_t size_;
+    char * const storage_;
+    cursor * cursors_;
+};
+
+} /* namespace detail */
+} /* namespace lockfree */
+} /* namespace boost */
+
+#endif /* BOOST_LOCKFREE_DETAIL_CURSOR_HPP_INCLUDED */
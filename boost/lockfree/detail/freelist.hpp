@@ -14,6 +14,7 @@
 #include <boost/lockfree/detail/tagged_ptr.hpp>
 
 #include <boost/lockfree/detail/atomic.hpp>
+#include <boost/config.hpp>
 #include <boost/noncopyable.hpp>
 
 #include <boost/mpl/map.hpp>
@@ -22,6 +23,8 @@
 #include <boost/type_traits/is_pod.hpp>
 
 #include <algorithm>            /* for std::min */
+#include <memory>               /* for std::allocator */
+#include <utility>              /* for std::forward */
 
 namespace boost
 {
@@ -30,6 +33,16 @@ namespace lockfree
 namespace detail
 {
 
+template <typename Alloc, typename T>
+struct rebind_allocator
+{
+#ifdef BOOST_NO_CXX11_ALLOCATOR
+    typedef typename Alloc::template rebind<T>::other type;
+#else
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<T> type;
+#endif
+};
+
 struct freelist_node
 {
     tagged_ptr<freelist_node> next;
@@ -51,6 +64,13 @@ public:
         reserve_unsafe(n);
     }
 
+    template <typename Allocator>
+    freelist_stack (Allocator const & alloc, std::size_t n):
+        Alloc(alloc), pool_(tagged_node_ptr(NULL))
+    {
+        reserve_unsafe(n);
+    }
+
     void reserve (std::size_t count)
     {
         for (std::size_t i = 0; i != count; ++i) {
@@ -67,6 +87,25 @@ public:
         }
     }
 
+#if !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES) && !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+    template <typename... ArgumentTypes>
+    T * construct (ArgumentTypes &&... args)
+    {
+        T * node = allocate();
+        if (node)
+            new(node) T(std::forward<ArgumentTypes>(args)...);
+        return node;
+    }
+
+    template <typename... ArgumentTypes>
+    T * construct_unsafe (ArgumentTypes &&... args)
+    {
+        T * node = allocate_unsafe();
+        if (node)
+            new(node) T(std::forward<ArgumentTypes>(args)...);
+        return node;
+    }
+#else
     T * construct (void)
     {
         T * node = allocate();
@@ -100,7 +139,7 @@ public:
             new(node) T(arg);
         return node;
     }
-
+#endif
 
     void destruct (T * n)
     {
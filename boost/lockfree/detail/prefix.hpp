@@ -13,8 +13,13 @@
    BOOST_LOCKFREE_CACHELINE_BYTES: size of a cache line
    BOOST_LOCKFREE_PTR_COMPRESSION: use tag/pointer compression to utilize parts
                                    of the virtual address space as tag (at least 16bit)
+                                   unless BOOST_LOCKFREE_NO_PTR_COMPRESSION is defined,
+                                   which selects full-width pointers and tags, updated via
+                                   16 byte compare-and-swap
    BOOST_LOCKFREE_DCAS_ALIGNMENT:  symbol used for aligning structs at cache line
                                    boundaries
+   BOOST_LOCKFREE_THREAD_LOCAL:    storage class specifier for thread-local variables
+                                   of pod types
 */
 
 #define BOOST_LOCKFREE_CACHELINE_BYTES 64
@@ -22,11 +27,14 @@
 #ifdef _MSC_VER
 
 #define BOOST_LOCKFREE_CACHELINE_ALIGNMENT __declspec(align(BOOST_LOCKFREE_CACHELINE_BYTES))
+#define BOOST_LOCKFREE_THREAD_LOCAL __declspec(thread)
 
 #if defined(_M_IX86)
     #define BOOST_LOCKFREE_DCAS_ALIGNMENT
 #elif defined(_M_X64) || defined(_M_IA64)
+    #ifndef BOOST_LOCKFREE_NO_PTR_COMPRESSION
     #define BOOST_LOCKFREE_PTR_COMPRESSION 1
+    #endif
     #define BOOST_LOCKFREE_DCAS_ALIGNMENT __declspec(align(16))
 #endif
 
@@ -35,16 +43,31 @@
 #ifdef __GNUC__
 
 #define BOOST_LOCKFREE_CACHELINE_ALIGNMENT __attribute__((aligned(BOOST_LOCKFREE_CACHELINE_BYTES)))
+#define BOOST_LOCKFREE_THREAD_LOCAL __thread
 
 #if defined(__i386__) || defined(__ppc__)
     #define BOOST_LOCKFREE_DCAS_ALIGNMENT
 #elif defined(__x86_64__)
+    #ifndef BOOST_LOCKFREE_NO_PTR_COMPRESSION
     #define BOOST_LOCKFREE_PTR_COMPRESSION 1
+    #endif
     #define BOOST_LOCKFREE_DCAS_ALIGNMENT __attribute__((aligned(16)))
+#elif defined(__aarch64__)
+    #define BOOST_LOCKFREE_DCAS_ALIGNMENT __attribute__((aligned(16)))
+#elif defined(__riscv) && __riscv_xlen == 64
+    // there is no 16 byte compare-and-swap, user space addresses are not wider than 48 bits
+    #ifndef BOOST_LOCKFREE_NO_PTR_COMPRESSION
+    #define BOOST_LOCKFREE_PTR_COMPRESSION 1
+    #endif
+    #define BOOST_LOCKFREE_DCAS_ALIGNMENT
 #elif defined(__alpha__)
     // LATER: alpha may benefit from pointer compression. but what is the maximum size of the address space?
     #define BOOST_LOCKFREE_DCAS_ALIGNMENT
 #endif
 #endif /* __GNUC__ */
 
+#ifndef BOOST_LOCKFREE_DCAS_ALIGNMENT
+#define BOOST_LOCKFREE_DCAS_ALIGNMENT
+#endif
+
 #endif /* BOOST_LOCKFREE_PREFIX_HPP_INCLUDED */
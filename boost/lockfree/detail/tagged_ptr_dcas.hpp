@@ -29,21 +29,12 @@ public:
     tagged_ptr(void)//: ptr(0), tag(0)
     {}
 
-    tagged_ptr(tagged_ptr const & p):
-        ptr(p.ptr), tag(p.tag)
-    {}
-
     explicit tagged_ptr(T * p, tag_t t = 0):
         ptr(p), tag(t)
     {}
 
     /** unsafe set operation */
     /* @{ */
-    void operator= (tagged_ptr const & p)
-    {
-        set(p.ptr, p.tag);
-    }
-
     void set(T * p, tag_t t)
     {
         ptr = p;
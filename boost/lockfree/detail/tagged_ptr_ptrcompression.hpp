@@ -15,13 +15,14 @@
 
 #include <cstddef>              /* for std::size_t */
 
+#include <boost/config.hpp>
 #include <boost/cstdint.hpp>
 
 namespace boost {
 namespace lockfree {
 namespace detail {
 
-#if defined (__x86_64__) || defined (_M_X64)
+#if defined (__x86_64__) || defined (_M_X64) || (defined(__riscv) && __riscv_xlen == 64)
 
 template <class T>
 class tagged_ptr
@@ -61,12 +62,7 @@ private:
 
 public:
     /** uninitialized constructor */
-    tagged_ptr(void) noexcept //: ptr(0), tag(0)
-    {}
-
-    /** copy constructor */
-    tagged_ptr(tagged_ptr const & p):
-        ptr(p.ptr)
+    tagged_ptr(void) BOOST_NOEXCEPT //: ptr(0), tag(0)
     {}
 
     explicit tagged_ptr(T * p, tag_t t = 0):
@@ -75,11 +71,6 @@ public:
 
     /** unsafe set operation */
     /* @{ */
-    void operator= (tagged_ptr const & p)
-    {
-        ptr = p.ptr;
-    }
-
     void set(T * p, tag_t t)
     {
         ptr = pack_ptr(p, t);
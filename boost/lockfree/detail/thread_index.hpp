@@ -0,0 +1,44 @@
+//  small integer identifiers of threads
+//
+//  Copyright (C) 2026 Tim Blechmann
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  Disclaimer: Not a Boost library.
+
+#ifndef BOOST_LOCKFREE_DETAIL_THREAD_INDEX_HPP_INCLUDED
+#define BOOST_LOCKFREE_DETAIL_THREAD_INDEX_HPP_INCLUDED
+
+#include <boost/lockfree/detail/atomic.hpp>
+#include <boost/lockfree/detail/branch_hints.hpp>
+#include <boost/lockfree/detail/prefix.hpp>
+
+#include <cstddef>              /* for std::size_t */
+
+#ifdef BOOST_LOCKFREE_THREAD_LOCAL
+
+namespace boost {
+namespace lockfree {
+namespace detail {
+
+/* returns a small integer, which identifies the calling thread. threads are numbered in the order of their first
+ * call */
+inline std::size_t thread_index(void)
+{
+    static atomic<std::size_t> thread_count(0);
+    static BOOST_LOCKFREE_THREAD_LOCAL std::size_t index = 0; /* 0: not assigned, otherwise the thread index + 1 */
+
+    if (unlikely(index == 0))
+        index = thread_count.fetch_add(1, memory_order_relaxed) + 1;
+    return index - 1;
+}
+
+} /* namespace detail */
+} /* namespace lockfree */
+} /* namespace boost */
+
+#endif /* BOOST_LOCKFREE_THREAD_LOCAL */
+
+#endif /* BOOST_LOCKFREE_DETAIL_THREAD_INDEX_HPP_INCLUDED */
@@ -0,0 +1,287 @@
+//  eventfd notification for lock-free queues
+//
+//  Copyright (C) 2026 Tim Blechmann
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  Disclaimer: Not a Boost library.
+
+#ifndef BOOST_LOCKFREE_EVENTFD_QUEUE_HPP_INCLUDED
+#define BOOST_LOCKFREE_EVENTFD_QUEUE_HPP_INCLUDED
+
+#ifndef __linux__
+#error "boost/lockfree/eventfd_queue.hpp requires linux"
+#endif
+
+#include <boost/noncopyable.hpp>
+#include <boost/system/system_error.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <boost/lockfree/detail/atomic.hpp>
+#include <boost/lockfree/ringbuffer.hpp>
+
+#include <cerrno>
+#include <cstddef>              /* for std::size_t */
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+namespace boost {
+namespace lockfree {
+namespace detail {
+
+template <typename Queue, typename T>
+std::size_t dequeue_batch(Queue & queue, T * ret, std::size_t size)
+{
+    std::size_t count = 0;
+    while (count != size && queue.dequeue(ret[count]))
+        ++count;
+    return count;
+}
+
+template <typename T, std::size_t max_size, typename Alloc>
+std::size_t dequeue_batch(ringbuffer<T, max_size, Alloc> & queue, T * ret, std::size_t size)
+{
+    return queue.dequeue(ret, size);
+}
+
+} /* namespace detail */
+
+/** The eventfd_queue class wraps a boost::lockfree::ringbuffer or boost::lockfree::fifo and signals a linux eventfd,
+ *  whenever the consumer has to be woken up. This allows a consumer thread to wait for the queue in an epoll/poll/select
+ *  based event loop.
+ *
+ *  Notifications are coalesced: a producer only writes to the eventfd, if the consumer has re-armed the notification
+ *  after it drained the queue. While the consumer is active, enqueue operations do not issue any system call. The
+ *  consumer is expected to use the following protocol, when the file descriptor becomes readable:
+ *
+ *  - call acknowledge() to reset the eventfd
+ *  - dequeue until the queue is empty
+ *  - call rearm(). If it returns false, elements have been enqueued concurrently and the consumer has to continue
+ *    dequeueing.
+ *
+ *  consume_all() implements this protocol.
+ *
+ *  \b Limitation: Only a single consumer thread is supported.
+ *
+ * */
+template <typename Queue>
+class eventfd_queue:
+    boost::noncopyable
+{
+#ifndef BOOST_DOXYGEN_INVOKED
+    enum {
+        armed,      /* consumer is waiting for a notification */
+        notified    /* notification is pending or consumer is active */
+    };
+
+    static const std::size_t batch_size = 64;
+
+    void initialize(void)
+    {
+        fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (fd_ == -1)
+            boost::throw_exception(boost::system::system_error(errno, boost::system::system_category(),
+                                                               "eventfd"));
+    }
+
+    void notify(void)
+    {
+        /* pairs with the fence in rearm(): either we see the armed state or the consumer sees our element */
+        atomic_thread_fence(memory_order_seq_cst);
+
+        if (state_.load(memory_order_relaxed) != armed)
+            return;
+
+        if (state_.exchange(notified) == armed)
+            ::eventfd_write(fd_, 1);
+    }
+
+    template <typename Functor>
+    std::size_t consume_all_impl(Functor & f)
+    {
+        acknowledge();
+
+        std::size_t consumed = 0;
+        value_type buffer[batch_size];
+        for (;;) {
+            std::size_t count = dequeue(buffer, batch_size);
+            for (std::size_t i = 0; i != count; ++i)
+                f(buffer[i]);
+            consumed += count;
+
+            if (count == 0 && rearm())
+                return consumed;
+        }
+    }
+#endif
+
+public:
+    typedef typename Queue::value_type value_type;
+
+    //! Construct eventfd_queue.
+    eventfd_queue(void):
+        state_(armed)
+    {
+        initialize();
+    }
+
+    /** Construct eventfd_queue, passing arg to the constructor of the underlying queue
+     *
+     * \throws boost::system::system_error, if the eventfd cannot be created
+     * */
+    template <typename Argument>
+    explicit eventfd_queue(Argument const & arg):
+        queue_(arg), state_(armed)
+    {
+        initialize();
+    }
+
+    ~eventfd_queue(void)
+    {
+        ::close(fd_);
+    }
+
+    /** \return file descriptor of the eventfd, which should be registered for EPOLLIN/POLLIN.
+     * */
+    int native_handle(void) const
+    {
+        return fd_;
+    }
+
+    //! \copydoc boost::lockfree::stack::is_lock_free
+    bool is_lock_free(void) const
+    {
+        return queue_.is_lock_free() && state_.is_lock_free();
+    }
+
+    /** Check if the underlying queue is empty
+     *
+     * \warning Not thread-safe, use for debugging purposes only
+     * */
+    bool empty(void)
+    {
+        return queue_.empty();
+    }
+
+    /** Enqueues object t to the underlying queue and signals the eventfd, if the consumer is waiting.
+     *
+     * \returns true, if the enqueue operation is successful.
+     *
+     * \note Thread-safe and non-blocking. Only performs a system call, if the consumer needs to be woken up.
+     * */
+    bool enqueue(value_type const & t)
+    {
+        if (!queue_.enqueue(t))
+            return false;
+
+        notify();
+        return true;
+    }
+
+    /** Enqueues size objects from the array t to the underlying ringbuffer.
+     *
+     * \returns number of enqueued items
+     *
+     * \note Thread-safe and non-blocking. Only performs a system call, if the consumer needs to be woken up.
+     * */
+    std::size_t enqueue(value_type const * t, std::size_t size)
+    {
+        std::size_t enqueued = queue_.enqueue(t, size);
+        if (enqueued)
+            notify();
+        return enqueued;
+    }
+
+    /** Dequeue object from the underlying queue.
+     *
+     * \returns true, if the dequeue operation is successful, false if the queue was empty.
+     *
+     * \note Non-blocking, does not perform any system call
+     * */
+    bool dequeue(value_type & ret)
+    {
+        return queue_.dequeue(ret);
+    }
+
+    /** Dequeue a maximum of size objects from the underlying queue.
+     *
+     * \returns number of dequeued items
+     *
+     * \note Non-blocking, does not perform any system call
+     * */
+    std::size_t dequeue(value_type * ret, std::size_t size)
+    {
+        return detail::dequeue_batch(queue_, ret, size);
+    }
+
+    /** Reset the eventfd after it has been reported readable.
+     *
+     * \returns number of notifications, which have been coalesced by the eventfd
+     *
+     * \note Only to be called from the consumer thread.
+     * */
+    std::size_t acknowledge(void)
+    {
+        eventfd_t value;
+        if (::eventfd_read(fd_, &value) == -1)
+            return 0;
+        return value;
+    }
+
+    /** Re-arm the notification after the queue has been drained.
+     *
+     * \returns true, if the consumer can wait for the eventfd, false if elements have been enqueued concurrently and
+     *          the consumer has to continue dequeueing.
+     *
+     * \note Only to be called from the consumer thread.
+     * */
+    bool rearm(void)
+    {
+        state_.store(armed, memory_order_relaxed);
+        atomic_thread_fence(memory_order_seq_cst);
+
+        if (queue_.empty())
+            return true;
+
+        /* a producer may have missed the armed state. if no producer has signalled the eventfd in the meantime, we
+         * reclaim the notification */
+        int expected = armed;
+        return !state_.compare_exchange_strong(expected, notified);
+    }
+
+    /** Drain the queue and re-arm the notification, calling f for every dequeued object.
+     *
+     * \returns number of dequeued objects
+     *
+     * \note Only to be called from the consumer thread, typically when the eventfd has been reported readable.
+     * */
+    template <typename Functor>
+    std::size_t consume_all(Functor & f)
+    {
+        return consume_all_impl(f);
+    }
+
+    /** \copydoc boost::lockfree::eventfd_queue::consume_all(Functor & f)
+     * */
+    template <typename Functor>
+    std::size_t consume_all(Functor const & f)
+    {
+        return consume_all_impl(f);
+    }
+
+private:
+#ifndef BOOST_DOXYGEN_INVOKED
+    Queue queue_;
+    int fd_;
+    char padding[BOOST_LOCKFREE_CACHELINE_BYTES]; /* keep state_ away from the queue's data */
+    atomic<int> state_;
+#endif
+};
+
+} /* namespace lockfree */
+} /* namespace boost */
+
+#endif /* BOOST_LOCKFREE_EVENTFD_QUEUE_HPP_INCLUDED */
@@ -16,12 +16,19 @@
 #define BOOST_LOCKFREE_FIFO_HPP_INCLUDED
 
 #include <memory>               /* std::auto_ptr */
+#include <utility>              /* std::forward, std::move */
 
 #include <boost/noncopyable.hpp>
 #include <boost/scoped_ptr.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/static_assert.hpp>
+#include <boost/move/utility.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
 #include <boost/type_traits/has_trivial_assign.hpp>
+#include <boost/type_traits/has_trivial_copy.hpp>
+#include <boost/type_traits/has_trivial_destructor.hpp>
 
 #include <boost/lockfree/detail/atomic.hpp>
 #include <boost/lockfree/detail/tagged_ptr.hpp>
@@ -37,14 +44,46 @@ class fifo:
 {
 private:
 #ifndef BOOST_DOXYGEN_INVOKED
-    BOOST_STATIC_ASSERT(boost::is_pod<T>::value);
+    /* trivial objects are copied out of the node before it is unlinked, as in the published algorithm. the copy may
+     * be torn, if the node is reused concurrently, but in that case the CAS on head_ fails and the copy is discarded.
+     *
+     * other objects may only be accessed by the thread, which unlinked the node. the node can only be reused, when it
+     * has been unlinked as head *and* its object has been moved out, so it carries a reference count of 2, which is
+     * released by both operations. */
+    typedef boost::mpl::bool_<boost::has_trivial_assign<T>::value &&
+                              boost::has_trivial_copy<T>::value &&
+                              boost::has_trivial_destructor<T>::value
+                             > trivial_data;
+
+    struct dummy_node_tag
+    {};
 
     struct BOOST_LOCKFREE_CACHELINE_ALIGNMENT node
     {
         typedef tagged_ptr<node> tagged_node_ptr;
 
-        node(T const & v):
-            data(v)
+#if !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES) && !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+        template <typename... ArgumentTypes>
+        explicit node(ArgumentTypes &&... args):
+            references(2)
+        {
+            new(data_ptr()) T(std::forward<ArgumentTypes>(args)...);
+            increment_tag();
+        }
+#else
+        explicit node(T const & v):
+            references(2)
+        {
+            new(data_ptr()) T(v);
+            increment_tag();
+        }
+#endif
+
+        explicit node(dummy_node_tag):
+            next(tagged_node_ptr(NULL, 0)), references(1)
+        {}
+
+        void increment_tag(void)
         {
             /* increment tag to avoid ABA problem */
             tagged_node_ptr old_next = next.load(memory_order_relaxed);
@@ -52,17 +91,19 @@ private:
             next.store(new_next, memory_order_release);
         }
 
-        node (void):
-            next(tagged_node_ptr(NULL, 0))
-        {}
+        T * data_ptr(void)
+        {
+            return static_cast<T*>(data.address());
+        }
 
         atomic<tagged_node_ptr> next;
-        T data;
+        atomic<int> references;
+        boost::aligned_storage<sizeof(T), boost::alignment_of<T>::value> data;
     };
 
     typedef tagged_ptr<node> tagged_node_ptr;
 
-    typedef typename Alloc::template rebind<node>::other node_allocator;
+    typedef typename rebind_allocator<Alloc, node>::type node_allocator;
 
     typedef typename boost::mpl::if_<boost::is_same<freelist_t, caching_freelist_t>,
                                      detail::freelist_stack<node, true, node_allocator>,
@@ -71,14 +112,102 @@ private:
 
     void initialize(void)
     {
-        node * n = pool.construct();
+        node * n = pool.construct(dummy_node_tag());
         tagged_node_ptr dummy_node(n, 0);
         head_.store(dummy_node, memory_order_relaxed);
         tail_.store(dummy_node, memory_order_release);
     }
+
+    bool enqueue_node(node * n)
+    {
+        if (n == NULL)
+            return false;
+
+        for (;;) {
+            tagged_node_ptr tail = tail_.load(memory_order_acquire);
+            tagged_node_ptr next = tail->next.load(memory_order_acquire);
+            node * next_ptr = next.get_ptr();
+
+            tagged_node_ptr tail2 = tail_.load(memory_order_acquire);
+            if (likely(tail == tail2)) {
+                if (next_ptr == 0) {
+                    if ( tail->next.compare_exchange_weak(next, tagged_node_ptr(n, next.get_tag() + 1)) ) {
+                        tail_.compare_exchange_strong(tail, tagged_node_ptr(n, tail.get_tag() + 1));
+                        return true;
+                    }
+                }
+                else
+                    tail_.compare_exchange_strong(tail, tagged_node_ptr(next_ptr, tail.get_tag() + 1));
+            }
+        }
+    }
+
+    bool enqueue_node_unsafe(node * n)
+    {
+        if (n == NULL)
+            return false;
+
+        for (;;)
+        {
+            tagged_node_ptr tail = tail_.load(memory_order_relaxed);
+            tagged_node_ptr next = tail->next.load(memory_order_relaxed);
+            node * next_ptr = next.get_ptr();
+
+            if (next_ptr == 0) {
+                tail->next.store(tagged_node_ptr(n, next.get_tag() + 1), memory_order_relaxed);
+                tail_.store(tagged_node_ptr(n, tail.get_tag() + 1), memory_order_relaxed);
+                return true;
+            }
+            else
+                tail_.store(tagged_node_ptr(next_ptr, tail.get_tag() + 1), memory_order_relaxed);
+        }
+    }
+
+    static void copy_data(node * n, T & ret, boost::mpl::true_)
+    {
+        ret = *n->data_ptr();
+    }
+
+    static void copy_data(node *, T &, boost::mpl::false_)
+    {}
+
+    /* called after head has been unlinked and next has become the new head */
+    void finish_dequeue(node * head, node *, T &, boost::mpl::true_)
+    {
+        pool.destruct(head);
+    }
+
+    void finish_dequeue(node * head, node * next, T & ret, boost::mpl::false_)
+    {
+        ret = boost::move(*next->data_ptr());
+        next->data_ptr()->~T();
+        release(next);
+        release(head);
+    }
+
+    void finish_dequeue_unsafe(node * head, node *, T &, boost::mpl::true_)
+    {
+        pool.destruct_unsafe(head);
+    }
+
+    void finish_dequeue_unsafe(node * head, node * next, T & ret, boost::mpl::false_)
+    {
+        ret = boost::move(*next->data_ptr());
+        next->data_ptr()->~T();
+        next->references.store(1, memory_order_relaxed);
+        pool.destruct_unsafe(head);
+    }
+
+    void release(node * n)
+    {
+        if (n->references.fetch_sub(1, memory_order_acq_rel) == 1)
+            pool.destruct(n);
+    }
 #endif
 
 public:
+    typedef T value_type;
+
     /**
      * \return true, if implementation is lock-free.
      *
@@ -106,6 +235,13 @@ public:
         initialize();
     }
 
+    //! Construct fifo, allocate n nodes for the freelist from alloc.
+    fifo(std::size_t n, Alloc const & alloc):
+        pool(alloc, n+1)
+    {
+        initialize();
+    }
+
     //! \copydoc boost::lockfree::stack::reserve
     void reserve(std::size_t n)
     {
@@ -122,12 +258,17 @@ public:
      * */
     ~fifo(void)
     {
-        if (!empty()) {
-            T dummy;
-            while(dequeue_unsafe(dummy))
-                ;
+        node * n = head_.load(memory_order_relaxed).get_ptr();
+        node * next = n->next.load(memory_order_relaxed).get_ptr();
+        pool.destruct_unsafe(n);
+
+        /* all nodes behind the head hold objects */
+        while (next) {
+            n = next;
+            next = n->next.load(memory_order_relaxed).get_ptr();
+            n->data_ptr()->~T();
+            pool.destruct_unsafe(n);
         }
-        pool.destruct(head_.load(memory_order_relaxed).get_ptr());
     }
 
     /** Check if the ringbuffer is empty
@@ -148,28 +289,7 @@ public:
      * */
     bool enqueue(T const & t)
     {
-        node * n = pool.construct(t);
-
-        if (n == NULL)
-            return false;
-
-        for (;;) {
-            tagged_node_ptr tail = tail_.load(memory_order_acquire);
-            tagged_node_ptr next = tail->next.load(memory_order_acquire);
-            node * next_ptr = next.get_ptr();
-
-            tagged_node_ptr tail2 = tail_.load(memory_order_acquire);
-            if (likely(tail == tail2)) {
-                if (next_ptr == 0) {
-                    if ( tail->next.compare_exchange_weak(next, tagged_node_ptr(n, next.get_tag() + 1)) ) {
-                        tail_.compare_exchange_strong(tail, tagged_node_ptr(n, tail.get_tag() + 1));
-                        return true;
-                    }
-                }
-                else
-                    tail_.compare_exchange_strong(tail, tagged_node_ptr(next_ptr, tail.get_tag() + 1));
-            }
-        }
+        return enqueue_node(pool.construct(t));
     }
 
     /** Enqueues object t to the fifo. Enqueueing may fail, if the freelist is not able to allocate a new fifo node.
@@ -181,30 +301,61 @@ public:
      * */
     bool enqueue_unsafe(T const & t)
     {
-        node * n = pool.construct_unsafe(t);
+        return enqueue_node_unsafe(pool.construct_unsafe(t));
+    }
 
-        if (n == NULL)
-            return false;
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+    /** Moves object t into the fifo. Enqueueing may fail, if the freelist is not able to allocate a new fifo node.
+     *
+     * \returns true, if the enqueue operation is successful.
+     *
+     * \note Thread-safe and non-blocking
+     * \warning \b Warning: May block if node needs to be allocated from the operating system
+     * */
+    bool enqueue(T && t)
+    {
+        return enqueue_node(pool.construct(std::move(t)));
+    }
 
-        for (;;)
-        {
-            tagged_node_ptr tail = tail_.load(memory_order_relaxed);
-            tagged_node_ptr next = tail->next.load(memory_order_relaxed);
-            node * next_ptr = next.get_ptr();
+    /** \copydoc boost::lockfree::detail::fifo::enqueue(T && t)
+     *
+     * \note Not thread-safe
+     * */
+    bool enqueue_unsafe(T && t)
+    {
+        return enqueue_node_unsafe(pool.construct_unsafe(std::move(t)));
+    }
+#endif
 
-            if (next_ptr == 0) {
-                tail->next.store(tagged_node_ptr(n, next.get_tag() + 1), memory_order_relaxed);
-                tail_.store(tagged_node_ptr(n, tail.get_tag() + 1), memory_order_relaxed);
-                return true;
-            }
-            else
-                tail_.store(tagged_node_ptr(next_ptr, tail.get_tag() + 1), memory_order_relaxed);
-        }
+#if !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES) && !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+    /** Constructs an object from args in place inside a fifo node and enqueues it. Enqueueing may fail, if the
+     *  freelist is not able to allocate a new fifo node.
+     *
+     * \returns true, if the enqueue operation is successful.
+     *
+     * \note Thread-safe and non-blocking
+     * \warning \b Warning: May block if node needs to be allocated from the operating system
+     * */
+    template <typename... ArgumentTypes>
+    bool emplace(ArgumentTypes &&... args)
+    {
+        return enqueue_node(pool.construct(std::forward<ArgumentTypes>(args)...));
     }
 
+    /** \copydoc boost::lockfree::detail::fifo::emplace
+     *
+     * \note Not thread-safe
+     * */
+    template <typename... ArgumentTypes>
+    bool emplace_unsafe(ArgumentTypes &&... args)
+    {
+        return enqueue_node_unsafe(pool.construct_unsafe(std::forward<ArgumentTypes>(args)...));
+    }
+#endif
+
     /** Dequeue object from fifo.
      *
-     * if dequeue operation is successful, object is written to memory location denoted by ret.
+     * if dequeue operation is successful, object is moved to memory location denoted by ret.
      *
      * \returns true, if the dequeue operation is successful, false if fifo was empty.
      *
@@ -233,9 +384,9 @@ public:
                          * allocation. we can observe a null-pointer here.
                          * */
                         continue;
-                    ret = next_ptr->data;
+                    copy_data(next_ptr, ret, trivial_data());
                     if (head_.compare_exchange_weak(head, tagged_node_ptr(next_ptr, head.get_tag() + 1))) {
-                        pool.destruct(head.get_ptr());
+                        finish_dequeue(head.get_ptr(), next_ptr, ret, trivial_data());
                         return true;
                     }
                 }
@@ -245,7 +396,7 @@ public:
 
     /** Dequeue object from fifo.
      *
-     * if dequeue operation is successful, object is written to memory location denoted by ret.
+     * if dequeue operation is successful, object is moved to memory location denoted by ret.
      *
      * \returns true, if the dequeue operation is successful, false if fifo was empty.
      *
@@ -273,9 +424,9 @@ public:
                      * allocation. we can observe a null-pointer here.
                      * */
                     continue;
-                ret = next_ptr->data;
                 head_.store(tagged_node_ptr(next_ptr, head.get_tag() + 1), memory_order_relaxed);
-                pool.destruct_unsafe(head.get_ptr());
+                copy_data(next_ptr, ret, trivial_data());
+                finish_dequeue_unsafe(head.get_ptr(), next_ptr, ret, trivial_data());
                 return true;
             }
         }
@@ -305,7 +456,10 @@ private:
  *  from the operating system, and struct static_freelist_t uses a fixed-sized freelist. With a fixed-sized
  *  freelist, the enqueue operation may fail, while with a caching freelist, the enqueue operation may block.
  *
- *  \b Limitation: The class T is required to have a trivial assignment operator.
+ *  Objects are constructed in place inside the fifo nodes and moved out by the dequeue operation, so T may be a
+ *  non-trivial or move-only type. Objects of trivially copyable types are copied out of the node before it is
+ *  unlinked, other objects are moved out by the dequeueing thread after the node has been unlinked. In the latter
+ *  case, the node is returned to the freelist by the thread, which finishes last.
  *
  * */
 template <typename T,
@@ -315,8 +469,6 @@ template <typename T,
 class fifo:
     public detail::fifo<T, freelist_t, Alloc>
 {
-    BOOST_STATIC_ASSERT(boost::has_trivial_assign<T>::value);
-
 public:
     //! Construct fifo.
     fifo(void)
@@ -326,6 +478,11 @@ public:
     explicit fifo(std::size_t n):
         detail::fifo<T, freelist_t, Alloc>(n)
     {}
+
+    //! Construct fifo, allocate n nodes for the freelist from alloc.
+    fifo(std::size_t n, Alloc const & alloc):
+        detail::fifo<T, freelist_t, Alloc>(n, alloc)
+    {}
 };
 
 
@@ -365,6 +522,11 @@ public:
         fifo_t(n)
     {}
 
+    //! Construct fifo, allocate n nodes for the freelist from alloc.
+    fifo(std::size_t n, Alloc const & alloc):
+        fifo_t(n, alloc)
+    {}
+
     //! \copydoc detail::fifo::dequeue
     bool dequeue (T * & ret)
     {
@@ -0,0 +1,528 @@
+//  lock-free hash map, based on split-ordered lists from
+//  Shalev, O. and Shavit, N.,
+//  "split-ordered lists: lock-free extensible hash tables"
+//
+//  the underlying list and its aba prevention from
+//  Michael, M. M.,
+//  "high performance dynamic lock-free hash tables and list-based sets"
+//
+//  Copyright (C) 2026 Tim Blechmann
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  Disclaimer: Not a Boost library.
+
+#ifndef BOOST_LOCKFREE_HASH_MAP_HPP_INCLUDED
+#define BOOST_LOCKFREE_HASH_MAP_HPP_INCLUDED
+
+#include <boost/functional/hash.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/mpl/if.hpp>
+#include <boost/type_traits/has_trivial_assign.hpp>
+#include <boost/type_traits/has_trivial_copy.hpp>
+#include <boost/type_traits/has_trivial_destructor.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <boost/lockfree/detail/atomic.hpp>
+#include <boost/lockfree/detail/branch_hints.hpp>
+#include <boost/lockfree/detail/freelist.hpp>
+#include <boost/lockfree/detail/prefix.hpp>
+#include <boost/lockfree/detail/tagged_ptr.hpp>
+
+#include <climits>              /* for CHAR_BIT */
+#include <cstddef>              /* for std::size_t */
+#include <functional>           /* for std::equal_to */
+#include <memory>               /* for std::allocator */
+#include <new>
+
+namespace boost {
+namespace lockfree {
+namespace detail {
+
+inline std::size_t reverse_bits(std::size_t x)
+{
+    std::size_t shift = sizeof(std::size_t) * CHAR_BIT;
+    std::size_t mask = ~std::size_t(0);
+    while ((shift >>= 1) > 0) {
+        mask ^= mask << shift;
+        x = ((x >> shift) & mask) | ((x << shift) & ~mask);
+    }
+    return x;
+}
+
+} /* namespace detail */
+
+/** The hash_map class provides a multi-writer/multi-reader hash map, lookups, insertions and erasures are lockfree.
+ *
+ *  All elements are stored in a single linked list, which is sorted by the bit-reversed hash values (split order).
+ *  Each bucket points to a dummy node inside this list, so doubling the number of buckets never moves an element:
+ *  a new bucket is initialized lazily on its first access by inserting its dummy node after the dummy node of its
+ *  parent bucket. The map grows incrementally, whenever the load factor exceeds max_load_factor.
+ *
+ *  Lookups do not write to shared memory, unless they encounter a node, which has been erased, but not yet unlinked.
+ *  Lookups only restart, if a node, which they traverse, is modified concurrently.
+ *
+ *  Like stack and fifo, the hash_map uses a freelist for memory management, erased nodes are pushed to the freelist
+ *  and not returned to the os before the hash_map is destroyed. The freelist can be selected via the freelist_t
+ *  template argument: with a caching_freelist_t, insert() may block, with a static_freelist_t, insert() may fail.
+ *  Each bucket requires one node of the freelist.
+ *
+ *  \b Limitation: Key and T are required to be trivially copyable and trivially destructible. Since nodes are reused,
+ *                 lookups may read keys and values of nodes, which are modified concurrently, before detecting the
+ *                 modification. Elements cannot be modified in place.
+ * */
+template <typename Key,
+          typename T,
+          typename Hash = boost::hash<Key>,
+          typename Pred = std::equal_to<Key>,
+          typename freelist_t = caching_freelist_t,
+          typename Alloc = std::allocator<T>
+         >
+class hash_map:
+    boost::noncopyable
+{
+#ifndef BOOST_DOXYGEN_INVOKED
+    BOOST_STATIC_ASSERT(boost::has_trivial_assign<Key>::value);
+    BOOST_STATIC_ASSERT(boost::has_trivial_copy<Key>::value);
+    BOOST_STATIC_ASSERT(boost::has_trivial_destructor<Key>::value);
+    BOOST_STATIC_ASSERT(boost::has_trivial_assign<T>::value);
+    BOOST_STATIC_ASSERT(boost::has_trivial_copy<T>::value);
+    BOOST_STATIC_ASSERT(boost::has_trivial_destructor<T>::value);
+
+    typedef std::size_t size_t;
+
+    /* the lowest bit of the tag marks a node as erased. every modification of next increments the tag, so a thread
+     * can validate, that a node has not been unlinked or reused since it has been read. when a node is pushed to the
+     * freelist, the freelist only overwrites the pointer and the tag is preserved. */
+    struct node
+    {
+        typedef detail::tagged_ptr<node> tagged_node_ptr;
+
+        atomic<tagged_node_ptr> next;
+        size_t split_key;       /* bit-reversed hash, odd for elements, even for the dummy nodes of the buckets */
+        Key key;
+        T value;
+    };
+
+    typedef detail::tagged_ptr<node> tagged_node_ptr;
+    typedef atomic<node*> bucket;
+
+    typedef typename detail::rebind_allocator<Alloc, node>::type node_allocator;
+    typedef typename detail::rebind_allocator<Alloc, bucket>::type bucket_allocator;
+
+    typedef typename boost::mpl::if_<boost::is_same<freelist_t, caching_freelist_t>,
+                                     detail::freelist_stack<node, true, node_allocator>,
+                                     detail::freelist_stack<node, false, node_allocator>
+                                     >::type pool_t;
+
+    enum {
+        max_load_factor = 2,
+        segment_count = sizeof(size_t) * CHAR_BIT
+    };
+
+    static bool is_marked(tagged_node_ptr const & p)
+    {
+        return p.get_tag() & 1;
+    }
+
+    static size_t regular_key(size_t hash)
+    {
+        return detail::reverse_bits(hash | (size_t(1) << (segment_count - 1)));
+    }
+
+    static size_t dummy_key(size_t bucket_index)
+    {
+        return detail::reverse_bits(bucket_index);
+    }
+
+    /* the parent of a bucket is the bucket, which it has been split from */
+    static size_t parent_bucket(size_t bucket_index)
+    {
+        size_t msb = size_t(1) << (segment_count - 1);
+        while (!(bucket_index & msb))
+            msb >>= 1;
+        return bucket_index & ~msb;
+    }
+
+    /* buckets are stored in segments, which are allocated when the bucket count grows. segment 0 holds the buckets
+     * [0, 2[, segment s holds the buckets [2^s, 2^(s+1)[ */
+    static size_t segment_index(size_t bucket_index)
+    {
+        size_t ret = 0;
+        while (bucket_index >> (ret + 1))
+            ++ret;
+        return ret;
+    }
+
+    static size_t segment_size(size_t segment)
+    {
+        return segment == 0 ? 2 : size_t(1) << segment;
+    }
+
+    bucket & get_bucket_slot(size_t bucket_index)
+    {
+        const size_t segment = segment_index(bucket_index);
+        const size_t offset = segment == 0 ? bucket_index : bucket_index - (size_t(1) << segment);
+
+        bucket * buckets = segments_[segment].load(memory_order_acquire);
+        if (unlikely(buckets == NULL)) {
+            bucket * new_buckets = bucket_alloc_.allocate(segment_size(segment));
+            for (size_t i = 0; i != segment_size(segment); ++i)
+                new (new_buckets + i) bucket(NULL);
+
+            if (segments_[segment].compare_exchange_strong(buckets, new_buckets))
+                buckets = new_buckets;
+            else
+                bucket_alloc_.deallocate(new_buckets, segment_size(segment));
+        }
+        return buckets[offset];
+    }
+
+    /* returns a node with an unmarked tag, which is larger than any tag, that its next pointer had before */
+    node * allocate_node(size_t split_key)
+    {
+        node * n = pool.allocate();
+        if (n == NULL)
+            return NULL;
+
+        const tagged_node_ptr old_next = n->next.load(memory_order_relaxed);
+        n->next.store(tagged_node_ptr(NULL, (old_next.get_tag() | 1) + 1), memory_order_relaxed);
+        n->split_key = split_key;
+        return n;
+    }
+
+    /* a position in the list: *prev held the value cur, when cur->next has been read as next */
+    struct position
+    {
+        atomic<tagged_node_ptr> * prev;
+        tagged_node_ptr cur;
+        tagged_node_ptr next;
+    };
+
+    /* searches the list after start for the node with the given split key and key (or the dummy node with the given
+     * split key, if key is NULL). erased nodes are unlinked on the way.
+     *
+     * \returns true, if the node has been found: pos.cur points to it. otherwise pos.cur points to the first node with
+     *          a larger split key, before which a new node can be inserted
+     * */
+    bool find_position(node * start, size_t split_key, Key const * key, position & pos, T * value = NULL)
+    {
+    try_again:
+        pos.prev = &start->next;
+        pos.cur = pos.prev->load(memory_order_acquire);
+
+        for (;;) {
+            node * cur = pos.cur.get_ptr();
+            if (cur == NULL)
+                return false;
+
+            pos.next = cur->next.load(memory_order_acquire);
+            const size_t cur_split_key = cur->split_key;
+            const bool found = cur_split_key == split_key && (key == NULL || pred_(cur->key, *key));
+            if (found && value)
+                *value = cur->value;
+
+            /* the node may have been unlinked and reused, while we were reading it */
+            atomic_thread_fence(memory_order_acquire);
+            if (pos.prev->load(memory_order_relaxed) != pos.cur)
+                goto try_again;
+
+            if (!is_marked(pos.next)) {
+                if (found)
+                    return true;
+                if (cur_split_key > split_key)
+                    return false;
+
+                pos.prev = &cur->next;
+                pos.cur = pos.next;
+            } else {
+                tagged_node_ptr unlinked(pos.next.get_ptr(), pos.cur.get_tag() + 2);
+                if (!pos.prev->compare_exchange_strong(pos.cur, unlinked))
+                    goto try_again;
+
+                pool.deallocate(cur);
+                pos.cur = unlinked;
+            }
+        }
+    }
+
+    /* returns the dummy node of the bucket, initializing the bucket if necessary */
+    node * get_bucket(size_t bucket_index)
+    {
+        bucket & slot = get_bucket_slot(bucket_index);
+        node * dummy = slot.load(memory_order_acquire);
+        if (likely(dummy != NULL))
+            return dummy;
+
+        return initialize_bucket(bucket_index, slot);
+    }
+
+    node * initialize_bucket(size_t bucket_index, bucket & slot)
+    {
+        node * parent = get_bucket(parent_bucket(bucket_index));
+        const size_t split_key = dummy_key(bucket_index);
+
+        node * dummy = allocate_node(split_key);
+        if (dummy == NULL)
+            return parent;      /* the bucket can be initialized later, its elements are found via the parent */
+
+        position pos;
+        for (;;) {
+            if (find_position(parent, split_key, NULL, pos)) {
+                /* initialized by another thread */
+                pool.deallocate(dummy);
+                dummy = pos.cur.get_ptr();
+                break;
+            }
+
+            dummy->next.store(tagged_node_ptr(pos.cur.get_ptr(), dummy->next.load(memory_order_relaxed).get_tag()),
+                              memory_order_relaxed);
+            if (pos.prev->compare_exchange_weak(pos.cur, tagged_node_ptr(dummy, pos.cur.get_tag() + 2)))
+                break;
+        }
+
+        slot.store(dummy, memory_order_release);
+        return dummy;
+    }
+
+    node * bucket_start(size_t hash)
+    {
+        const size_t bucket_index = hash & (bucket_count_.load(memory_order_relaxed) - 1);
+        return get_bucket(bucket_index);
+    }
+
+    void grow(size_t size)
+    {
+        size_t buckets = bucket_count_.load(memory_order_relaxed);
+        if (size > buckets * max_load_factor && buckets < (size_t(1) << (segment_count - 1)))
+            bucket_count_.compare_exchange_strong(buckets, buckets * 2, memory_order_relaxed);
+    }
+
+    static size_t initial_bucket_count(size_t n)
+    {
+        size_t ret = 2;
+        while (ret * max_load_factor < n)
+            ret *= 2;
+        return ret;
+    }
+
+    void initialize(size_t n)
+    {
+        for (size_t i = 0; i != segment_count; ++i)
+            segments_[i].store(NULL, memory_order_relaxed);
+
+        /* bucket 0 holds the head of the list */
+        node * head = allocate_node(0);
+        head->next.store(tagged_node_ptr(NULL, 0), memory_order_relaxed);
+        get_bucket_slot(0).store(head, memory_order_release);
+        bucket_count_.store(initial_bucket_count(n), memory_order_release);
+    }
+#endif
+
+public:
+    typedef Key key_type;
+    typedef T mapped_type;
+    typedef Hash hasher;
+    typedef Pred key_equal;
+
+    //! Construct hash_map
+    hash_map(void):
+        pool(1), size_(0)
+    {
+        initialize(0);
+    }
+
+    /** Construct hash_map, allocate n nodes for the freelist. The initial number of buckets is chosen, so that n
+     *  elements can be stored without growing the map.
+     * */
+    explicit hash_map(size_t n, Hash const & hash = Hash(), Pred const & pred = Pred()):
+        pool(n + 1), hash_(hash), pred_(pred), size_(0)           /* one additional node for the head of the list */
+    {
+        initialize(n);
+    }
+
+    //! Construct hash_map, allocate n nodes for the freelist from alloc
+    hash_map(size_t n, Hash const & hash, Pred const & pred, Alloc const & alloc):
+        pool(alloc, n + 1), hash_(hash), pred_(pred), bucket_alloc_(alloc), size_(0)
+    {
+        initialize(n);
+    }
+
+    /** Destroys hash_map, free all nodes from freelist.
+     *
+     *  \note not thread-safe
+     * */
+    ~hash_map(void)
+    {
+        node * n = get_bucket_slot(0).load(memory_order_relaxed);
+        while (n) {
+            node * next = n->next.load(memory_order_relaxed).get_ptr();
+            pool.deallocate_unsafe(n);
+            n = next;
+        }
+
+        for (size_t i = 0; i != segment_count; ++i) {
+            bucket * buckets = segments_[i].load(memory_order_relaxed);
+            if (buckets)
+                bucket_alloc_.deallocate(buckets, segment_size(i));
+        }
+    }
+
+    //! \copydoc boost::lockfree::stack::is_lock_free
+    bool is_lock_free(void) const
+    {
+        return bucket_count_.is_lock_free() && pool.is_lock_free();
+    }
+
+    //! Allocate n nodes for freelist
+    void reserve(size_t n)
+    {
+        pool.reserve(n);
+    }
+
+    /** \returns number of elements
+     *
+     * \note The number may be outdated, if elements are inserted or erased concurrently
+     * */
+    size_t size(void) const
+    {
+        return size_.load(memory_order_relaxed);
+    }
+
+    /** Check if the hash_map is empty
+     *
+     * \note The result may be outdated, if elements are inserted or erased concurrently
+     * */
+    bool empty(void) const
+    {
+        return size() == 0;
+    }
+
+    //! \returns current number of buckets
+    size_t bucket_count(void) const
+    {
+        return bucket_count_.load(memory_order_relaxed);
+    }
+
+    /** Inserts the pair (key, value), unless the map contains an element with the same key.
+     *
+     * \returns true, if the element has been inserted, false if the key has already been in the map or the freelist is
+     *          not able to allocate a new node.
+     *
+     * \note Thread-safe and non-blocking
+     * \warning \b Warning: May block if node needs to be allocated from the operating system
+     * */
+    bool insert(Key const & key, T const & value)
+    {
+        const size_t hash = hash_(key);
+        const size_t split_key = regular_key(hash);
+        node * start = bucket_start(hash);
+        node * n = NULL;
+        position pos;
+
+        for (;;) {
+            if (find_position(start, split_key, &key, pos)) {
+                if (n)
+                    pool.deallocate(n);
+                return false;
+            }
+
+            if (n == NULL) {
+                n = allocate_node(split_key);
+                if (n == NULL)
+                    return false;
+                n->key = key;
+                n->value = value;
+            }
+
+            n->next.store(tagged_node_ptr(pos.cur.get_ptr(), n->next.load(memory_order_relaxed).get_tag()),
+                          memory_order_relaxed);
+            if (pos.prev->compare_exchange_weak(pos.cur, tagged_node_ptr(n, pos.cur.get_tag() + 2))) {
+                grow(size_.fetch_add(1, memory_order_relaxed) + 1);
+                return true;
+            }
+        }
+    }
+
+    /** Erases the element with the given key.
+     *
+     * \returns true, if the element has been erased, false if the key has not been in the map.
+     *
+     * \note Thread-safe and non-blocking
+     * */
+    bool erase(Key const & key)
+    {
+        const size_t hash = hash_(key);
+        const size_t split_key = regular_key(hash);
+        node * start = bucket_start(hash);
+        position pos;
+
+        for (;;) {
+            if (!find_position(start, split_key, &key, pos))
+                return false;
+
+            /* mark the node as erased, then try to unlink it */
+            node * cur = pos.cur.get_ptr();
+            tagged_node_ptr marked(pos.next.get_ptr(), pos.next.get_tag() + 1);
+            if (!cur->next.compare_exchange_weak(pos.next, marked))
+                continue;
+
+            tagged_node_ptr unlinked(pos.next.get_ptr(), pos.cur.get_tag() + 2);
+            if (pos.prev->compare_exchange_strong(pos.cur, unlinked))
+                pool.deallocate(cur);
+            else
+                find_position(start, split_key, &key, pos); /* unlinks the node */
+
+            size_.fetch_sub(1, memory_order_relaxed);
+            return true;
+        }
+    }
+
+    /** Looks up the element with the given key.
+     *
+     * If the lookup is successful, the value is copied to memory location denoted by ret.
+     *
+     * \returns true, if the key has been found.
+     *
+     * \note Thread-safe and non-blocking
+     * */
+    bool find(Key const & key, T & ret)
+    {
+        const size_t hash = hash_(key);
+        position pos;
+        return find_position(bucket_start(hash), regular_key(hash), &key, pos, &ret);
+    }
+
+    /** \returns true, if the key has been found.
+     *
+     * \note Thread-safe and non-blocking
+     * */
+    bool contains(Key const & key)
+    {
+        const size_t hash = hash_(key);
+        position pos;
+        return find_position(bucket_start(hash), regular_key(hash), &key, pos);
+    }
+
+private:
+#ifndef BOOST_DOXYGEN_INVOKED
+    pool_t pool;
+    Hash hash_;
+    Pred pred_;
+    bucket_allocator bucket_alloc_;
+    atomic<bucket*> segments_[segment_count];
+
+    char padding1[BOOST_LOCKFREE_CACHELINE_BYTES]; /* force bucket_count_ and size_ to a different cache line */
+    atomic<size_t> bucket_count_;
+    char padding2[BOOST_LOCKFREE_CACHELINE_BYTES - sizeof(atomic<size_t>)];
+    atomic<size_t> size_;
+#endif
+};
+
+} /* namespace lockfree */
+} /* namespace boost */
+
+#endif /* BOOST_LOCKFREE_HASH_MAP_HPP_INCLUDED */
@@ -0,0 +1,334 @@
+//  page-based allocator with huge page and numa placement support
+//
+//  Copyright (C) 2026 Tim Blechmann
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  Disclaimer: Not a Boost library.
+
+#ifndef BOOST_LOCKFREE_HUGEPAGE_ALLOCATOR_HPP_INCLUDED
+#define BOOST_LOCKFREE_HUGEPAGE_ALLOCATOR_HPP_INCLUDED
+
+#ifndef __linux__
+#error "boost/lockfree/hugepage_allocator.hpp requires linux"
+#endif
+
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/system/system_error.hpp>
+#include <boost/throw_exception.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+
+#include <boost/lockfree/detail/atomic.hpp>
+#include <boost/lockfree/detail/prefix.hpp>
+
+#include <cerrno>
+#include <cstddef>              /* for std::size_t */
+#include <new>                  /* for std::bad_alloc */
+
+#include <linux/mempolicy.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace boost {
+namespace lockfree {
+namespace detail {
+
+/* maps memory from the operating system. requests, which are larger than small_object_limit get a mapping of their
+ * own, smaller requests are carved out of huge-page sized chunks, which are only unmapped when the arena is destroyed.
+ * this matches the needs of the freelist, which allocates nodes one by one and only frees them on destruction. */
+class hugepage_arena:
+    boost::noncopyable
+{
+public:
+    enum {
+        huge_page_size = 2 * 1024 * 1024,
+        small_object_limit = huge_page_size / 8,
+        max_numa_nodes = 1024
+    };
+
+    enum {
+        explicit_hugepages = 1,
+        transparent_hugepages = 2,
+        prefault = 4
+    };
+
+    hugepage_arena(int numa_node, unsigned int flags):
+        numa_node_(numa_node), explicit_hugepages_(flags & explicit_hugepages),
+        transparent_hugepages_(flags & transparent_hugepages), prefault_(flags & prefault),
+        page_size_(::sysconf(_SC_PAGESIZE)), current_(NULL)
+    {}
+
+    ~hugepage_arena(void)
+    {
+        chunk * c = current_.load(memory_order_relaxed);
+        while (c) {
+            chunk * next = c->next;
+            unmap(c, huge_page_size);
+            c = next;
+        }
+    }
+
+    void * allocate(std::size_t bytes)
+    {
+        if (bytes > small_object_limit)
+            return map(bytes);
+        return allocate_small(bytes);
+    }
+
+    void deallocate(void * p, std::size_t bytes)
+    {
+        /* small objects are released together with their chunk */
+        if (bytes > small_object_limit)
+            unmap(p, bytes);
+    }
+
+private:
+    struct chunk
+    {
+        chunk * next;
+        atomic<std::size_t> used;
+    };
+
+    static std::size_t round_up(std::size_t size, std::size_t granularity)
+    {
+        return (size + granularity - 1) / granularity * granularity;
+    }
+
+    std::size_t mapping_length(std::size_t bytes) const
+    {
+        if (explicit_hugepages_ || bytes >= huge_page_size)
+            return round_up(bytes, huge_page_size);
+        return round_up(bytes, page_size_);
+    }
+
+    void * allocate_small(std::size_t bytes)
+    {
+        /* all objects are cache-line aligned, so that nodes don't share cache lines */
+        bytes = round_up(bytes, BOOST_LOCKFREE_CACHELINE_BYTES);
+
+        chunk * c = current_.load(memory_order_acquire);
+        for (;;) {
+            if (c) {
+                std::size_t offset = c->used.fetch_add(bytes, memory_order_relaxed);
+                if (offset + bytes <= huge_page_size)
+                    return reinterpret_cast<char*>(c) + offset;
+            }
+
+            chunk * fresh = static_cast<chunk*>(map(huge_page_size));
+            fresh->next = c;
+            new (&fresh->used) atomic<std::size_t>(round_up(sizeof(chunk), BOOST_LOCKFREE_CACHELINE_BYTES));
+
+            if (current_.compare_exchange_strong(c, fresh))
+                c = fresh;
+            else
+                /* another thread has installed a chunk */
+                unmap(fresh, huge_page_size);
+        }
+    }
+
+    void * map(std::size_t bytes)
+    {
+        const std::size_t length = mapping_length(bytes);
+        void * p = MAP_FAILED;
+
+        if (explicit_hugepages_)
+            p = ::mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+
+        if (p == MAP_FAILED) {
+            /* no huge pages are reserved or explicit huge pages have not been requested */
+            p = map_aligned(length);
+            if (transparent_hugepages_ || explicit_hugepages_)
+                ::madvise(p, length, MADV_HUGEPAGE);
+        }
+
+        if (numa_node_ >= 0)
+            bind(p, length);
+
+        if (prefault_) {
+            volatile char * begin = static_cast<char*>(p);
+            for (std::size_t i = 0; i < length; i += page_size_)
+                begin[i] = 0;
+        }
+        return p;
+    }
+
+    /* transparent huge pages can only back ranges, which are aligned to the huge page size */
+    void * map_aligned(std::size_t length)
+    {
+        const std::size_t alignment = (length % huge_page_size == 0) ? std::size_t(huge_page_size) : page_size_;
+        const std::size_t padded = length + alignment - page_size_;
+
+        void * p = ::mmap(NULL, padded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED)
+            boost::throw_exception(std::bad_alloc());
+
+        char * begin = static_cast<char*>(p);
+        char * aligned = reinterpret_cast<char*>(round_up(reinterpret_cast<std::size_t>(begin), alignment));
+        char * end = begin + padded;
+
+        if (aligned != begin)
+            ::munmap(begin, aligned - begin);
+        if (aligned + length != end)
+            ::munmap(aligned + length, end - (aligned + length));
+        return aligned;
+    }
+
+    void bind(void * p, std::size_t length)
+    {
+        const std::size_t bits = sizeof(unsigned long) * 8;
+        unsigned long nodemask[max_numa_nodes / bits] = {0};
+
+        int error = EINVAL;
+        if (numa_node_ < max_numa_nodes) {
+            nodemask[numa_node_ / bits] = 1UL << (numa_node_ % bits);
+
+            /* the kernel ignores the last bit of maxnode */
+            if (::syscall(SYS_mbind, p, length, MPOL_BIND, nodemask, max_numa_nodes + 1, 0) == 0)
+                return;
+            error = errno;
+        }
+
+        ::munmap(p, length);
+        boost::throw_exception(boost::system::system_error(error, boost::system::system_category(), "mbind"));
+    }
+
+    void unmap(void * p, std::size_t bytes)
+    {
+        ::munmap(p, mapping_length(bytes));
+    }
+
+    const int numa_node_;
+    const bool explicit_hugepages_, transparent_hugepages_, prefault_;
+    const std::size_t page_size_;
+    atomic<chunk*> current_;
+};
+
+} /* namespace detail */
+
+/** The hugepage_allocator class is a linux-specific allocator, which maps memory directly from the operating system.
+ *  It can be used as Alloc template argument of boost::lockfree::ringbuffer<T, 0>, boost::lockfree::fifo and
+ *  boost::lockfree::stack.
+ *
+ *  - The memory can be backed by huge pages to reduce TLB misses, either from the pool of explicitly reserved huge
+ *    pages (vm.nr_hugepages), or as transparent huge pages. If no explicit huge pages are available, the allocator
+ *    falls back to transparent huge pages.
+ *  - The memory can be bound to a numa node via mbind().
+ *  - The memory can be pre-faulted, so that no page faults occur, when the memory is accessed for the first time.
+ *
+ *  Allocations, which are larger than 256kb are mapped individually. Smaller allocations (e.g. freelist nodes) are
+ *  carved out of shared 2mb chunks and are cache-line aligned. Their memory is only returned to the operating system,
+ *  when the allocator and all its copies are destroyed.
+ *
+ *  \b Limitation: Alignment requirements larger than a cache line are not supported.
+ *
+ *  \note Thread-safe. Copies of an allocator (also rebound copies) share their chunks.
+ * */
+template <typename T>
+class hugepage_allocator
+{
+public:
+    typedef T value_type;
+    typedef T * pointer;
+    typedef T const * const_pointer;
+    typedef T & reference;
+    typedef T const & const_reference;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    template <typename U>
+    struct rebind
+    {
+        typedef hugepage_allocator<U> other;
+    };
+
+    enum {
+        explicit_hugepages = detail::hugepage_arena::explicit_hugepages,        /**< use explicitly reserved huge pages, if available */
+        transparent_hugepages = detail::hugepage_arena::transparent_hugepages,  /**< advise the kernel to use transparent huge pages */
+        prefault = detail::hugepage_arena::prefault                              /**< fault in all pages, when memory is mapped */
+    };
+
+    /** Construct hugepage_allocator
+     *
+     * \param numa_node numa node, to which the memory is bound, or -1 to use the default memory policy
+     * \param flags combination of explicit_hugepages, transparent_hugepages and prefault
+     * */
+    explicit hugepage_allocator(int numa_node = -1, unsigned int flags = transparent_hugepages):
+        arena_(new detail::hugepage_arena(numa_node, flags))
+    {}
+
+    template <typename U>
+    hugepage_allocator(hugepage_allocator<U> const & rhs):
+        arena_(rhs.arena_)
+    {}
+
+    /** Allocate storage for n objects
+     *
+     * \throws std::bad_alloc, if no memory can be mapped
+     * \throws boost::system::system_error, if the memory cannot be bound to the numa node
+     * */
+    pointer allocate(size_type n, const void * = 0)
+    {
+        BOOST_STATIC_ASSERT(boost::alignment_of<T>::value <= BOOST_LOCKFREE_CACHELINE_BYTES);
+        return static_cast<pointer>(arena_->allocate(n * sizeof(T)));
+    }
+
+    void deallocate(pointer p, size_type n)
+    {
+        arena_->deallocate(p, n * sizeof(T));
+    }
+
+    size_type max_size(void) const
+    {
+        return size_type(-1) / sizeof(T);
+    }
+
+    void construct(pointer p, const_reference t)
+    {
+        new (p) T(t);
+    }
+
+    void destroy(pointer p)
+    {
+        p->~T();
+    }
+
+    pointer address(reference r) const
+    {
+        return &r;
+    }
+
+    const_pointer address(const_reference r) const
+    {
+        return &r;
+    }
+
+    template <typename U>
+    bool operator==(hugepage_allocator<U> const & rhs) const
+    {
+        return arena_ == rhs.arena_;
+    }
+
+    template <typename U>
+    bool operator!=(hugepage_allocator<U> const & rhs) const
+    {
+        return arena_ != rhs.arena_;
+    }
+
+private:
+#ifndef BOOST_DOXYGEN_INVOKED
+    template <typename U>
+    friend class hugepage_allocator;
+
+    boost::shared_ptr<detail::hugepage_arena> arena_;
+#endif
+};
+
+} /* namespace lockfree */
+} /* namespace boost */
+
+#endif /* BOOST_LOCKFREE_HUGEPAGE_ALLOCATOR_HPP_INCLUDED */
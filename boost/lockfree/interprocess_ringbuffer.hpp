@@ -0,0 +1,353 @@
+//  lock-free single-producer/single-consumer ringbuffer in shared memory
+//
+//  Copyright (C) 2026 Tim Blechmann
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  Disclaimer: Not a Boost library.
+
+#ifndef BOOST_LOCKFREE_INTERPROCESS_RINGBUFFER_HPP_INCLUDED
+#define BOOST_LOCKFREE_INTERPROCESS_RINGBUFFER_HPP_INCLUDED
+
+#include <boost/cstdint.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/system/system_error.hpp>
+#include <boost/throw_exception.hpp>
+#include <boost/type_traits/has_trivial_copy.hpp>
+#include <boost/type_traits/has_trivial_destructor.hpp>
+
+#include <boost/lockfree/detail/atomic.hpp>
+#include <boost/lockfree/detail/prefix.hpp>
+#include <boost/lockfree/ringbuffer.hpp>
+
+#include <cerrno>
+#include <cstddef>              /* for std::size_t */
+#include <new>                  /* for placement new */
+#include <stdexcept>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace boost {
+namespace lockfree {
+
+//! tag type to create a new shared memory segment
+struct create_only_t {};
+
+//! tag type to attach to an existing shared memory segment
+struct open_only_t {};
+
+static const create_only_t create_only = create_only_t();
+static const open_only_t open_only = open_only_t();
+
+namespace detail {
+
+/* the segment starts with a header, which identifies its layout. it is followed by the indices (each on its own cache
+ * line) and the buffer */
+struct interprocess_ringbuffer_header
+{
+    static const boost::uint32_t magic_number = 0x4c465242; /* "LFRB" */
+    static const boost::uint32_t layout_version = 1;
+
+    atomic<boost::uint32_t> magic;      /* written last by the creator */
+    boost::uint32_t version;
+    boost::uint64_t max_size;
+    boost::uint64_t element_size;
+    boost::uint64_t buffer_offset;
+};
+
+template <typename T>
+struct interprocess_ringbuffer_indices:
+    ringbuffer_base<T>
+{
+    using ringbuffer_base<T>::enqueue;
+    using ringbuffer_base<T>::dequeue;
+    using ringbuffer_base<T>::prepare_write;
+    using ringbuffer_base<T>::commit_write;
+    using ringbuffer_base<T>::prepare_read;
+    using ringbuffer_base<T>::commit_read;
+};
+
+} /* namespace detail */
+
+/** The interprocess_ringbuffer class provides a single-writer/single-reader fifo queue between two processes, pushing
+ *  and popping is wait-free.
+ *
+ *  The indices and the buffer live in a POSIX shared memory object or a memory-mapped file. The segment starts with a
+ *  versioned header, which stores the capacity and the element size, so that a process can only attach to a segment
+ *  with a compatible layout. The indices use the same protocol and the same cache-line padding as
+ *  boost::lockfree::ringbuffer.
+ *
+ *  One process creates the segment, afterwards another process attaches to it. One of them acts as producer, the other
+ *  one as consumer.
+ *
+ *  \b Limitation: The class T is required to be trivially copyable and trivially destructible and must not contain
+ *                 pointers into the address space of either process.
+ *
+ * */
+template <typename T>
+class interprocess_ringbuffer:
+    boost::noncopyable
+{
+#ifndef BOOST_DOXYGEN_INVOKED
+    BOOST_STATIC_ASSERT(boost::has_trivial_copy<T>::value);
+    BOOST_STATIC_ASSERT(boost::has_trivial_destructor<T>::value);
+
+    typedef std::size_t size_t;
+    typedef detail::interprocess_ringbuffer_header header;
+    typedef detail::interprocess_ringbuffer_indices<T> indices;
+
+    static const size_t indices_offset = BOOST_LOCKFREE_CACHELINE_BYTES;
+
+    BOOST_STATIC_ASSERT(sizeof(header) <= indices_offset);
+
+    static size_t buffer_offset(void)
+    {
+        const size_t end = indices_offset + sizeof(indices);
+        return (end + BOOST_LOCKFREE_CACHELINE_BYTES - 1) / BOOST_LOCKFREE_CACHELINE_BYTES * BOOST_LOCKFREE_CACHELINE_BYTES;
+    }
+
+    static void throw_system_error(int error, const char * what)
+    {
+        boost::throw_exception(boost::system::system_error(error, boost::system::system_category(), what));
+    }
+
+    static void throw_incompatible(const char * what)
+    {
+        boost::throw_exception(std::runtime_error(std::string("interprocess_ringbuffer: ") + what));
+    }
+
+    static int open_shm(const char * name, int flags)
+    {
+        int fd = ::shm_open(name, flags, 0600);
+        if (fd == -1)
+            throw_system_error(errno, "shm_open");
+        return fd;
+    }
+
+    void map(int fd, size_t length)
+    {
+        void * segment = ::mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (segment == MAP_FAILED)
+            throw_system_error(errno, "mmap");
+
+        segment_ = static_cast<char*>(segment);
+        length_ = length;
+    }
+
+    void create(int fd, size_t max_size)
+    {
+        if (max_size < 2)
+            throw_incompatible("max_size must be at least 2");
+
+        const size_t length = buffer_offset() + max_size * sizeof(T);
+        if (::ftruncate(fd, length) == -1)
+            throw_system_error(errno, "ftruncate");
+
+        map(fd, length);
+
+        header * h = new (segment_) header;
+        h->version = header::layout_version;
+        h->max_size = max_size;
+        h->element_size = sizeof(T);
+        h->buffer_offset = buffer_offset();
+        new (segment_ + indices_offset) indices();
+
+        initialize(max_size);
+
+        /* publish the segment */
+        h->magic.store(header::magic_number, memory_order_release);
+    }
+
+    void open(int fd)
+    {
+        struct stat status;
+        if (::fstat(fd, &status) == -1)
+            throw_system_error(errno, "fstat");
+
+        const size_t length = status.st_size;
+        if (length < buffer_offset())
+            throw_incompatible("segment is not initialized");
+
+        map(fd, length);
+
+        header * h = reinterpret_cast<header*>(segment_);
+        const char * error = NULL;
+        if (h->magic.load(memory_order_acquire) != header::magic_number)
+            error = "segment is not initialized";
+        else if (h->version != header::layout_version)
+            error = "incompatible layout version";
+        else if (h->element_size != sizeof(T))
+            error = "incompatible element size";
+        else if (h->buffer_offset != buffer_offset() || h->max_size < 2 ||
+                 length < h->buffer_offset + h->max_size * sizeof(T))
+            error = "corrupted header";
+
+        if (error) {
+            ::munmap(segment_, length_);
+            throw_incompatible(error);
+        }
+
+        initialize(h->max_size);
+    }
+
+    void initialize(size_t max_size)
+    {
+        max_size_ = max_size;
+        indices_ = reinterpret_cast<indices*>(segment_ + indices_offset);
+        buffer_ = reinterpret_cast<T*>(segment_ + buffer_offset());
+    }
+#endif
+
+public:
+    /** Creates the POSIX shared memory object name and constructs a ringbuffer for max_size - 1 elements in it.
+     *
+     * \throws boost::system::system_error, if the shared memory object exists or cannot be created
+     * */
+    interprocess_ringbuffer(create_only_t, const char * name, size_t max_size)
+    {
+        int fd = open_shm(name, O_RDWR | O_CREAT | O_EXCL);
+        try {
+            create(fd, max_size);
+        } catch (...) {
+            ::close(fd);
+            ::shm_unlink(name);
+            throw;
+        }
+        ::close(fd);
+    }
+
+    /** Attaches to the ringbuffer in the POSIX shared memory object name.
+     *
+     * \throws boost::system::system_error, if the shared memory object cannot be opened
+     * \throws std::runtime_error, if the segment has not been initialized or has an incompatible layout
+     * */
+    interprocess_ringbuffer(open_only_t, const char * name)
+    {
+        int fd = open_shm(name, O_RDWR);
+        try {
+            open(fd);
+        } catch (...) {
+            ::close(fd);
+            throw;
+        }
+        ::close(fd);
+    }
+
+    /** Constructs a ringbuffer for max_size - 1 elements in the file, which is referred to by fd. The file is resized
+     *  and fd can be closed after construction.
+     *
+     * \throws boost::system::system_error, if the file cannot be resized or mapped
+     * */
+    interprocess_ringbuffer(create_only_t, int fd, size_t max_size)
+    {
+        create(fd, max_size);
+    }
+
+    /** Attaches to the ringbuffer in the file, which is referred to by fd. fd can be closed after construction.
+     *
+     * \throws boost::system::system_error, if the file cannot be mapped
+     * \throws std::runtime_error, if the segment has not been initialized or has an incompatible layout
+     * */
+    interprocess_ringbuffer(open_only_t, int fd)
+    {
+        open(fd);
+    }
+
+    //! Unmaps the segment. The shared memory object or file is not removed.
+    ~interprocess_ringbuffer(void)
+    {
+        ::munmap(segment_, length_);
+    }
+
+    //! Removes the POSIX shared memory object name. Attached processes keep their mapping.
+    static bool remove(const char * name)
+    {
+        return ::shm_unlink(name) == 0;
+    }
+
+    //! \copydoc boost::lockfree::stack::is_lock_free
+    bool is_lock_free(void) const
+    {
+        return indices_->is_lock_free();
+    }
+
+    /** Check if the ringbuffer is empty
+     *
+     * \warning Not thread-safe, use for debugging purposes only
+     * */
+    bool empty(void)
+    {
+        return indices_->empty();
+    }
+
+    /** Enqueues object t to the ringbuffer. Enqueueing may fail, if the ringbuffer is full.
+     *
+     * \return true, if the enqueue operation is successful.
+     *
+     * \note Only to be called from the producer. Wait-free
+     * */
+    bool enqueue(T const & t)
+    {
+        return indices_->enqueue(t, buffer_, max_size_);
+    }
+
+    /** Enqueues size objects from the array t to the ringbuffer.
+     *
+     *  Will enqueue as many objects as there is space available
+     *
+     * \Returns number of enqueued items
+     *
+     * \note Only to be called from the producer. Wait-free
+     */
+    size_t enqueue(T const * t, size_t size)
+    {
+        return indices_->enqueue(t, size, buffer_, max_size_);
+    }
+
+    /** Dequeue object from ringbuffer.
+     *
+     * If dequeue operation is successful, object is written to memory location denoted by ret.
+     *
+     * \return true, if the dequeue operation is successful, false if ringbuffer was empty.
+     *
+     * \note Only to be called from the consumer. Wait-free
+     */
+    bool dequeue(T & ret)
+    {
+        return indices_->dequeue(ret, buffer_, max_size_);
+    }
+
+    /** Dequeue a maximum of size objects from ringbuffer.
+     *
+     * If dequeue operation is successful, object is written to memory location denoted by ret.
+     *
+     * \return number of dequeued items
+     *
+     * \note Only to be called from the consumer. Wait-free
+     * */
+    size_t dequeue(T * ret, size_t size)
+    {
+        return indices_->dequeue(ret, size, buffer_, max_size_);
+    }
+
+private:
+#ifndef BOOST_DOXYGEN_INVOKED
+    char * segment_;
+    size_t length_;
+    size_t max_size_;
+    indices * indices_;
+    T * buffer_;
+#endif
+};
+
+} /* namespace lockfree */
+} /* namespace boost */
+
+#endif /* BOOST_LOCKFREE_INTERPROCESS_RINGBUFFER_HPP_INCLUDED */
@@ -0,0 +1,342 @@
+//  lock-free single-producer/single-consumer ringbuffer with virtual memory mirroring
+//
+//  Copyright (C) 2026 Tim Blechmann
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  Disclaimer: Not a Boost library.
+
+#ifndef BOOST_LOCKFREE_MIRRORED_RINGBUFFER_HPP_INCLUDED
+#define BOOST_LOCKFREE_MIRRORED_RINGBUFFER_HPP_INCLUDED
+
+#ifndef __linux__
+#error "boost/lockfree/mirrored_ringbuffer.hpp requires linux"
+#endif
+
+#include <boost/static_assert.hpp>
+#include <boost/system/system_error.hpp>
+#include <boost/throw_exception.hpp>
+#include <boost/type_traits/has_trivial_copy.hpp>
+#include <boost/type_traits/has_trivial_destructor.hpp>
+
+#include <boost/lockfree/ringbuffer.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>              /* for std::memcpy */
+#include <iterator>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace boost {
+namespace lockfree {
+
+/** The mirrored_ringbuffer class provides a single-writer/single-reader fifo queue, pushing and popping is wait-free.
+ *
+ *  The physical pages of the buffer are mapped twice, back to back, so that the slot max_size + i aliases the slot i.
+ *  Therefore every readable or writable region of the buffer is contiguous in memory: bulk operations are performed
+ *  with a single memcpy and write_span()/read_span() provide zero-copy access to the buffer, which is never split at
+ *  the wrap-around point.
+ *
+ *  The buffer size is rounded up, so that it is a multiple of the page size.
+ *
+ *  \b Limitation: The class T is required to be trivially copyable and trivially destructible.
+ *
+ * */
+template <typename T>
+class mirrored_ringbuffer:
+    public detail::ringbuffer_base<T>
+{
+#ifndef BOOST_DOXYGEN_INVOKED
+    BOOST_STATIC_ASSERT(boost::has_trivial_copy<T>::value);
+    BOOST_STATIC_ASSERT(boost::has_trivial_destructor<T>::value);
+
+    typedef std::size_t size_t;
+    typedef detail::ringbuffer_base<T> base_type;
+
+    static size_t gcd(size_t a, size_t b)
+    {
+        while (b) {
+            size_t r = a % b;
+            a = b;
+            b = r;
+        }
+        return a;
+    }
+
+    static size_t buffer_bytes(size_t max_size)
+    {
+        const size_t page_size = ::sysconf(_SC_PAGESIZE);
+        const size_t granularity = page_size / gcd(page_size, sizeof(T)) * sizeof(T);
+        const size_t bytes = max_size * sizeof(T);
+        return (bytes + granularity - 1) / granularity * granularity;
+    }
+
+    static void throw_system_error(const char * what)
+    {
+        boost::throw_exception(boost::system::system_error(errno, boost::system::system_category(), what));
+    }
+
+    void map(void)
+    {
+        int fd = ::memfd_create("boost_lockfree_mirrored_ringbuffer", MFD_CLOEXEC);
+        if (fd == -1)
+            throw_system_error("memfd_create");
+
+        if (::ftruncate(fd, bytes_) == -1) {
+            int error = errno;
+            ::close(fd);
+            errno = error;
+            throw_system_error("ftruncate");
+        }
+
+        /* reserve address space for both mappings, then map the file into both halves */
+        void * reserved = ::mmap(NULL, 2 * bytes_, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (reserved == MAP_FAILED) {
+            int error = errno;
+            ::close(fd);
+            errno = error;
+            throw_system_error("mmap");
+        }
+
+        char * base = static_cast<char*>(reserved);
+        for (int i = 0; i != 2; ++i) {
+            void * half = ::mmap(base + i * bytes_, bytes_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+            if (half == MAP_FAILED) {
+                int error = errno;
+                ::munmap(reserved, 2 * bytes_);
+                ::close(fd);
+                errno = error;
+                throw_system_error("mmap");
+            }
+        }
+
+        /* the mappings keep the file alive */
+        ::close(fd);
+        buffer_ = reinterpret_cast<T*>(base);
+    }
+#endif
+
+public:
+    /** Constructs a mirrored ringbuffer for at least max_size - 1 elements
+     *
+     * \throws boost::system::system_error, if the buffer cannot be mapped
+     * */
+    explicit mirrored_ringbuffer(size_t max_size):
+        bytes_(buffer_bytes(max_size)), max_size_(bytes_ / sizeof(T))
+    {
+        map();
+    }
+
+    ~mirrored_ringbuffer(void)
+    {
+        ::munmap(buffer_, 2 * bytes_);
+    }
+
+    //! \returns number of slots of the buffer. Up to capacity() - 1 elements can be stored.
+    size_t capacity(void) const
+    {
+        return max_size_;
+    }
+
+    /** reset the ringbuffer
+     *
+     * \warning Not thread-safe, use for debugging purposes only
+     * */
+    void reset(void)
+    {
+        base_type::reset(buffer_, max_size_);
+    }
+
+    /** Enqueues object t to the ringbuffer. Enqueueing may fail, if the ringbuffer is full.
+     *
+     * \return true, if the enqueue operation is successful.
+     *
+     * \note Thread-safe and non-blocking
+     * */
+    bool enqueue(T const & t)
+    {
+        return base_type::enqueue(t, buffer_, max_size_);
+    }
+
+    /** Dequeue object from ringbuffer.
+     *
+     * If dequeue operation is successful, object is written to memory location denoted by ret.
+     *
+     * \return true, if the dequeue operation is successful, false if ringbuffer was empty.
+     *
+     * \note Thread-safe and non-blocking
+     */
+    bool dequeue(T & ret)
+    {
+        return base_type::dequeue(ret, buffer_, max_size_);
+    }
+
+    /** Enqueues size objects from the array t to the ringbuffer with a single memcpy.
+     *
+     *  Will enqueue as many objects as there is space available
+     *
+     * \Returns number of enqueued items
+     *
+     * \note Thread-safe and non-blocking
+     */
+    size_t enqueue(T const * t, size_t size)
+    {
+        size_t write_index;
+        size_t count = (std::min)(size, base_type::prepare_write(write_index, max_size_));
+        std::memcpy(buffer_ + write_index, t, count * sizeof(T));
+        base_type::commit_write(count, max_size_);
+        return count;
+    }
+
+    /** Enqueues all objects from the array t to the ringbuffer.
+     *
+     *  Will enqueue as many objects as there is space available
+     *
+     * \Returns number of enqueued items
+     *
+     * \note Thread-safe and non-blocking
+     */
+    template <size_t size>
+    size_t enqueue(T const (&t)[size])
+    {
+        return enqueue(t, size);
+    }
+
+    /** Enqueues size objects from the iterator range [begin, end[ to the ringbuffer.
+     *
+     *  Enqueueing may fail, if the ringbuffer is full.
+     *
+     * \return iterator to the first element, which has not been enqueued
+     *
+     * \note Thread-safe and non-blocking
+     */
+    template <typename ConstIterator>
+    ConstIterator enqueue(ConstIterator begin, ConstIterator end)
+    {
+        size_t write_index;
+        const size_t avail = base_type::prepare_write(write_index, max_size_);
+        size_t count = (std::min)(size_t(std::distance(begin, end)), avail);
+
+        ConstIterator last = begin;
+        std::advance(last, count);
+        std::copy(begin, last, buffer_ + write_index);
+        base_type::commit_write(count, max_size_);
+        return last;
+    }
+
+    /** Dequeue a maximum of size objects from ringbuffer with a single memcpy.
+     *
+     * If dequeue operation is successful, object is written to memory location denoted by ret.
+     *
+     * \return number of dequeued items
+     *
+     * \note Thread-safe and non-blocking
+     * */
+    size_t dequeue(T * ret, size_t size)
+    {
+        size_t read_index;
+        size_t count = (std::min)(size, base_type::prepare_read(read_index, max_size_));
+        std::memcpy(ret, buffer_ + read_index, count * sizeof(T));
+        base_type::commit_read(count, max_size_);
+        return count;
+    }
+
+    /** Dequeue objects from ringbuffer.
+     *
+     * If dequeue operation is successful, object is written to memory location denoted by ret.
+     *
+     * \return number of dequeued items
+     *
+     * \note Thread-safe and non-blocking
+     * */
+    template <size_t size>
+    size_t dequeue(T (&t)[size])
+    {
+        return dequeue(t, size);
+    }
+
+    /** Dequeue objects to the output iterator it
+     *
+     * \return number of dequeued items
+     *
+     * \note Thread-safe and non-blocking
+     * */
+    template <typename OutputIterator>
+    size_t dequeue(OutputIterator it)
+    {
+        size_t read_index;
+        const size_t count = base_type::prepare_read(read_index, max_size_);
+        std::copy(buffer_ + read_index, buffer_ + read_index + count, it);
+        base_type::commit_read(count, max_size_);
+        return count;
+    }
+
+    /** Provides direct access to the free space of the ringbuffer.
+     *
+     *  The region [ret, ret + size[ is contiguous and can be filled in place. The objects are enqueued by calling
+     *  commit_write().
+     *
+     * \param size is set to the number of objects, which can be written
+     * \return pointer to the first writable slot
+     *
+     * \note Only to be called from the producer thread. Wait-free
+     * */
+    T * write_span(size_t & size)
+    {
+        size_t write_index;
+        size = base_type::prepare_write(write_index, max_size_);
+        return buffer_ + write_index;
+    }
+
+    /** Enqueues the first count objects of the region, which has been returned by write_span()
+     *
+     * \pre count must not exceed the size returned by write_span()
+     * \note Only to be called from the producer thread. Wait-free
+     * */
+    void commit_write(size_t count)
+    {
+        base_type::commit_write(count, max_size_);
+    }
+
+    /** Provides direct access to the objects of the ringbuffer.
+     *
+     *  The region [ret, ret + size[ is contiguous. The objects are dequeued by calling commit_read().
+     *
+     * \param size is set to the number of objects, which can be read
+     * \return pointer to the first object
+     *
+     * \note Only to be called from the consumer thread. Wait-free
+     * */
+    T const * read_span(size_t & size)
+    {
+        size_t read_index;
+        size = base_type::prepare_read(read_index, max_size_);
+        return buffer_ + read_index;
+    }
+
+    /** Dequeues the first count objects of the region, which has been returned by read_span()
+     *
+     * \pre count must not exceed the size returned by read_span()
+     * \note Only to be called from the consumer thread. Wait-free
+     * */
+    void commit_read(size_t count)
+    {
+        base_type::commit_read(count, max_size_);
+    }
+
+private:
+#ifndef BOOST_DOXYGEN_INVOKED
+    const size_t bytes_;
+    const size_t max_size_;
+    T * buffer_;
+#endif
+};
+
+} /* namespace lockfree */
+} /* namespace boost */
+
+#endif /* BOOST_LOCKFREE_MIRRORED_RINGBUFFER_HPP_INCLUDED */
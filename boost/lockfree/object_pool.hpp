@@ -0,0 +1,430 @@
+//  lock-free object pool
+//
+//  Copyright (C) 2026 Tim Blechmann
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  Disclaimer: Not a Boost library.
+
+#ifndef BOOST_LOCKFREE_OBJECT_POOL_HPP_INCLUDED
+#define BOOST_LOCKFREE_OBJECT_POOL_HPP_INCLUDED
+
+#include <boost/assert.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/mpl/if.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <boost/lockfree/detail/freelist.hpp>
+#include <boost/lockfree/detail/prefix.hpp>
+#include <boost/lockfree/detail/thread_index.hpp>
+
+#include <cstddef>              /* for std::size_t */
+#include <memory>               /* for std::allocator */
+#include <new>
+
+#ifndef BOOST_LOCKFREE_THREAD_LOCAL
+#error "boost/lockfree/object_pool.hpp requires thread-local storage"
+#endif
+
+namespace boost {
+namespace lockfree {
+
+/** The object_pool class provides a pool of objects of type T, allocating and deallocating is lockfree.
+ *
+ *  The objects are kept in a boost::lockfree::detail::freelist_stack, the capacity policy is selected via the
+ *  freelist_t template argument: with a caching_freelist_t, the pool grows by allocating from Alloc, when it is
+ *  exhausted, with a static_freelist_t, the capacity is fixed to the number of objects, which have been reserved, and
+ *  construct() fails, when the pool is exhausted. Memory is only returned to Alloc, when the pool is destroyed.
+ *
+ *  Optionally, the pool keeps caches of up to cache_size objects, which are selected by the index of the calling
+ *  thread modulo the number of caches. A thread claims its cache with a single atomic exchange on a word in the cache
+ *  line of the cache, allocates from it and only accesses the shared freelist, if the cache is empty or claimed by
+ *  another thread. When a cache overflows, half of it is returned to the shared freelist. As the caches are not
+ *  owned by threads, objects, which have been cached by a thread, which has exited, are reused by the next thread with
+ *  the same cache. When the shared freelist is exhausted, allocate() takes the objects from the other caches.
+ *
+ *  The _unsafe member functions bypass the per-thread caches and access the shared freelist without atomic
+ *  read-modify-write operations, they must not be called concurrently with any other member function.
+ *
+ *  \b Limitation: Objects, which have not been destructed, are leaked, when the pool is destroyed.
+ * */
+template <typename T,
+          typename freelist_t = caching_freelist_t,
+          typename Alloc = std::allocator<T>
+         >
+class object_pool:
+    boost::noncopyable
+{
+#ifndef BOOST_DOXYGEN_INVOKED
+    typedef std::size_t size_t;
+
+    /* the freelist stores its links in the memory of the objects, so every node is large enough for a link */
+    enum {
+        node_size = sizeof(T) > sizeof(detail::freelist_node) ? sizeof(T) : sizeof(detail::freelist_node),
+        node_alignment = boost::alignment_of<T>::value > boost::alignment_of<detail::freelist_node>::value
+                             ? boost::alignment_of<T>::value : boost::alignment_of<detail::freelist_node>::value
+    };
+
+    struct node
+    {
+        typename boost::aligned_storage<node_size, node_alignment>::type object;
+    };
+
+    typedef typename detail::rebind_allocator<Alloc, node>::type node_allocator;
+
+    typedef typename boost::mpl::if_<boost::is_same<freelist_t, caching_freelist_t>,
+                                     detail::freelist_stack<node, true, node_allocator>,
+                                     detail::freelist_stack<node, false, node_allocator>
+                                     >::type pool_t;
+
+    /* adjacent caches do not share a cache line. count and objects are only accessed by the thread, which has set
+     * owner from 0 to 1 */
+    struct thread_cache
+    {
+        thread_cache(void):
+            owner(0), count(0), objects(NULL)
+        {}
+
+        atomic<size_t> owner;
+        size_t count;
+        node ** objects;
+        char padding[BOOST_LOCKFREE_CACHELINE_BYTES - 2 * sizeof(size_t) - sizeof(node **)];
+    };
+
+    typedef typename detail::rebind_allocator<Alloc, thread_cache>::type cache_allocator;
+    typedef typename detail::rebind_allocator<Alloc, node*>::type slot_allocator;
+
+    void initialize(void)
+    {
+        for (size_t i = 0; i != cache_count_; ++i) {
+            new(caches_ + i) thread_cache();
+            caches_[i].objects = slot_alloc_.allocate(cache_size_);
+        }
+    }
+
+    thread_cache * try_claim(size_t index) const
+    {
+        thread_cache * cache = caches_ + index;
+        if (cache->owner.load(memory_order_relaxed) || cache->owner.exchange(1, memory_order_acquire))
+            return NULL;
+        return cache;
+    }
+
+    static void release(thread_cache * cache)
+    {
+        cache->owner.store(0, memory_order_release);
+    }
+
+    /* claims the cache of the calling thread, returns NULL, if there are no caches or if it is claimed by another
+     * thread */
+    thread_cache * claim_local_cache(void) const
+    {
+        if (cache_count_ == 0)
+            return NULL;
+        return try_claim(detail::thread_index() % cache_count_);
+    }
+
+    /* takes an object from any cache, only called when the shared freelist is exhausted. the caches are scanned
+     * again, while one of them is claimed by another thread, which may be about to return an object */
+    node * allocate_from_caches(void)
+    {
+        for (;;) {
+            bool busy = false;
+            for (size_t i = 0; i != cache_count_; ++i) {
+                thread_cache * cache = try_claim(i);
+                if (!cache) {
+                    busy = true;
+                    continue;
+                }
+
+                node * n = cache->count ? cache->objects[--cache->count] : NULL;
+                release(cache);
+                if (n)
+                    return n;
+            }
+
+            if (!busy)
+                return NULL;
+
+            node * n = pool_.allocate();
+            if (n)
+                return n;
+        }
+    }
+
+    static T * object(node * n)
+    {
+        return reinterpret_cast<T*>(&n->object);
+    }
+
+    static node * to_node(T * t)
+    {
+        return reinterpret_cast<node*>(t);
+    }
+#endif
+
+public:
+    typedef T value_type;
+
+    /** Construct object_pool, allocate n objects for the freelist.
+     *
+     *  If thread_caches is not zero, the pool keeps thread_caches caches of cache_size objects, which are shared by
+     *  the threads via the thread index.
+     * */
+    explicit object_pool(size_t n = 0, size_t thread_caches = 0, size_t cache_size = 32):
+        pool_(node_allocator(), n), cache_count_(thread_caches), cache_size_(cache_size),
+        caches_(cache_alloc_.allocate(thread_caches))
+    {
+        initialize();
+    }
+
+    //! Construct object_pool, allocate n objects and the per-thread caches from alloc
+    object_pool(size_t n, size_t thread_caches, size_t cache_size, Alloc const & alloc):
+        pool_(node_allocator(alloc), n), cache_alloc_(alloc), slot_alloc_(alloc), cache_count_(thread_caches),
+        cache_size_(cache_size), caches_(cache_alloc_.allocate(thread_caches))
+    {
+        initialize();
+    }
+
+    /** Destroys the object_pool, the memory of all cached and pooled objects is returned to the allocator.
+     *
+     *  \pre all objects, which have been allocated from the pool, have been deallocated.
+     *  \note not thread-safe
+     * */
+    ~object_pool(void)
+    {
+        for (size_t i = 0; i != cache_count_; ++i) {
+            thread_cache & cache = caches_[i];
+            for (size_t j = 0; j != cache.count; ++j)
+                pool_.deallocate_unsafe(cache.objects[j]);
+            slot_alloc_.deallocate(cache.objects, cache_size_);
+            cache.~thread_cache();
+        }
+        cache_alloc_.deallocate(caches_, cache_count_);
+    }
+
+    //! \copydoc boost::lockfree::stack::is_lock_free
+    bool is_lock_free(void) const
+    {
+        return pool_.is_lock_free();
+    }
+
+    /** Allocates n objects for the shared freelist.
+     *
+     * \note thread-safe, may block if memory allocator blocks
+     * */
+    void reserve(size_t n)
+    {
+        pool_.reserve(n);
+    }
+
+    /** Allocates n objects for the shared freelist.
+     *
+     * \note not thread-safe, may block if memory allocator blocks
+     * */
+    void reserve_unsafe(size_t n)
+    {
+        pool_.reserve_unsafe(n);
+    }
+
+    /** Allocates uninitialized memory for an object.
+     *
+     * \returns pointer to the memory, or NULL, if the pool is exhausted.
+     *
+     * \note Thread-safe and non-blocking
+     * \warning \b Warning: May block if memory needs to be allocated from the operating system. When the shared
+     *                      freelist is exhausted, it may spin while another thread accesses one of the caches
+     * */
+    T * allocate(void)
+    {
+        thread_cache * cache = claim_local_cache();
+        if (cache) {
+            node * n = cache->count ? cache->objects[--cache->count] : NULL;
+            release(cache);
+            if (n)
+                return object(n);
+        }
+
+        node * n = pool_.allocate();
+        if (!n && cache_count_)
+            n = allocate_from_caches();
+        return n ? object(n) : NULL;
+    }
+
+    /** Allocates uninitialized memory for an object.
+     *
+     * \returns pointer to the memory, or NULL, if the pool is exhausted.
+     *
+     * \note Not thread-safe
+     * \warning \b Warning: May block if memory needs to be allocated from the operating system
+     * */
+    T * allocate_unsafe(void)
+    {
+        node * n = pool_.allocate_unsafe();
+        return n ? object(n) : NULL;
+    }
+
+    /** Returns the memory of an object to the pool, without destructing it.
+     *
+     * \pre t has been allocated from this pool
+     * \note Thread-safe and non-blocking
+     * */
+    void deallocate(T * t)
+    {
+        thread_cache * cache = claim_local_cache();
+        if (cache) {
+            if (unlikely(cache->count == cache_size_)) {
+                /* return the older half to the shared freelist */
+                const size_t half = cache_size_ / 2;
+                for (size_t i = 0; i != half; ++i)
+                    pool_.deallocate(cache->objects[i]);
+                for (size_t i = half; i != cache_size_; ++i)
+                    cache->objects[i - half] = cache->objects[i];
+                cache->count -= half;
+            }
+
+            const bool cached = cache->count != cache_size_;
+            if (cached)
+                cache->objects[cache->count++] = to_node(t);
+            release(cache);
+            if (cached)
+                return;
+        }
+        pool_.deallocate(to_node(t));
+    }
+
+    /** Returns the memory of an object to the pool, without destructing it.
+     *
+     * \pre t has been allocated from this pool
+     * \note Not thread-safe
+     * */
+    void deallocate_unsafe(T * t)
+    {
+        pool_.deallocate_unsafe(to_node(t));
+    }
+
+#if !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES) && !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+    /** Allocates and constructs an object from args.
+     *
+     * \returns pointer to the object, or NULL, if the pool is exhausted.
+     *
+     * \note Thread-safe and non-blocking, if the constructor of T is non-blocking
+     * \warning \b Warning: May block if memory needs to be allocated from the operating system
+     * */
+    template <typename... ArgumentTypes>
+    T * construct(ArgumentTypes &&... args)
+    {
+        T * t = allocate();
+        if (t)
+            new(t) T(std::forward<ArgumentTypes>(args)...);
+        return t;
+    }
+
+    /** Allocates and constructs an object from args.
+     *
+     * \returns pointer to the object, or NULL, if the pool is exhausted.
+     *
+     * \note Not thread-safe
+     * \warning \b Warning: May block if memory needs to be allocated from the operating system
+     * */
+    template <typename... ArgumentTypes>
+    T * construct_unsafe(ArgumentTypes &&... args)
+    {
+        T * t = allocate_unsafe();
+        if (t)
+            new(t) T(std::forward<ArgumentTypes>(args)...);
+        return t;
+    }
+#else
+    /** Allocates and default-constructs an object.
+     *
+     * \returns pointer to the object, or NULL, if the pool is exhausted.
+     *
+     * \note Thread-safe and non-blocking, if the constructor of T is non-blocking
+     * \warning \b Warning: May block if memory needs to be allocated from the operating system
+     * */
+    T * construct(void)
+    {
+        T * t = allocate();
+        if (t)
+            new(t) T();
+        return t;
+    }
+
+    /** Allocates and constructs an object from arg.
+     *
+     * \returns pointer to the object, or NULL, if the pool is exhausted.
+     *
+     * \note Thread-safe and non-blocking, if the constructor of T is non-blocking
+     * \warning \b Warning: May block if memory needs to be allocated from the operating system
+     * */
+    template <typename ArgumentType>
+    T * construct(ArgumentType const & arg)
+    {
+        T * t = allocate();
+        if (t)
+            new(t) T(arg);
+        return t;
+    }
+
+    //! \copydoc boost::lockfree::object_pool::construct(void)
+    T * construct_unsafe(void)
+    {
+        T * t = allocate_unsafe();
+        if (t)
+            new(t) T();
+        return t;
+    }
+
+    //! \copydoc boost::lockfree::object_pool::construct(ArgumentType const &)
+    template <typename ArgumentType>
+    T * construct_unsafe(ArgumentType const & arg)
+    {
+        T * t = allocate_unsafe();
+        if (t)
+            new(t) T(arg);
+        return t;
+    }
+#endif
+
+    /** Destructs the object t and returns its memory to the pool.
+     *
+     * \pre t has been allocated from this pool
+     * \note Thread-safe and non-blocking, if the destructor of T is non-blocking
+     * */
+    void destruct(T * t)
+    {
+        t->~T();
+        deallocate(t);
+    }
+
+    /** Destructs the object t and returns its memory to the pool.
+     *
+     * \pre t has been allocated from this pool
+     * \note Not thread-safe
+     * */
+    void destruct_unsafe(T * t)
+    {
+        t->~T();
+        deallocate_unsafe(t);
+    }
+
+private:
+#ifndef BOOST_DOXYGEN_INVOKED
+    pool_t pool_;
+    cache_allocator cache_alloc_;
+    slot_allocator slot_alloc_;
+    const size_t cache_count_;
+    const size_t cache_size_;
+    thread_cache * const caches_;
+#endif
+};
+
+} /* namespace lockfree */
+} /* namespace boost */
+
+#endif /* BOOST_LOCKFREE_OBJECT_POOL_HPP_INCLUDED */
@@ -0,0 +1,197 @@
+//  lock-free single-producer/single-consumer ringbuffer, which overwrites the oldest elements
+//
+//  Copyright (C) 2026 Tim Blechmann
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  Disclaimer: Not a Boost library.
+
+#ifndef BOOST_LOCKFREE_OVERWRITE_RINGBUFFER_HPP_INCLUDED
+#define BOOST_LOCKFREE_OVERWRITE_RINGBUFFER_HPP_INCLUDED
+
+#include <boost/cstdint.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/has_trivial_copy.hpp>
+#include <boost/type_traits/has_trivial_destructor.hpp>
+
+#include <boost/lockfree/detail/atomic.hpp>
+#include <boost/lockfree/detail/branch_hints.hpp>
+#include <boost/lockfree/detail/freelist.hpp>
+#include <boost/lockfree/detail/prefix.hpp>
+
+#include <cstddef>              /* for std::size_t */
+#include <cstring>              /* for std::memcpy */
+#include <memory>               /* for std::allocator */
+#include <new>
+
+namespace boost {
+namespace lockfree {
+
+/** The overwrite_ringbuffer class provides a lossy single-writer/single-reader fifo queue. Enqueueing always succeeds
+ *  by overwriting the oldest elements, if the consumer falls behind, which makes it suitable for telemetry data, where
+ *  the newest samples are the most relevant ones. Pushing is wait-free, popping is lock-free.
+ *
+ *  Each slot carries a sequence number, which is odd while the producer writes to the slot. The consumer validates the
+ *  sequence number before and after copying an element, so it never returns a torn element. If the consumer has been
+ *  lapped, it skips ahead to the oldest element, which is still available, and accounts the lost elements in
+ *  skipped().
+ *
+ *  \b Limitation: The class T is required to be trivially copyable and trivially destructible.
+ * */
+template <typename T, typename Alloc = std::allocator<T> >
+class overwrite_ringbuffer:
+    boost::noncopyable
+{
+#ifndef BOOST_DOXYGEN_INVOKED
+    BOOST_STATIC_ASSERT(boost::has_trivial_copy<T>::value);
+    BOOST_STATIC_ASSERT(boost::has_trivial_destructor<T>::value);
+
+    typedef std::size_t size_t;
+
+    /* the element at position p is being written, while sequence == 2 * p + 1, and is valid, when
+     * sequence == 2 * p + 2. positions and sequence numbers have 64 bits, so that they do not wrap around on 32 bit
+     * targets */
+    typedef boost::uint64_t position_t;
+
+    struct slot
+    {
+        atomic<position_t> sequence;
+        T data;
+    };
+
+    typedef typename detail::rebind_allocator<Alloc, slot>::type slot_allocator;
+
+    void initialize(void)
+    {
+        for (size_t i = 0; i != max_size_; ++i)
+            new (&slots_[i].sequence) atomic<position_t>(0);
+    }
+#endif
+
+public:
+    typedef T value_type;
+
+    //! Constructs an overwrite_ringbuffer for max_size elements
+    explicit overwrite_ringbuffer(size_t max_size):
+        max_size_(max_size), slots_(alloc_.allocate(max_size)), write_position_(0), read_position_(0), skipped_(0)
+    {
+        initialize();
+    }
+
+    //! Constructs an overwrite_ringbuffer for max_size elements, allocating its storage from alloc
+    overwrite_ringbuffer(size_t max_size, Alloc const & alloc):
+        alloc_(alloc), max_size_(max_size), slots_(alloc_.allocate(max_size)), write_position_(0), read_position_(0),
+        skipped_(0)
+    {
+        initialize();
+    }
+
+    ~overwrite_ringbuffer(void)
+    {
+        alloc_.deallocate(slots_, max_size_);
+    }
+
+    /** Enqueues object t to the ringbuffer, overwriting the oldest element, if the ringbuffer is full.
+     *
+     * \note Only to be called from the producer thread. Wait-free
+     * */
+    void enqueue(T const & t)
+    {
+        const position_t position = write_position_.load(memory_order_relaxed); // only written from enqueue thread
+        slot & s = slots_[position % max_size_];
+
+        /* a consumer, which observes the odd sequence number, also observes write_position_ >= position */
+        s.sequence.store(2 * position + 1, memory_order_release);
+        atomic_thread_fence(memory_order_release);  /* the odd sequence number is visible before the data */
+        std::memcpy(&s.data, &t, sizeof(T));
+        s.sequence.store(2 * position + 2, memory_order_release);
+
+        write_position_.store(position + 1, memory_order_release);
+    }
+
+    /** Dequeue object from ringbuffer.
+     *
+     * If dequeue operation is successful, object is written to memory location denoted by ret. If the producer has
+     * overwritten elements, which have not been dequeued, they are skipped.
+     *
+     * \return true, if the dequeue operation is successful, false if ringbuffer was empty.
+     *
+     * \note Only to be called from the consumer thread. Lock-free
+     * */
+    bool dequeue(T & ret)
+    {
+        for (;;) {
+            const position_t position = read_position_;
+            slot & s = slots_[position % max_size_];
+
+            const position_t sequence = s.sequence.load(memory_order_acquire);
+            if (sequence < 2 * position + 2)
+                return false;   /* not written yet or being written */
+
+            if (likely(sequence == 2 * position + 2)) {
+                std::memcpy(&ret, &s.data, sizeof(T));
+                atomic_thread_fence(memory_order_acquire);  /* the data is read before the sequence is checked */
+                if (likely(s.sequence.load(memory_order_relaxed) == sequence)) {
+                    read_position_ = position + 1;
+                    return true;
+                }
+            }
+
+            /* lapped by the producer: the element at write_position - max_size may be overwritten at any time, so
+             * continue with the next one */
+            const position_t write_position = write_position_.load(memory_order_acquire);
+            position_t oldest = position + 1;
+            if (write_position >= max_size_ && write_position - max_size_ + 1 > oldest)
+                oldest = write_position - max_size_ + 1;
+            skipped_ += size_t(oldest - position);
+            read_position_ = oldest;
+        }
+    }
+
+    /** \returns number of elements, which have been overwritten before they could be dequeued
+     *
+     * \note Only to be called from the consumer thread
+     * */
+    size_t skipped(void) const
+    {
+        return skipped_;
+    }
+
+    /** Check if the ringbuffer is empty
+     *
+     * \warning Not thread-safe, use for debugging purposes only
+     * */
+    bool empty(void)
+    {
+        return write_position_.load(memory_order_relaxed) == read_position_;
+    }
+
+    //! \copydoc boost::lockfree::stack::is_lock_free
+    bool is_lock_free(void) const
+    {
+        return write_position_.is_lock_free();
+    }
+
+private:
+#ifndef BOOST_DOXYGEN_INVOKED
+    slot_allocator alloc_;
+    const size_t max_size_;
+    slot * const slots_;
+
+    char padding1[BOOST_LOCKFREE_CACHELINE_BYTES]; /* force write_position_ to a different cache line */
+    atomic<position_t> write_position_;
+    char padding2[BOOST_LOCKFREE_CACHELINE_BYTES - sizeof(atomic<position_t>)];
+
+    /* only accessed by the consumer */
+    position_t read_position_;
+    size_t skipped_;
+#endif
+};
+
+} /* namespace lockfree */
+} /* namespace boost */
+
+#endif /* BOOST_LOCKFREE_OVERWRITE_RINGBUFFER_HPP_INCLUDED */
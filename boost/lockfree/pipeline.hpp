@@ -0,0 +1,244 @@
+//  lock-free multi-stage pipeline over a shared ringbuffer
+//
+//  Copyright (C) 2026 Tim Blechmann
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  Disclaimer: Not a Boost library.
+
+#ifndef BOOST_LOCKFREE_PIPELINE_HPP_INCLUDED
+#define BOOST_LOCKFREE_PIPELINE_HPP_INCLUDED
+
+#include <boost/assert.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <boost/lockfree/detail/atomic.hpp>
+#include <boost/lockfree/detail/cursor.hpp>
+#include <boost/lockfree/detail/freelist.hpp>
+#include <boost/lockfree/detail/prefix.hpp>
+
+#include <algorithm>
+#include <cstddef>              /* for std::size_t */
+#include <memory>               /* for std::allocator, std::uninitialized_fill_n */
+#include <vector>
+
+namespace boost {
+namespace lockfree {
+
+/** The pipeline class provides a chain (or a directed acyclic graph) of processing stages over one shared ringbuffer.
+ *
+ *  The producer publishes entries, each stage processes the entries in place, after all of its upstream stages have
+ *  processed them. The slots of the ringbuffer are constructed once and reused, so entries are never copied between
+ *  stages. Each stage and the producer own a cursor on a cache line of their own. The producer can only reuse a slot,
+ *  after all stages have processed it.
+ *
+ *  Stages are identified by an index in [0, stages()[. A stage can only depend on stages with smaller indices. Stages
+ *  without dependencies process the entries, which have been published by the producer.
+ *
+ *  \b Requirements: T must be default-constructible and assignable
+ * */
+template <typename T, typename Alloc = std::allocator<T> >
+class pipeline:
+    boost::noncopyable
+{
+#ifndef BOOST_DOXYGEN_INVOKED
+    typedef std::size_t size_t;
+
+    typedef typename detail::rebind_allocator<Alloc, T>::type slot_allocator;
+
+    /* the cursor of the producer is followed by the cursors of the stages */
+    atomic<size_t> & producer_cursor(void) const
+    {
+        return cursors_[0];
+    }
+
+    atomic<size_t> & stage_cursor(size_t stage) const
+    {
+        return cursors_[stage + 1];
+    }
+
+    /* the position, up to which the stage can process entries */
+    size_t barrier(size_t stage) const
+    {
+        std::vector<size_t> const & upstream = dependencies_[stage];
+        if (upstream.empty())
+            return producer_cursor().load(memory_order_acquire);
+
+        size_t ret = stage_cursor(upstream[0]).load(memory_order_acquire);
+        for (size_t i = 1; i != upstream.size(); ++i)
+            ret = (std::min)(ret, stage_cursor(upstream[i]).load(memory_order_acquire));
+        return ret;
+    }
+
+    size_t slowest_stage(void) const
+    {
+        size_t ret = stage_cursor(0).load(memory_order_acquire);
+        for (size_t i = 1; i != stages_; ++i)
+            ret = (std::min)(ret, stage_cursor(i).load(memory_order_acquire));
+        return ret;
+    }
+
+    template <typename Functor>
+    size_t consume_all_impl(size_t stage, Functor f)
+    {
+        atomic<size_t> & stage_position = stage_cursor(stage);
+        const size_t position = stage_position.load(memory_order_relaxed); // only written from this stage
+        const size_t end = barrier(stage);
+
+        for (size_t p = position; p != end; ++p)
+            f(slots_[p % max_size_]);
+
+        stage_position.store(end, memory_order_release);
+        return end - position;
+    }
+#endif
+
+public:
+    typedef T value_type;
+
+    /** Constructs a pipeline with max_size slots and the given number of stages
+     *
+     * \pre stages must be at least 1
+     * */
+    pipeline(size_t max_size, size_t stages):
+        max_size_(max_size), stages_(stages), slots_(alloc_.allocate(max_size)), dependencies_(stages),
+        cursors_(stages + 1, alloc_), gate_(0)
+    {
+        BOOST_ASSERT(stages > 0);
+        std::uninitialized_fill_n(slots_, max_size_, T());
+    }
+
+    //! Constructs a pipeline with max_size slots and the given number of stages, allocating its storage from alloc
+    pipeline(size_t max_size, size_t stages, Alloc const & alloc):
+        alloc_(alloc), max_size_(max_size), stages_(stages), slots_(alloc_.allocate(max_size)), dependencies_(stages),
+        cursors_(stages + 1, alloc_), gate_(0)
+    {
+        BOOST_ASSERT(stages > 0);
+        std::uninitialized_fill_n(slots_, max_size_, T());
+    }
+
+    ~pipeline(void)
+    {
+        for (size_t i = 0; i != max_size_; ++i)
+            slots_[i].~T();
+
+        alloc_.deallocate(slots_, max_size_);
+    }
+
+    //! \returns number of stages
+    size_t stages(void) const
+    {
+        return stages_;
+    }
+
+    /** Declares, that stage processes entries only after upstream has processed them
+     *
+     * \pre upstream < stage
+     * \warning Not thread-safe, must be called before the pipeline is used
+     * */
+    void add_dependency(size_t stage, size_t upstream)
+    {
+        BOOST_ASSERT(upstream < stage && stage < stages_);
+        dependencies_[stage].push_back(upstream);
+    }
+
+    /** Claims the next free slot, which can be filled in place and is published by publish().
+     *
+     * \return pointer to the slot, which holds the entry, that has been processed by the last stage, or NULL, if
+     *         the pipeline is full
+     *
+     * \note Only to be called from the producer thread. Wait-free
+     * */
+    T * claim(void)
+    {
+        const size_t position = producer_cursor().load(memory_order_relaxed); // only written from producer thread
+        if (position - gate_ >= max_size_) {
+            gate_ = slowest_stage();
+            if (position - gate_ >= max_size_)
+                return NULL;
+        }
+        return slots_ + position % max_size_;
+    }
+
+    /** Publishes the slot, which has been returned by claim(), to the stages
+     *
+     * \note Only to be called from the producer thread. Wait-free
+     * */
+    void publish(void)
+    {
+        atomic<size_t> & position = producer_cursor();
+        position.store(position.load(memory_order_relaxed) + 1, memory_order_release);
+    }
+
+    /** Assigns t to the next free slot and publishes it
+     *
+     * \return true, if the enqueue operation is successful, false if the pipeline is full
+     *
+     * \note Only to be called from the producer thread. Wait-free
+     * */
+    bool enqueue(T const & t)
+    {
+        T * slot = claim();
+        if (!slot)
+            return false;
+        *slot = t;
+        publish();
+        return true;
+    }
+
+    /** Applies f in place to all entries, which have been processed by the upstream stages of stage (or have been
+     *  published by the producer, if stage has no dependencies). The entries are released to the downstream stages,
+     *  after f has been applied to all of them.
+     *
+     * \return number of processed entries
+     *
+     * \note Only to be called from the thread of this stage. Wait-free, if f is wait-free
+     * */
+    template <typename Functor>
+    size_t consume_all(size_t stage, Functor & f)
+    {
+        return consume_all_impl<Functor&>(stage, f);
+    }
+
+    //! \copydoc boost::lockfree::pipeline::consume_all(size_t, Functor &)
+    template <typename Functor>
+    size_t consume_all(size_t stage, Functor const & f)
+    {
+        return consume_all_impl<Functor const &>(stage, f);
+    }
+
+    /** Check if all published entries have been processed by all stages
+     *
+     * \warning Not thread-safe, use for debugging purposes only
+     * */
+    bool empty(void)
+    {
+        return slowest_stage() == producer_cursor().load(memory_order_relaxed);
+    }
+
+    //! \copydoc boost::lockfree::stack::is_lock_free
+    bool is_lock_free(void) const
+    {
+        return producer_cursor().is_lock_free();
+    }
+
+private:
+#ifndef BOOST_DOXYGEN_INVOKED
+    slot_allocator alloc_;
+    const size_t max_size_;
+    const size_t stages_;
+    T * const slots_;
+    std::vector<std::vector<size_t> > dependencies_;
+    detail::cursor_array<slot_allocator> cursors_;
+
+    char padding[BOOST_LOCKFREE_CACHELINE_BYTES]; /* force gate_ to a different cache line */
+    size_t gate_;       /* cached position of the slowest stage, only accessed by the producer */
+#endif
+};
+
+} /* namespace lockfree */
+} /* namespace boost */
+
+#endif /* BOOST_LOCKFREE_PIPELINE_HPP_INCLUDED */
@@ -0,0 +1,293 @@
+//  lock-free relaxed priority queue, composed of several skiplists
+//
+//  Copyright (C) 2026 Tim Blechmann
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  Disclaimer: Not a Boost library.
+
+#ifndef BOOST_LOCKFREE_PRIORITY_QUEUE_HPP_INCLUDED
+#define BOOST_LOCKFREE_PRIORITY_QUEUE_HPP_INCLUDED
+
+#include <boost/assert.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <boost/lockfree/detail/atomic.hpp>
+#include <boost/lockfree/detail/prefix.hpp>
+#include <boost/lockfree/skiplist.hpp>
+
+#include <cstddef>              /* for std::size_t */
+#include <functional>           /* for std::less */
+#include <memory>               /* for std::allocator */
+#include <new>
+
+namespace boost {
+namespace lockfree {
+
+#ifndef BOOST_DOXYGEN_INVOKED
+namespace detail {
+
+/* the ticket distinguishes elements with equal priorities and orders them by their insertion into a sub-queue */
+template <typename T>
+struct priority_key
+{
+    T value;
+    std::size_t ticket;
+};
+
+template <typename T, typename Compare>
+struct priority_key_compare
+{
+    explicit priority_key_compare(Compare const & compare = Compare()):
+        compare(compare)
+    {}
+
+    bool operator()(priority_key<T> const & lhs, priority_key<T> const & rhs) const
+    {
+        if (compare(lhs.value, rhs.value))
+            return true;
+        if (compare(rhs.value, lhs.value))
+            return false;
+        return lhs.ticket < rhs.ticket;
+    }
+
+    Compare compare;
+};
+
+} /* namespace detail */
+#endif
+
+/** The priority_queue class provides a multi-writer/multi-reader priority queue, pushing and popping is lockfree.
+ *  Unlike std::priority_queue, pop() returns the \b smallest element according to Compare, e.g. the earliest deadline.
+ *
+ *  The priority_queue is composed of several sub-queues, each of them a boost::lockfree::skiplist_set (MultiQueue).
+ *  push() inserts to a randomly chosen sub-queue. pop() compares the smallest elements of two randomly chosen
+ *  sub-queues and removes the smaller one. Threads, which operate on different sub-queues, do not contend on the same
+ *  nodes, so the throughput scales with the number of sub-queues.
+ *
+ *  Ordering guarantees:
+ *  - Each element is popped exactly once.
+ *  - With a single sub-queue, pop() removes the smallest element. Elements with equal priorities are popped in the
+ *    order of their insertion.
+ *  - With several sub-queues, the order is relaxed: pop() may return an element, which is not the smallest one. The
+ *    expected rank of the popped element is in the order of the number of sub-queues.
+ *  - pop() only fails, if every sub-queue has been found empty, when it was visited.
+ *
+ *  The template arguments freelist_t and Alloc are passed to the sub-queues. With a static_freelist_t, push() never
+ *  allocates, but fails, if the freelists of all sub-queues are exhausted.
+ *
+ *  \b Limitation: T is required to be trivially copyable and trivially destructible.
+ * */
+template <typename T,
+          typename Compare = std::less<T>,
+          typename freelist_t = caching_freelist_t,
+          typename Alloc = std::allocator<T>
+         >
+class priority_queue:
+    boost::noncopyable
+{
+#ifndef BOOST_DOXYGEN_INVOKED
+    typedef std::size_t size_t;
+    typedef detail::priority_key<T> key;
+    typedef detail::priority_key_compare<T, Compare> key_compare;
+    typedef typename detail::rebind_allocator<Alloc, key>::type key_allocator;
+    typedef skiplist_set<key, key_compare, freelist_t, key_allocator> set_type;
+
+    /* the ticket counter of one sub-queue and the head of the next sub-queue do not share a cache line */
+    struct sub_queue
+    {
+        sub_queue(size_t n, Compare const & compare, Alloc const & alloc):
+            set(n, key_compare(compare), key_allocator(alloc)), ticket(0)
+        {}
+
+        set_type set;
+        atomic<size_t> ticket;
+        char padding[BOOST_LOCKFREE_CACHELINE_BYTES];
+    };
+
+    typedef typename detail::rebind_allocator<Alloc, sub_queue>::type queue_allocator;
+
+    void initialize(size_t n, Compare const & compare, Alloc const & alloc)
+    {
+        BOOST_ASSERT(queue_count_ > 0);
+        for (size_t i = 0; i != queue_count_; ++i)
+            new (queues_ + i) sub_queue(n, compare, alloc);
+    }
+
+    size_t random_queue(void) const
+    {
+        return detail::thread_random() % queue_count_;
+    }
+
+    bool push_to(T const & t, size_t index)
+    {
+        sub_queue & q = queues_[index];
+        key k;
+        k.value = t;
+        k.ticket = q.ticket.fetch_add(1, memory_order_relaxed);
+        return q.set.insert(k);
+    }
+
+    bool pop_from(T & ret, size_t index)
+    {
+        key k;
+        if (!queues_[index].set.pop_front(k))
+            return false;
+        ret = k.value;
+        return true;
+    }
+#endif
+
+public:
+    typedef T value_type;
+    typedef Compare value_compare;
+
+    //! Construct priority_queue with a single sub-queue, which pops elements in exact priority order.
+    priority_queue(void):
+        queue_count_(1), queues_(alloc_.allocate(1))
+    {
+        initialize(0, Compare(), Alloc());
+    }
+
+    /** Construct priority_queue with the given number of sub-queues, allocate about n nodes for the freelist of each
+     *  sub-queue.
+     *
+     *  Two sub-queues per thread, which accesses the queue, give a good tradeoff between contention and rank error.
+     * */
+    explicit priority_queue(size_t queues, size_t n = 0):
+        queue_count_(queues), queues_(alloc_.allocate(queues))
+    {
+        initialize(n, Compare(), Alloc());
+    }
+
+    //! Construct priority_queue with the given number of sub-queues, allocate about n nodes for each of them from alloc
+    priority_queue(size_t queues, size_t n, Compare const & compare, Alloc const & alloc):
+        alloc_(alloc), queue_count_(queues), queues_(alloc_.allocate(queues)), value_compare_(compare)
+    {
+        initialize(n, compare, alloc);
+    }
+
+    //! Destroys the priority_queue and all remaining elements
+    ~priority_queue(void)
+    {
+        for (size_t i = 0; i != queue_count_; ++i)
+            queues_[i].~sub_queue();
+        alloc_.deallocate(queues_, queue_count_);
+    }
+
+    //! \returns number of sub-queues
+    size_t queues(void) const
+    {
+        return queue_count_;
+    }
+
+    //! \copydoc boost::lockfree::stack::is_lock_free
+    bool is_lock_free(void) const
+    {
+        return queues_[0].set.is_lock_free();
+    }
+
+    /** \returns number of elements
+     *
+     * \note The number may be outdated, if elements are pushed or popped concurrently
+     * */
+    size_t size(void) const
+    {
+        size_t ret = 0;
+        for (size_t i = 0; i != queue_count_; ++i)
+            ret += queues_[i].set.size();
+        return ret;
+    }
+
+    /** Check if all sub-queues are empty
+     *
+     * \note The result may be outdated, if elements are pushed or popped concurrently
+     * */
+    bool empty(void) const
+    {
+        for (size_t i = 0; i != queue_count_; ++i)
+            if (!queues_[i].set.empty())
+                return false;
+        return true;
+    }
+
+    /** Pushes object t to a randomly chosen sub-queue. If the freelist of that sub-queue is exhausted, the other
+     *  sub-queues are tried in round-robin order.
+     *
+     * \returns true, if the push operation is successful, false if no sub-queue is able to allocate a new node.
+     *
+     * \note Thread-safe and non-blocking
+     * \warning \b Warning: May block if node needs to be allocated from the operating system
+     * */
+    bool push(T const & t)
+    {
+        const size_t first = random_queue();
+        for (size_t i = 0; i != queue_count_; ++i) {
+            size_t index = first + i;
+            if (index >= queue_count_)
+                index -= queue_count_;
+            if (push_to(t, index))
+                return true;
+        }
+        return false;
+    }
+
+    /** Pops the smaller one of the smallest elements of two randomly chosen sub-queues. If both are empty, the
+     *  smallest element of any non-empty sub-queue is popped.
+     *
+     * If the pop operation is successful, the element is copied to the memory location denoted by ret.
+     *
+     * \returns true, if the pop operation is successful, false if all sub-queues were empty.
+     *
+     * \note Thread-safe and non-blocking
+     * */
+    bool pop(T & ret)
+    {
+        if (queue_count_ == 1)
+            return pop_from(ret, 0);
+
+        for (;;) {
+            const size_t i = random_queue();
+            size_t j = detail::thread_random() % (queue_count_ - 1);
+            if (j >= i)
+                ++j;
+
+            key front_i, front_j;
+            const bool found_i = queues_[i].set.front(front_i);
+            const bool found_j = queues_[j].set.front(front_j);
+            if (!found_i && !found_j)
+                break;
+
+            const key_compare less(compare());
+            const size_t index = (found_i && (!found_j || !less(front_j, front_i))) ? i : j;
+            if (pop_from(ret, index))
+                return true;
+        }
+
+        for (size_t i = 0; i != queue_count_; ++i)
+            if (pop_from(ret, i))
+                return true;
+        return false;
+    }
+
+    //! \returns the comparison object of the priorities
+    Compare compare(void) const
+    {
+        return value_compare_;
+    }
+
+private:
+#ifndef BOOST_DOXYGEN_INVOKED
+    queue_allocator alloc_;
+    const size_t queue_count_;
+    sub_queue * const queues_;
+    Compare value_compare_;
+#endif
+};
+
+} /* namespace lockfree */
+} /* namespace boost */
+
+#endif /* BOOST_LOCKFREE_PRIORITY_QUEUE_HPP_INCLUDED */
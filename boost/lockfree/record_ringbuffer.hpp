@@ -0,0 +1,276 @@
+//  lock-free single-producer/single-consumer ringbuffer for variable-length records
+//
+//  Copyright (C) 2026 Tim Blechmann
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  Disclaimer: Not a Boost library.
+
+#ifndef BOOST_LOCKFREE_RECORD_RINGBUFFER_HPP_INCLUDED
+#define BOOST_LOCKFREE_RECORD_RINGBUFFER_HPP_INCLUDED
+
+#include <boost/assert.hpp>
+
+#include <boost/lockfree/detail/prefix.hpp>
+#include <boost/lockfree/ringbuffer.hpp>
+
+#include <cstddef>              /* for std::size_t */
+#include <cstring>              /* for std::memcpy */
+#include <memory>               /* for std::allocator */
+
+namespace boost {
+namespace lockfree {
+
+//! view of a record in a boost::lockfree::record_ringbuffer
+struct record_view
+{
+    const char * data;
+    std::size_t size;
+};
+
+/** The record_ringbuffer class provides a single-writer/single-reader fifo queue for byte records of arbitrary size,
+ *  pushing and popping is wait-free.
+ *
+ *  Each record is stored contiguously, prefixed by its length and aligned to sizeof(std::size_t). If a record does not
+ *  fit into the space before the end of the buffer, the remaining space is marked as padding and the record is stored
+ *  at the beginning of the buffer.
+ *
+ *  Records are written in place: reserve() returns a pointer to the payload of the next record, which is published by
+ *  commit(). The consumer obtains a read_cursor, iterates the published records and releases them with commit_read().
+ * */
+template <typename Alloc = std::allocator<char> >
+class record_ringbuffer:
+    public detail::ringbuffer_base<char>
+{
+#ifndef BOOST_DOXYGEN_INVOKED
+    typedef std::size_t size_t;
+    typedef detail::ringbuffer_base<char> base_type;
+
+    static const size_t padding_marker = size_t(-1);
+
+    static size_t record_bytes(size_t size)
+    {
+        return (sizeof(size_t) + size + sizeof(size_t) - 1) / sizeof(size_t) * sizeof(size_t);
+    }
+
+    static size_t buffer_bytes(size_t max_size)
+    {
+        const size_t granularity = 2 * sizeof(size_t);
+        return (max_size + granularity - 1) / granularity * granularity;
+    }
+
+    size_t & header(size_t index)
+    {
+        return *reinterpret_cast<size_t*>(buffer_ + index);
+    }
+#endif
+
+public:
+    /** The read_cursor class iterates the records, which have been published, when the cursor was obtained.
+     *
+     * \note Only to be used from the consumer thread
+     * */
+    class read_cursor
+    {
+    public:
+        /** Get the next record
+         *
+         * \return true, if a record is available, false if all records of the cursor have been read
+         * */
+        bool next(record_view & view)
+        {
+            for (;;) {
+                if (consumed_ == available_)
+                    return false;
+
+                const size_t length = *reinterpret_cast<const size_t*>(buffer_ + position_);
+                if (length == padding_marker) {
+                    /* skip to the beginning of the buffer */
+                    consumed_ += max_size_ - position_;
+                    position_ = 0;
+                    continue;
+                }
+
+                view.data = buffer_ + position_ + sizeof(size_t);
+                view.size = length;
+
+                const size_t bytes = record_bytes(length);
+                consumed_ += bytes;
+                position_ += bytes;
+                if (position_ == max_size_)
+                    position_ = 0;
+                return true;
+            }
+        }
+
+    private:
+#ifndef BOOST_DOXYGEN_INVOKED
+        friend class record_ringbuffer;
+
+        read_cursor(const char * buffer, size_t max_size, size_t position, size_t available):
+            buffer_(buffer), max_size_(max_size), position_(position), available_(available), consumed_(0)
+        {}
+
+        const char * buffer_;
+        size_t max_size_;
+        size_t position_;
+        size_t available_;
+        size_t consumed_;
+#endif
+    };
+
+    //! Constructs a record_ringbuffer with a buffer of at least max_size bytes
+    explicit record_ringbuffer(size_t max_size):
+        max_size_(buffer_bytes(max_size)), buffer_(alloc_.allocate(max_size_)), record_(0), reserved_(0),
+        pending_(0)
+    {}
+
+    //! Constructs a record_ringbuffer with a buffer of at least max_size bytes, which is allocated from alloc
+    record_ringbuffer(size_t max_size, Alloc const & alloc):
+        alloc_(alloc), max_size_(buffer_bytes(max_size)), buffer_(alloc_.allocate(max_size_)),
+        record_(0), reserved_(0), pending_(0)
+    {}
+
+    ~record_ringbuffer(void)
+    {
+        alloc_.deallocate(buffer_, max_size_);
+    }
+
+    /** \returns the size of the largest record, which can be stored.
+     *
+     *  A record of this size can always be reserved, once the consumer has read all previous records.
+     * */
+    size_t max_record_size(void) const
+    {
+        return max_size_ / 2 - 2 * sizeof(size_t);
+    }
+
+    /** Reserves space for a record of size bytes.
+     *
+     *  The record can be written in place and is published by commit(). reserve() can be called again, if the record
+     *  has not been committed, which discards the previous reservation.
+     *
+     * \pre size must not exceed max_record_size()
+     * \return pointer to the payload of the record, or NULL, if the ringbuffer is full
+     *
+     * \note Only to be called from the producer thread. Wait-free
+     * */
+    char * reserve(size_t size)
+    {
+        BOOST_ASSERT(size <= max_record_size());
+
+        size_t write_index;
+        const size_t avail = base_type::prepare_write(write_index, max_size_);
+        const size_t bytes = record_bytes(size);
+        const size_t contiguous = max_size_ - write_index;
+
+        if (bytes <= contiguous) {
+            if (bytes > avail)
+                return NULL;
+            pending_ = 0;
+        } else {
+            if (contiguous + bytes > avail)
+                return NULL;
+
+            /* not published before commit */
+            header(write_index) = padding_marker;
+            pending_ = contiguous;
+            write_index = 0;
+        }
+
+        record_ = write_index;
+        reserved_ = size;
+        header(write_index) = size;
+        return buffer_ + write_index + sizeof(size_t);
+    }
+
+    /** Publishes the record, which has been reserved by reserve()
+     *
+     * \note Only to be called from the producer thread. Wait-free
+     * */
+    void commit(void)
+    {
+        commit(reserved_);
+    }
+
+    /** Publishes the first size bytes of the record, which has been reserved by reserve()
+     *
+     * \pre size must not exceed the size, which has been passed to reserve()
+     * \note Only to be called from the producer thread. Wait-free
+     * */
+    void commit(size_t size)
+    {
+        BOOST_ASSERT(size <= reserved_);
+
+        header(record_) = size;
+        base_type::commit_write(pending_ + record_bytes(size), max_size_);
+    }
+
+    /** Enqueues a copy of the record [data, data + size[
+     *
+     * \pre size must not exceed max_record_size()
+     * \return true, if the enqueue operation is successful, false if the ringbuffer is full
+     *
+     * \note Only to be called from the producer thread. Wait-free
+     * */
+    bool enqueue(const void * data, size_t size)
+    {
+        char * payload = reserve(size);
+        if (!payload)
+            return false;
+        std::memcpy(payload, data, size);
+        commit();
+        return true;
+    }
+
+    /** Obtains a cursor for all records, which have been published.
+     *
+     *  The records remain valid until they are released by commit_read().
+     *
+     * \note Only to be called from the consumer thread. Wait-free
+     * */
+    read_cursor read(void)
+    {
+        size_t read_index;
+        const size_t avail = base_type::prepare_read(read_index, max_size_);
+        return read_cursor(buffer_, max_size_, read_index, avail);
+    }
+
+    /** Releases all records, which have been returned by cursor.next()
+     *
+     * \note Only to be called from the consumer thread. Wait-free
+     * */
+    void commit_read(read_cursor const & cursor)
+    {
+        base_type::commit_read(cursor.consumed_, max_size_);
+    }
+
+    /** reset the ringbuffer
+     *
+     * \warning Not thread-safe, use for debugging purposes only
+     * */
+    void reset(void)
+    {
+        base_type::reset(buffer_, max_size_);
+    }
+
+private:
+#ifndef BOOST_DOXYGEN_INVOKED
+    Alloc alloc_;
+    const size_t max_size_;
+    char * const buffer_;
+
+    /* only accessed by the producer */
+    char padding[BOOST_LOCKFREE_CACHELINE_BYTES];
+    size_t record_;    /* index of the reserved record */
+    size_t reserved_;
+    size_t pending_;   /* bytes of padding in front of the reserved record */
+#endif
+};
+
+} /* namespace lockfree */
+} /* namespace boost */
+
+#endif /* BOOST_LOCKFREE_RECORD_RINGBUFFER_HPP_INCLUDED */
@@ -14,14 +14,21 @@
 #ifndef BOOST_LOCKFREE_RINGBUFFER_HPP_INCLUDED
 #define BOOST_LOCKFREE_RINGBUFFER_HPP_INCLUDED
 #include <boost/lockfree/detail/atomic.hpp>
-#include <boost/array.hpp>
+#include <boost/move/utility.hpp>
+#include <boost/mpl/bool.hpp>
 #include <boost/noncopyable.hpp>
-#include <boost/smart_ptr/scoped_array.hpp>
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/type_traits/has_trivial_assign.hpp>
+#include <boost/type_traits/has_trivial_destructor.hpp>
 
 #include "detail/branch_hints.hpp"
 #include "detail/prefix.hpp"
 
 #include <algorithm>
+#include <memory>               /* for std::allocator, std::uninitialized_copy */
+#include <new>
+#include <utility>              /* for std::forward, std::move */
 
 namespace boost
 {
@@ -72,6 +79,33 @@ protected:
         return ret;
     }
 
+    /* slots between read_index_ and write_index_ hold live objects, all other slots are uninitialized storage */
+    typedef boost::mpl::bool_<boost::has_trivial_assign<T>::value &&
+                              boost::has_trivial_destructor<T>::value
+                             > trivial_data;
+
+    template <typename OutputIterator>
+    static OutputIterator move_and_destroy(T * first, T * last, OutputIterator out, boost::mpl::true_)
+    {
+        return std::copy(first, last, out);
+    }
+
+    template <typename OutputIterator>
+    static OutputIterator move_and_destroy(T * first, T * last, OutputIterator out, boost::mpl::false_)
+    {
+        for (; first != last; ++first, ++out) {
+            *out = boost::move(*first);
+            first->~T();
+        }
+        return out;
+    }
+
+    template <typename OutputIterator>
+    static OutputIterator move_and_destroy(T * first, T * last, OutputIterator out)
+    {
+        return move_and_destroy(first, last, out, trivial_data());
+    }
+
     bool enqueue(T const & t, T * buffer, size_t max_size)
     {
         size_t write_index = write_index_.load(memory_order_relaxed);  // only written from enqueue thread
@@ -80,12 +114,44 @@ protected:
         if (next == read_index_.load(memory_order_acquire))
             return false; /* ringbuffer is full */
 
-        buffer[write_index] = t;
+        new (buffer + write_index) T(t);
+
+        write_index_.store(next, memory_order_release);
+
+        return true;
+    }
+
+#if !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES) && !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+    template <typename... ArgumentTypes>
+    bool emplace(T * buffer, size_t max_size, ArgumentTypes &&... args)
+    {
+        size_t write_index = write_index_.load(memory_order_relaxed);  // only written from enqueue thread
+        size_t next = next_index(write_index, max_size);
+
+        if (next == read_index_.load(memory_order_acquire))
+            return false; /* ringbuffer is full */
+
+        new (buffer + write_index) T(std::forward<ArgumentTypes>(args)...);
 
         write_index_.store(next, memory_order_release);
 
         return true;
     }
+#endif
+
+    void reset(T * buffer, size_t max_size)
+    {
+        size_t write_index = write_index_.load(memory_order_relaxed);
+        size_t read_index = read_index_.load(memory_order_relaxed);
+
+        if (!boost::has_trivial_destructor<T>::value) {
+            for (; read_index != write_index; read_index = next_index(read_index, max_size))
+                buffer[read_index].~T();
+        }
+
+        write_index_.store(0, memory_order_relaxed);
+        read_index_.store(0, memory_order_release);
+    }
 
     size_t enqueue(const T * input_buffer, size_t input_count, T * internal_buffer, size_t max_size)
     {
@@ -104,11 +170,11 @@ protected:
             /* copy data in two sections */
             size_t count0 = max_size - write_index;
 
-            std::copy(input_buffer, input_buffer + count0, internal_buffer + write_index);
-            std::copy(input_buffer + count0, input_buffer + input_count, internal_buffer);
+            std::uninitialized_copy(input_buffer, input_buffer + count0, internal_buffer + write_index);
+            std::uninitialized_copy(input_buffer + count0, input_buffer + input_count, internal_buffer);
             new_write_index -= max_size;
         } else {
-            std::copy(input_buffer, input_buffer + input_count, internal_buffer + write_index);
+            std::uninitialized_copy(input_buffer, input_buffer + input_count, internal_buffer + write_index);
 
             if (new_write_index == max_size)
                 new_write_index = 0;
@@ -144,11 +210,11 @@ protected:
             ConstIterator midpoint = begin;
             std::advance(midpoint, count0);
 
-            std::copy(begin, midpoint, internal_buffer + write_index);
-            std::copy(midpoint, last, internal_buffer);
+            std::uninitialized_copy(begin, midpoint, internal_buffer + write_index);
+            std::uninitialized_copy(midpoint, last, internal_buffer);
             new_write_index -= max_size;
         } else {
-            std::copy(begin, last, internal_buffer + write_index);
+            std::uninitialized_copy(begin, last, internal_buffer + write_index);
 
             if (new_write_index == max_size)
                 new_write_index = 0;
@@ -165,13 +231,15 @@ protected:
         if (empty(write_index, read_index))
             return false;
 
-        ret = buffer[read_index];
+        T * element = buffer + read_index;
+        ret = boost::move(*element);
+        element->~T();
         size_t next = next_index(read_index, max_size);
         read_index_.store(next, memory_order_release);
         return true;
     }
 
-    size_t dequeue (T * output_buffer, size_t output_count, const T * internal_buffer, size_t max_size)
+    size_t dequeue (T * output_buffer, size_t output_count, T * internal_buffer, size_t max_size)
     {
         const size_t write_index = write_index_.load(memory_order_acquire);
         size_t read_index = read_index_.load(memory_order_relaxed); // only written from dequeue thread
@@ -190,12 +258,12 @@ protected:
             size_t count0 = max_size - read_index;
             size_t count1 = output_count - count0;
 
-            std::copy(internal_buffer + read_index, internal_buffer + max_size, output_buffer);
-            std::copy(internal_buffer, internal_buffer + count1, output_buffer + count0);
+            move_and_destroy(internal_buffer + read_index, internal_buffer + max_size, output_buffer);
+            move_and_destroy(internal_buffer, internal_buffer + count1, output_buffer + count0);
 
             new_read_index -= max_size;
         } else {
-            std::copy(internal_buffer + read_index, internal_buffer + read_index + output_count, output_buffer);
+            move_and_destroy(internal_buffer + read_index, internal_buffer + read_index + output_count, output_buffer);
             if (new_read_index == max_size)
                 new_read_index = 0;
         }
@@ -205,7 +273,7 @@ protected:
     }
 
     template <typename OutputIterator>
-    size_t dequeue (OutputIterator it, const T * internal_buffer, size_t max_size)
+    size_t dequeue (OutputIterator it, T * internal_buffer, size_t max_size)
     {
         const size_t write_index = write_index_.load(memory_order_acquire);
         size_t read_index = read_index_.load(memory_order_relaxed); // only written from dequeue thread
@@ -221,12 +289,12 @@ protected:
             size_t count0 = max_size - read_index;
             size_t count1 = avail - count0;
 
-            std::copy(internal_buffer + read_index, internal_buffer + max_size, it);
-            std::copy(internal_buffer, internal_buffer + count1, it);
+            it = move_and_destroy(internal_buffer + read_index, internal_buffer + max_size, it);
+            move_and_destroy(internal_buffer, internal_buffer + count1, it);
 
             new_read_index -= max_size;
         } else {
-            std::copy(internal_buffer + read_index, internal_buffer + read_index + avail, it);
+            move_and_destroy(internal_buffer + read_index, internal_buffer + read_index + avail, it);
             if (new_read_index == max_size)
                 new_read_index = 0;
         }
@@ -234,20 +302,44 @@ protected:
         read_index_.store(new_read_index, memory_order_release);
         return avail;
     }
-#endif
 
+    /* two-phase protocol for writing to or reading from the buffer in place: prepare_* returns the index of the first
+     * slot and the number of available slots, commit_* publishes count slots */
+    size_t prepare_write(size_t & write_index, size_t max_size)
+    {
+        write_index = write_index_.load(memory_order_relaxed);  // only written from enqueue thread
+        const size_t read_index = read_index_.load(memory_order_acquire);
+        return write_available(write_index, read_index, max_size);
+    }
 
-public:
-    /** reset the ringbuffer
-     *
-     * \warning Not thread-safe, use for debugging purposes only
-     * */
-    void reset(void)
+    void commit_write(size_t count, size_t max_size)
     {
-        write_index_.store(0, memory_order_relaxed);
-        read_index_.store(0, memory_order_release);
+        size_t new_write_index = write_index_.load(memory_order_relaxed) + count;  // only written from enqueue thread
+        if (new_write_index >= max_size)
+            new_write_index -= max_size;
+        write_index_.store(new_write_index, memory_order_release);
     }
 
+    size_t prepare_read(size_t & read_index, size_t max_size)
+    {
+        const size_t write_index = write_index_.load(memory_order_acquire);
+        read_index = read_index_.load(memory_order_relaxed); // only written from dequeue thread
+        return read_available(write_index, read_index, max_size);
+    }
+
+    void commit_read(size_t count, size_t max_size)
+    {
+        size_t new_read_index = read_index_.load(memory_order_relaxed) + count; // only written from dequeue thread
+        if (new_read_index >= max_size)
+            new_read_index -= max_size;
+        read_index_.store(new_read_index, memory_order_release);
+    }
+#endif
+
+
+public:
+    typedef T value_type;
+
     /** Check if the ringbuffer is empty
      *
      * \warning Not thread-safe, use for debugging purposes only
@@ -272,14 +364,46 @@ private:
 
 } /* namespace detail */
 
-template <typename T, size_t max_size>
+/** The ringbuffer class provides a single-writer/single-reader fifo queue, pushing and popping is wait-free.
+ *
+ *  The ringbuffer<T, max_size> stores its elements inside the object. ringbuffer<T, 0> allocates storage for a
+ *  run-time specified number of elements from Alloc, which is ignored by the fixed-size variant.
+ * */
+template <typename T,
+          size_t max_size,
+          typename Alloc = std::allocator<T>
+         >
 class ringbuffer:
     public detail::ringbuffer_base<T>
 {
     typedef std::size_t size_t;
-    boost::array<T, max_size> array_;
+    boost::aligned_storage<max_size * sizeof(T), boost::alignment_of<T>::value> storage_;
+
+    T * data(void)
+    {
+        return static_cast<T*>(storage_.address());
+    }
 
 public:
+    //! Constructs a ringbuffer for max_size - 1 elements, without constructing any objects
+    ringbuffer(void)
+    {}
+
+    //! Destroys the ringbuffer and all remaining objects
+    ~ringbuffer(void)
+    {
+        detail::ringbuffer_base<T>::reset(data(), max_size);
+    }
+
+    /** reset the ringbuffer, destroying all objects
+     *
+     * \warning Not thread-safe, use for debugging purposes only
+     * */
+    void reset(void)
+    {
+        detail::ringbuffer_base<T>::reset(data(), max_size);
+    }
+
     /** Enqueues object t to the ringbuffer. Enqueueing may fail, if the ringbuffer is full.
      *
      * \return true, if the enqueue operation is successful.
@@ -288,12 +412,40 @@ public:
      * */
     bool enqueue(T const & t)
     {
-        return detail::ringbuffer_base<T>::enqueue(t, array_.c_array(), max_size);
+        return detail::ringbuffer_base<T>::enqueue(t, data(), max_size);
+    }
+
+#if !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES) && !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+    /** Moves object t to the ringbuffer. Enqueueing may fail, if the ringbuffer is full.
+     *
+     * \return true, if the enqueue operation is successful.
+     *
+     * \note Thread-safe and non-blocking
+     * */
+    bool enqueue(T && t)
+    {
+        return detail::ringbuffer_base<T>::emplace(data(), max_size, std::move(t));
+    }
+#endif
+
+#if !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES) && !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+    /** Constructs an object from args in place in the next free slot of the ringbuffer. Enqueueing may fail, if the
+     *  ringbuffer is full.
+     *
+     * \return true, if the enqueue operation is successful.
+     *
+     * \note Thread-safe and non-blocking
+     * */
+    template <typename... ArgumentTypes>
+    bool emplace(ArgumentTypes &&... args)
+    {
+        return detail::ringbuffer_base<T>::emplace(data(), max_size, std::forward<ArgumentTypes>(args)...);
     }
+#endif
 
     /** Dequeue object from ringbuffer.
      *
-     * If dequeue operation is successful, object is written to memory location denoted by ret.
+     * If dequeue operation is successful, object is moved to memory location denoted by ret.
      *
      * \return true, if the dequeue operation is successful, false if ringbuffer was empty.
      *
@@ -301,7 +453,7 @@ public:
      */
     bool dequeue(T & ret)
     {
-        return detail::ringbuffer_base<T>::dequeue(ret, array_.c_array(), max_size);
+        return detail::ringbuffer_base<T>::dequeue(ret, data(), max_size);
     }
 
     /** Enqueues size objects from the array t to the ringbuffer.
@@ -314,7 +466,7 @@ public:
      */
     size_t enqueue(T const * t, size_t size)
     {
-        return detail::ringbuffer_base<T>::enqueue(t, size, array_.c_array(), max_size);
+        return detail::ringbuffer_base<T>::enqueue(t, size, data(), max_size);
     }
 
     /** Enqueues all objects from the array t to the ringbuffer.
@@ -342,7 +494,7 @@ public:
     template <typename ConstIterator>
     ConstIterator enqueue(ConstIterator begin, ConstIterator end)
     {
-        return detail::ringbuffer_base<T>::enqueue(begin, end, array_.c_array(), max_size);
+        return detail::ringbuffer_base<T>::enqueue(begin, end, data(), max_size);
     }
 
     /** Dequeue a maximum of size objects from ringbuffer.
@@ -356,7 +508,7 @@ public:
     /* @{ */
     size_t dequeue(T * ret, size_t size)
     {
-        return detail::ringbuffer_base<T>::dequeue(ret, size, array_.c_array(), max_size);
+        return detail::ringbuffer_base<T>::dequeue(ret, size, data(), max_size);
     }
 
     /** Enqueues all objects from the array t to the ringbuffer.
@@ -382,24 +534,47 @@ public:
     template <typename OutputIterator>
     size_t dequeue(OutputIterator it)
     {
-        return detail::ringbuffer_base<T>::dequeue(it, array_.c_array(), max_size);
+        return detail::ringbuffer_base<T>::dequeue(it, data(), max_size);
     }
 };
 
-template <typename T>
-class ringbuffer<T, 0>:
+template <typename T, typename Alloc>
+class ringbuffer<T, 0, Alloc>:
     public detail::ringbuffer_base<T>
 {
     typedef std::size_t size_t;
+    Alloc alloc_;
     size_t max_size_;
-    scoped_array<T> array_;
+    T * array_;
 
 public:
-    //! Constructs a ringbuffer for max_size elements
+    //! Constructs a ringbuffer for max_size - 1 elements, without constructing any objects
     explicit ringbuffer(size_t max_size):
-        max_size_(max_size), array_(new T[max_size])
+        max_size_(max_size), array_(alloc_.allocate(max_size))
     {}
 
+    //! Constructs a ringbuffer for max_size - 1 elements, allocating its storage from alloc
+    ringbuffer(size_t max_size, Alloc const & alloc):
+        alloc_(alloc), max_size_(max_size), array_(alloc_.allocate(max_size))
+    {}
+
+    //! Destroys the ringbuffer and all remaining objects
+    ~ringbuffer(void)
+    {
+        detail::ringbuffer_base<T>::reset(array_, max_size_);
+        alloc_.deallocate(array_, max_size_);
+    }
+
+    /** reset the ringbuffer, destroying all objects
+     *
+     * \warning Not thread-safe, use for debugging purposes only
+     * */
+    void reset(void)
+    {
+        detail::ringbuffer_base<T>::reset(array_, max_size_);
+    }
+
+
     /** Enqueues object t to the ringbuffer. Enqueueing may fail, if the ringbuffer is full.
      *
      * \return true, if the enqueue operation is successful.
@@ -408,12 +583,40 @@ public:
      * */
     bool enqueue(T const & t)
     {
-        return detail::ringbuffer_base<T>::enqueue(t, array_.get(), max_size_);
+        return detail::ringbuffer_base<T>::enqueue(t, array_, max_size_);
+    }
+
+#if !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES) && !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+    /** Moves object t to the ringbuffer. Enqueueing may fail, if the ringbuffer is full.
+     *
+     * \return true, if the enqueue operation is successful.
+     *
+     * \note Thread-safe and non-blocking
+     * */
+    bool enqueue(T && t)
+    {
+        return detail::ringbuffer_base<T>::emplace(array_, max_size_, std::move(t));
+    }
+#endif
+
+#if !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES) && !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+    /** Constructs an object from args in place in the next free slot of the ringbuffer. Enqueueing may fail, if the
+     *  ringbuffer is full.
+     *
+     * \return true, if the enqueue operation is successful.
+     *
+     * \note Thread-safe and non-blocking
+     * */
+    template <typename... ArgumentTypes>
+    bool emplace(ArgumentTypes &&... args)
+    {
+        return detail::ringbuffer_base<T>::emplace(array_, max_size_, std::forward<ArgumentTypes>(args)...);
     }
+#endif
 
     /** Dequeue object from ringbuffer.
      *
-     * If dequeue operation is successful, object is written to memory location denoted by ret.
+     * If dequeue operation is successful, object is moved to memory location denoted by ret.
      *
      * \return true, if the dequeue operation is successful, false if ringbuffer was empty.
      *
@@ -421,7 +624,7 @@ public:
      */
     bool dequeue(T & ret)
     {
-        return detail::ringbuffer_base<T>::dequeue(ret, array_.get(), max_size_);
+        return detail::ringbuffer_base<T>::dequeue(ret, array_, max_size_);
     }
 
     /** Enqueues size objects from the array t to the ringbuffer.
@@ -434,7 +637,7 @@ public:
      */
     size_t enqueue(T const * t, size_t size)
     {
-        return detail::ringbuffer_base<T>::enqueue(t, size, array_.get(), max_size_);
+        return detail::ringbuffer_base<T>::enqueue(t, size, array_, max_size_);
     }
 
     /** Enqueues all objects from the array t to the ringbuffer.
@@ -462,7 +665,7 @@ public:
     template <typename ConstIterator>
     ConstIterator enqueue(ConstIterator begin, ConstIterator end)
     {
-        return detail::ringbuffer_base<T>::enqueue(begin, end, array_.get(), max_size_);
+        return detail::ringbuffer_base<T>::enqueue(begin, end, array_, max_size_);
     }
 
     /** Dequeue a maximum of size objects from ringbuffer.
@@ -475,7 +678,7 @@ public:
      * */
     size_t dequeue(T * ret, size_t size)
     {
-        return detail::ringbuffer_base<T>::dequeue(ret, size, array_.get(), max_size_);
+        return detail::ringbuffer_base<T>::dequeue(ret, size, array_, max_size_);
     }
 
     /** Dequeue objects from ringbuffer.
@@ -501,7 +704,7 @@ public:
     template <typename OutputIterator>
     size_t dequeue(OutputIterator it)
     {
-        return detail::ringbuffer_base<T>::dequeue(it, array_.get(), max_size_);
+        return detail::ringbuffer_base<T>::dequeue(it, array_, max_size_);
     }
 };
 
@@ -0,0 +1,211 @@
+//  lock-free relaxed fifo, sharded into per-thread sub-queues
+//
+//  Copyright (C) 2026 Tim Blechmann
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  Disclaimer: Not a Boost library.
+
+#ifndef BOOST_LOCKFREE_SHARDED_FIFO_HPP_INCLUDED
+#define BOOST_LOCKFREE_SHARDED_FIFO_HPP_INCLUDED
+
+#include <boost/assert.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <boost/lockfree/detail/atomic.hpp>
+#include <boost/lockfree/detail/prefix.hpp>
+#include <boost/lockfree/detail/thread_index.hpp>
+#include <boost/lockfree/fifo.hpp>
+
+#include <cstddef>              /* for std::size_t */
+#include <memory>               /* for std::allocator */
+#include <new>
+
+#ifndef BOOST_LOCKFREE_THREAD_LOCAL
+#error "boost/lockfree/sharded_fifo.hpp requires thread-local storage"
+#endif
+
+namespace boost {
+namespace lockfree {
+/** The sharded_fifo class provides a multi-writer/multi-reader queue with relaxed fifo semantics, which is composed of
+ *  several boost::lockfree::fifo shards. Enqueueing and dequeueing is lockfree.
+ *
+ *  Each thread enqueues to its local shard and dequeues from its local shard, if that is empty, it steals from the
+ *  other shards in round-robin order. Threads, which operate on different shards, do not contend on the same head and
+ *  tail pointers, so the throughput scales with the number of shards, as long as the shards are balanced.
+ *
+ *  By default, the local shard of a thread is determined by the order, in which threads first access any sharded_fifo,
+ *  modulo the number of shards. Thread pools, which know the index of their workers, can pass the shard explicitly.
+ *
+ *  Ordering guarantees:
+ *  - Each object is dequeued exactly once.
+ *  - Objects, which are enqueued to the same shard (e.g. by the same thread), are dequeued in fifo order.
+ *  - There is no order between objects of different shards.
+ *  - dequeue() only fails, if every shard has been found empty, when it was visited. An object, which is enqueued
+ *    concurrently to a shard, which has already been visited, may be missed.
+ *
+ *  The template arguments freelist_t and Alloc are passed to the shards.
+ * */
+template <typename T,
+          typename freelist_t = caching_freelist_t,
+          typename Alloc = std::allocator<T>
+         >
+class sharded_fifo:
+    boost::noncopyable
+{
+#ifndef BOOST_DOXYGEN_INVOKED
+    typedef std::size_t size_t;
+    typedef fifo<T, freelist_t, Alloc> fifo_type;
+
+    /* the freelist of one shard and the head of the next shard do not share a cache line */
+    struct shard
+    {
+        shard(size_t n, Alloc const & alloc):
+            queue(n, alloc)
+        {}
+
+        fifo_type queue;
+        char padding[BOOST_LOCKFREE_CACHELINE_BYTES];
+    };
+
+    typedef typename detail::rebind_allocator<Alloc, shard>::type shard_allocator;
+
+    void initialize(size_t n, Alloc const & alloc)
+    {
+        BOOST_ASSERT(shard_count_ > 0);
+        for (size_t i = 0; i != shard_count_; ++i)
+            new (shards_ + i) shard(n, alloc);
+    }
+
+    size_t local_shard(void) const
+    {
+        return detail::thread_index() % shard_count_;
+    }
+#endif
+
+public:
+    typedef T value_type;
+
+    /** Construct sharded_fifo with the given number of shards, allocate n nodes for the freelist of each shard.
+     *
+     *  The number of shards should be the number of threads, which access the queue, or the number of cores.
+     * */
+    explicit sharded_fifo(size_t shards, size_t n = 0):
+        shard_count_(shards), shards_(alloc_.allocate(shards))
+    {
+        initialize(n, Alloc());
+    }
+
+    //! Construct sharded_fifo with the given number of shards, allocate n nodes for each shard from alloc.
+    sharded_fifo(size_t shards, size_t n, Alloc const & alloc):
+        alloc_(alloc), shard_count_(shards), shards_(alloc_.allocate(shards))
+    {
+        initialize(n, alloc);
+    }
+
+    //! Destroys the sharded_fifo and all remaining objects
+    ~sharded_fifo(void)
+    {
+        for (size_t i = 0; i != shard_count_; ++i)
+            shards_[i].~shard();
+        alloc_.deallocate(shards_, shard_count_);
+    }
+
+    //! \returns number of shards
+    size_t shards(void) const
+    {
+        return shard_count_;
+    }
+
+    //! \copydoc boost::lockfree::stack::is_lock_free
+    bool is_lock_free(void) const
+    {
+        return shards_[0].queue.is_lock_free();
+    }
+
+    /** Check if all shards are empty
+     *
+     * \warning Not thread-safe, use for debugging purposes only
+     * */
+    bool empty(void)
+    {
+        for (size_t i = 0; i != shard_count_; ++i)
+            if (!shards_[i].queue.empty())
+                return false;
+        return true;
+    }
+
+    /** Enqueues object t to the local shard of the calling thread.
+     *
+     * \returns true, if the enqueue operation is successful.
+     *
+     * \note Thread-safe and non-blocking
+     * \warning \b Warning: May block if node needs to be allocated from the operating system
+     * */
+    bool enqueue(T const & t)
+    {
+        return enqueue(t, local_shard());
+    }
+
+    /** Enqueues object t to the given shard.
+     *
+     * \pre shard < shards()
+     * \returns true, if the enqueue operation is successful.
+     *
+     * \note Thread-safe and non-blocking
+     * \warning \b Warning: May block if node needs to be allocated from the operating system
+     * */
+    bool enqueue(T const & t, size_t shard)
+    {
+        BOOST_ASSERT(shard < shard_count_);
+        return shards_[shard].queue.enqueue(t);
+    }
+
+    /** Dequeues an object from the local shard of the calling thread or steals one from another shard.
+     *
+     * \returns true, if the dequeue operation is successful, false if all shards were empty.
+     *
+     * \note Thread-safe and non-blocking
+     * */
+    bool dequeue(T & ret)
+    {
+        return dequeue(ret, local_shard());
+    }
+
+    /** Dequeues an object from the given shard or steals one from another shard.
+     *
+     * \pre shard < shards()
+     * \returns true, if the dequeue operation is successful, false if all shards were empty.
+     *
+     * \note Thread-safe and non-blocking
+     * */
+    bool dequeue(T & ret, size_t shard)
+    {
+        BOOST_ASSERT(shard < shard_count_);
+        if (shards_[shard].queue.dequeue(ret))
+            return true;
+
+        for (size_t i = 1; i != shard_count_; ++i) {
+            size_t victim = shard + i;
+            if (victim >= shard_count_)
+                victim -= shard_count_;
+            if (shards_[victim].queue.dequeue(ret))
+                return true;
+        }
+        return false;
+    }
+
+private:
+#ifndef BOOST_DOXYGEN_INVOKED
+    shard_allocator alloc_;
+    const size_t shard_count_;
+    shard * const shards_;
+#endif
+};
+
+} /* namespace lockfree */
+} /* namespace boost */
+
+#endif /* BOOST_LOCKFREE_SHARDED_FIFO_HPP_INCLUDED */
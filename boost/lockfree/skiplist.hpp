@@ -0,0 +1,935 @@
+//  lock-free skiplist map and set, based on
+//  Herlihy, M. and Shavit, N.,
+//  "the art of multiprocessor programming", chapter 14.4: "a lock-free concurrent skiplist"
+//
+//  aba prevention as in
+//  Michael, M. M.,
+//  "high performance dynamic lock-free hash tables and list-based sets"
+//
+//  Copyright (C) 2026 Tim Blechmann
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  Disclaimer: Not a Boost library.
+
+#ifndef BOOST_LOCKFREE_SKIPLIST_HPP_INCLUDED
+#define BOOST_LOCKFREE_SKIPLIST_HPP_INCLUDED
+
+#include <boost/cstdint.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/mpl/if.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/type_traits/has_trivial_assign.hpp>
+#include <boost/type_traits/has_trivial_copy.hpp>
+#include <boost/type_traits/has_trivial_destructor.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <boost/lockfree/detail/atomic.hpp>
+#include <boost/lockfree/detail/branch_hints.hpp>
+#include <boost/lockfree/detail/freelist.hpp>
+#include <boost/lockfree/detail/prefix.hpp>
+#include <boost/lockfree/detail/tagged_ptr.hpp>
+
+#include <cstddef>              /* for std::size_t */
+#include <functional>           /* for std::less */
+#include <memory>               /* for std::allocator */
+#include <new>
+
+#ifndef BOOST_LOCKFREE_THREAD_LOCAL
+#error "boost/lockfree/skiplist.hpp requires thread-local storage"
+#endif
+
+namespace boost {
+namespace lockfree {
+namespace detail {
+
+/* allocates nodes with a tower of a fixed height, so that a freelist_stack can be used for each height */
+template <typename Node, typename Alloc>
+class tower_allocator
+{
+    typedef typename rebind_allocator<Alloc, char>::type byte_allocator;
+
+public:
+    tower_allocator(Alloc const & alloc, std::size_t bytes):
+        alloc_(alloc), bytes_(bytes)
+    {}
+
+    Node * allocate(std::size_t)
+    {
+        return reinterpret_cast<Node*>(alloc_.allocate(bytes_));
+    }
+
+    void deallocate(Node * n, std::size_t)
+    {
+        alloc_.deallocate(reinterpret_cast<char*>(n), bytes_);
+    }
+
+private:
+    byte_allocator alloc_;
+    std::size_t bytes_;
+};
+
+/* xorshift generator with a thread-local state */
+inline boost::uint32_t thread_random(void)
+{
+    static BOOST_LOCKFREE_THREAD_LOCAL boost::uint32_t state = 0;
+    boost::uint32_t x = state;
+    if (unlikely(x == 0)) {
+        /* seed from the address of the thread-local state */
+        x = boost::uint32_t(reinterpret_cast<std::size_t>(&state) * 2654435761u) | 1;
+    }
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    state = x;
+    return x;
+}
+
+/* returns a random tower height in [1, max_height], height h is chosen with a probability of 2^-h */
+inline unsigned int random_tower_height(unsigned int max_height)
+{
+    boost::uint32_t x = thread_random();
+
+    unsigned int height = 1;
+    while ((x & 1) && height < max_height) {
+        ++height;
+        x >>= 1;
+    }
+    return height;
+}
+
+/* grants the tests access to the internals of a skiplist_map */
+template <typename Map>
+struct skiplist_access;
+
+} /* namespace detail */
+
+/** The skiplist_map class provides a multi-writer/multi-reader ordered map, lookups, insertions, erasures and range
+ *  scans are lockfree.
+ *
+ *  The elements are stored in a skiplist: each node is linked into the lists of 1 to max_height levels, the number of
+ *  levels is chosen randomly, so that each level contains about half of the nodes of the level below. An element is
+ *  erased logically by marking the links of its node (the lowest bit of the tag of the tagged_ptr), before it is
+ *  unlinked from all levels. Every modification of a link increments its tag, so a thread can validate, that a node
+ *  has not been unlinked or reused since it has been read.
+ *
+ *  Like stack and fifo, the skiplist_map uses freelists for memory management: there is one freelist for each tower
+ *  height. A node is pushed to the freelist of its height, after it has been unlinked from all levels, and not
+ *  returned to the os before the skiplist_map is destroyed. The freelists can be selected via the freelist_t template
+ *  argument: with a caching_freelist_t, insert() may block, with a static_freelist_t, insert() may fail. If the
+ *  static freelist of the randomly chosen height is exhausted, a lower node is used.
+ *
+ *  scan() visits the elements of a range in ascending order. It is weakly consistent: every visited element has been
+ *  in the map at some point during the scan, elements, which are inserted or erased concurrently, may be missed.
+ *
+ *  \b Limitation: Key and T are required to be trivially copyable and trivially destructible. Since nodes are reused,
+ *                 lookups may read keys and values of nodes, which are modified concurrently, before detecting the
+ *                 modification. Elements cannot be modified in place.
+ * */
+template <typename Key,
+          typename T,
+          typename Compare = std::less<Key>,
+          typename freelist_t = caching_freelist_t,
+          typename Alloc = std::allocator<T>
+         >
+class skiplist_map:
+    boost::noncopyable
+{
+#ifndef BOOST_DOXYGEN_INVOKED
+    BOOST_STATIC_ASSERT(boost::has_trivial_assign<Key>::value);
+    BOOST_STATIC_ASSERT(boost::has_trivial_copy<Key>::value);
+    BOOST_STATIC_ASSERT(boost::has_trivial_destructor<Key>::value);
+    BOOST_STATIC_ASSERT(boost::has_trivial_assign<T>::value);
+    BOOST_STATIC_ASSERT(boost::has_trivial_copy<T>::value);
+    BOOST_STATIC_ASSERT(boost::has_trivial_destructor<T>::value);
+
+    typedef std::size_t size_t;
+
+    enum {
+        max_height = 24
+    };
+
+    friend struct detail::skiplist_access<skiplist_map>;
+
+    struct node;
+    typedef detail::tagged_ptr<node> tagged_node_ptr;
+    typedef atomic<tagged_node_ptr> link;
+
+    /* the links of the tower follow the node in the same allocation */
+    struct node
+    {
+        detail::freelist_node free_link;        /* overwritten by the freelist, the tags of the tower are preserved */
+        atomic<unsigned int> references;        /* one for each level, which links to the node, one for the inserter */
+        unsigned int height;
+        Key key;
+        T value;
+
+        link * tower(void)
+        {
+            return reinterpret_cast<link*>(reinterpret_cast<char*>(this) + header_bytes());
+        }
+    };
+
+    static size_t header_bytes(void)
+    {
+        const size_t alignment = boost::alignment_of<link>::value;
+        return (sizeof(node) + alignment - 1) / alignment * alignment;
+    }
+
+    typedef detail::tower_allocator<node, Alloc> node_allocator;
+
+    typedef typename boost::mpl::if_<boost::is_same<freelist_t, caching_freelist_t>,
+                                     detail::freelist_stack<node, true, node_allocator>,
+                                     detail::freelist_stack<node, false, node_allocator>
+                                     >::type pool_t;
+
+    /* the freelists of different heights do not share a cache line */
+    struct pool_slot
+    {
+        pool_slot(Alloc const & alloc, unsigned int height, size_t n):
+            pool(node_allocator(alloc, header_bytes() + height * sizeof(link)), n)
+        {}
+
+        pool_t pool;
+        char padding[BOOST_LOCKFREE_CACHELINE_BYTES];
+    };
+
+    typedef typename detail::rebind_allocator<Alloc, pool_slot>::type pool_allocator;
+
+    /* the predecessors and successors of a key on all levels. succs[level] is the value of the link
+     * preds[level]->tower()[level], when it has been validated */
+    struct position
+    {
+        node * preds[max_height];
+        tagged_node_ptr succs[max_height];
+    };
+
+    static bool is_marked(tagged_node_ptr const & p)
+    {
+        return p.get_tag() & 1;
+    }
+
+    pool_t & pool(unsigned int height)
+    {
+        return pools_[height - 1].pool;
+    }
+
+    /* returns a node with unmarked tags, which are larger than any tag, that its links had before. if the freelist
+     * of the requested height is exhausted, a lower node is returned */
+    node * allocate_node(unsigned int height)
+    {
+        node * n = pool(height).allocate();
+        while (n == NULL) {
+            if (--height == 0)
+                return NULL;
+            n = pool(height).allocate();
+        }
+
+        link * tower = n->tower();
+        for (unsigned int level = 0; level != height; ++level) {
+            const tagged_node_ptr old_link = tower[level].load(memory_order_relaxed);
+            tower[level].store(tagged_node_ptr(NULL, (old_link.get_tag() | 1) + 1), memory_order_relaxed);
+        }
+        /* a node in the freelist has no references and acquire() does not add one, so the count can be stored */
+        n->references.store(1, memory_order_relaxed);
+        n->height = height;
+        return n;
+    }
+
+    void release(node * n)
+    {
+        if (n->references.fetch_sub(1) == 1)
+            pool(n->height).deallocate(n);
+    }
+
+    /* increments the reference count, unless the node is in the freelist */
+    static bool acquire(node * n)
+    {
+        unsigned int references = n->references.load(memory_order_relaxed);
+        do {
+            if (references == 0)
+                return false;
+        } while (!n->references.compare_exchange_weak(references, references + 1));
+        return true;
+    }
+
+    bool less(Key const & lhs, Key const & rhs) const
+    {
+        return compare_(lhs, rhs);
+    }
+
+    /* searches the predecessors and successors of key on all levels, erased nodes are unlinked on the way. if after
+     * is true, the successors are the first nodes with a key larger than key, otherwise not smaller than key.
+     *
+     * \returns true, if succs[0] points to the node with the given key. its value is copied to value, and the link of
+     *          its lowest level to next
+     * */
+    bool find_position(Key const & key, position & pos, bool after = false, T * value = NULL,
+                       tagged_node_ptr * next_link = NULL)
+    {
+    retry:
+        node * pred = head_;
+        const int top = int(height_.load(memory_order_acquire));
+        tagged_node_ptr above;
+        bool found = false;
+
+        for (int level = top - 1; level >= 0; --level) {
+            link * pred_link = pred->tower() + level;
+            tagged_node_ptr cur = pred_link->load(memory_order_acquire);
+
+            if (level != top - 1) {
+                /* pred may have been erased and reused, since we have reached it on the level above */
+                atomic_thread_fence(memory_order_acquire);
+                if (pred->tower()[level + 1].load(memory_order_relaxed) != above)
+                    goto retry;
+            }
+            if (is_marked(cur)) {
+                /* pred has been erased, but its upper levels may not be marked yet. unless they are marked, the retry
+                 * would reach pred on the level above again, until the erasing thread continues */
+                help_erase(pred, level, cur);
+                goto retry;
+            }
+
+            for (;;) {
+                node * c = cur.get_ptr();
+                if (c == NULL)
+                    break;
+
+                const tagged_node_ptr next = c->tower()[level].load(memory_order_acquire);
+                const Key cur_key = c->key;
+                const bool advance = after ? !less(key, cur_key) : less(cur_key, key);
+                found = level == 0 && !advance && !after && !less(key, cur_key);
+                if (found && value)
+                    *value = c->value;
+
+                /* c may have been unlinked and reused, while we were reading it */
+                atomic_thread_fence(memory_order_acquire);
+                if (pred_link->load(memory_order_relaxed) != cur)
+                    goto retry;
+
+                if (is_marked(next)) {
+                    tagged_node_ptr unlinked(next.get_ptr(), cur.get_tag() + 2);
+                    if (!pred_link->compare_exchange_strong(cur, unlinked))
+                        goto retry;
+
+                    release(c);
+                    cur = unlinked;
+                    found = false;
+                    continue;
+                }
+
+                if (!advance) {
+                    if (found && next_link)
+                        *next_link = next;
+                    break;
+                }
+
+                pred = c;
+                pred_link = c->tower() + level;
+                cur = next;
+            }
+
+            pos.preds[level] = pred;
+            pos.succs[level] = cur;
+            above = cur;
+        }
+        return found;
+    }
+
+    void raise_height(unsigned int height)
+    {
+        unsigned int current = height_.load(memory_order_relaxed);
+        while (current < height)
+            if (height_.compare_exchange_weak(current, height))
+                break;
+    }
+
+    void initialize(size_t n, Alloc const & alloc)
+    {
+        /* about n / 2^height nodes of each height */
+        for (unsigned int height = 1; height <= max_height; ++height)
+            new (pools_ + height - 1) pool_slot(alloc, height, n >> height);
+
+        pool(max_height).reserve_unsafe(1);
+        head_ = allocate_node(max_height);
+        for (unsigned int level = 0; level != max_height; ++level)
+            head_->tower()[level].store(tagged_node_ptr(NULL, 0), memory_order_relaxed);
+    }
+
+    /* finds the first element, which has not been erased. its key and value are copied to key and value, next is the
+     * validated link of its lowest level */
+    bool find_first(node *& first, tagged_node_ptr & next, Key & key, T & value)
+    {
+    retry:
+        link * head_link = head_->tower();
+        tagged_node_ptr cur = head_link->load(memory_order_acquire);
+
+        for (;;) {
+            node * c = cur.get_ptr();
+            if (c == NULL)
+                return false;
+
+            next = c->tower()[0].load(memory_order_acquire);
+            key = c->key;
+            value = c->value;
+
+            atomic_thread_fence(memory_order_acquire);
+            if (head_link->load(memory_order_relaxed) != cur)
+                goto retry;
+
+            if (!is_marked(next)) {
+                first = c;
+                return true;
+            }
+
+            tagged_node_ptr unlinked(next.get_ptr(), cur.get_tag() + 2);
+            if (!head_link->compare_exchange_strong(cur, unlinked))
+                goto retry;
+
+            release(c);
+            cur = unlinked;
+        }
+    }
+
+    /* erases the element logically by marking its lowest level. the tag of next ensures, that the node has not been
+     * reused since it has been found.
+     *
+     * \returns true, if the calling thread has erased the element. it holds a reference to the node in this case
+     * */
+    bool mark(node * n, tagged_node_ptr next)
+    {
+        if (!acquire(n))
+            return false;
+
+        tagged_node_ptr marked(next.get_ptr(), next.get_tag() + 1);
+        if (n->tower()[0].compare_exchange_strong(next, marked))
+            return true;
+
+        release(n);
+        return false;
+    }
+
+    /* marks the upper levels of an erased node. the caller has to hold a reference to the node */
+    static void mark_upper_levels(node * n)
+    {
+        link * tower = n->tower();
+        for (unsigned int level = 1; level != n->height; ++level) {
+            tagged_node_ptr own_link = tower[level].load(memory_order_relaxed);
+            while (!is_marked(own_link))
+                tower[level].compare_exchange_weak(own_link, tagged_node_ptr(own_link.get_ptr(),
+                                                                             own_link.get_tag() + 1));
+        }
+    }
+
+    /* marks the upper levels of a node, whose link on the given level has been found marked. a marked link is not
+     * modified before the node is reused, so it validates, that the node has not been reused before the reference has
+     * been acquired */
+    void help_erase(node * n, unsigned int level, tagged_node_ptr const & marked_link)
+    {
+        if (!acquire(n))
+            return;
+
+        if (n->tower()[level].load(memory_order_acquire) == marked_link)
+            mark_upper_levels(n);
+        release(n);
+    }
+
+    /* marks the upper levels of a node, which has been erased by the calling thread, and unlinks it */
+    void finish_erase(node * n, Key const & key)
+    {
+        size_.fetch_sub(1, memory_order_relaxed);
+        mark_upper_levels(n);
+
+        position pos;
+        find_position(key, pos);
+        release(n);
+    }
+
+    template <typename Functor>
+    size_t scan_impl(Key const & first, Key const & last, Functor f)
+    {
+        size_t count = 0;
+        Key resume = first;
+        bool after = false;
+        position pos;
+
+    restart:
+        find_position(resume, pos, after);
+        node * pred = pos.preds[0];
+        tagged_node_ptr cur = pos.succs[0];
+
+        for (;;) {
+            node * c = cur.get_ptr();
+            if (c == NULL)
+                return count;
+
+            link * pred_link = pred->tower();
+            const tagged_node_ptr next = c->tower()[0].load(memory_order_acquire);
+            const Key cur_key = c->key;
+            const T cur_value = c->value;
+
+            atomic_thread_fence(memory_order_acquire);
+            if (pred_link->load(memory_order_relaxed) != cur)
+                goto restart;
+
+            if (is_marked(next)) {
+                tagged_node_ptr unlinked(next.get_ptr(), cur.get_tag() + 2);
+                if (!pred_link->compare_exchange_strong(cur, unlinked))
+                    goto restart;
+
+                release(c);
+                cur = unlinked;
+                continue;
+            }
+
+            if (!less(cur_key, last))
+                return count;
+
+            f(cur_key, cur_value);
+            ++count;
+            resume = cur_key;
+            after = true;
+
+            pred = c;
+            cur = next;
+        }
+    }
+#endif
+
+public:
+    typedef Key key_type;
+    typedef T mapped_type;
+    typedef Compare key_compare;
+
+    /** Construct skiplist_map, allocate about n nodes for the freelists
+     *
+     * \note With a static_freelist_t, the nodes are distributed among the freelists of all tower heights according to
+     *       the expected distribution of heights.
+     * */
+    explicit skiplist_map(size_t n = 0, Compare const & compare = Compare()):
+        compare_(compare), pools_(pool_alloc_.allocate(max_height)), height_(1), size_(0)
+    {
+        initialize(n, Alloc());
+    }
+
+    //! Construct skiplist_map, allocate about n nodes for the freelists from alloc
+    skiplist_map(size_t n, Compare const & compare, Alloc const & alloc):
+        compare_(compare), pool_alloc_(alloc), pools_(pool_alloc_.allocate(max_height)), height_(1), size_(0)
+    {
+        initialize(n, alloc);
+    }
+
+    /** Destroys skiplist_map, free all nodes from freelists.
+     *
+     *  \note not thread-safe
+     * */
+    ~skiplist_map(void)
+    {
+        /* a node, which has been erased concurrently, may still be linked on some levels, so every level releases the
+         * references of its nodes */
+        for (int level = max_height - 1; level >= 0; --level) {
+            node * n = head_->tower()[level].load(memory_order_relaxed).get_ptr();
+            while (n) {
+                node * next = n->tower()[level].load(memory_order_relaxed).get_ptr();
+                if (n->references.fetch_sub(1, memory_order_relaxed) == 1)
+                    pool(n->height).deallocate_unsafe(n);
+                n = next;
+            }
+        }
+        pool(max_height).deallocate_unsafe(head_);
+
+        for (unsigned int height = 1; height <= max_height; ++height)
+            pools_[height - 1].~pool_slot();
+        pool_alloc_.deallocate(pools_, max_height);
+    }
+
+    //! \copydoc boost::lockfree::stack::is_lock_free
+    bool is_lock_free(void) const
+    {
+        return head_->tower()[0].is_lock_free() && pools_[0].pool.is_lock_free();
+    }
+
+    /** \returns number of elements
+     *
+     * \note The number may be outdated, if elements are inserted or erased concurrently
+     * */
+    size_t size(void) const
+    {
+        return size_.load(memory_order_relaxed);
+    }
+
+    /** Check if the skiplist_map is empty
+     *
+     * \note The result may be outdated, if elements are inserted or erased concurrently
+     * */
+    bool empty(void) const
+    {
+        return size() == 0;
+    }
+
+    /** Inserts the pair (key, value), unless the map contains an element with the same key.
+     *
+     * \returns true, if the element has been inserted, false if the key has already been in the map or the freelist is
+     *          not able to allocate a new node.
+     *
+     * \note Thread-safe and non-blocking
+     * \warning \b Warning: May block if node needs to be allocated from the operating system
+     * */
+    bool insert(Key const & key, T const & value)
+    {
+        unsigned int height = detail::random_tower_height(max_height);
+        raise_height(height);
+
+        position pos;
+        node * n = NULL;
+
+        for (;;) {
+            if (find_position(key, pos)) {
+                if (n) {
+                    /* the reference of the lowest level cannot be the last one, the inserter still holds its own */
+                    n->references.fetch_sub(1);
+                    release(n);
+                }
+                return false;
+            }
+
+            if (n == NULL) {
+                n = allocate_node(height);
+                if (n == NULL)
+                    return false;
+                n->key = key;
+                n->value = value;
+                height = n->height;
+
+                /* the reference of the lowest level is added once. threads, which have found the node before it has
+                 * been reused, may hold references as well, so the count must never be stored */
+                n->references.fetch_add(1);
+            }
+
+            link * tower = n->tower();
+            for (unsigned int level = 0; level != height; ++level) {
+                const tagged_node_ptr old_link = tower[level].load(memory_order_relaxed);
+                tower[level].store(tagged_node_ptr(pos.succs[level].get_ptr(), old_link.get_tag()),
+                                   memory_order_relaxed);
+            }
+
+            /* the element is inserted, when it is linked on the lowest level */
+            link & pred_link = pos.preds[0]->tower()[0];
+            if (pred_link.compare_exchange_strong(pos.succs[0], tagged_node_ptr(n, pos.succs[0].get_tag() + 2)))
+                break;
+        }
+        size_.fetch_add(1, memory_order_relaxed);
+
+        /* link the upper levels, unless the element is erased concurrently */
+        link * tower = n->tower();
+        for (unsigned int level = 1; level != height; ++level) {
+            for (;;) {
+                tagged_node_ptr own_link = tower[level].load(memory_order_relaxed);
+                if (is_marked(own_link))
+                    goto done;
+
+                node * succ = pos.succs[level].get_ptr();
+                if (own_link.get_ptr() != succ &&
+                    !tower[level].compare_exchange_strong(own_link, tagged_node_ptr(succ, own_link.get_tag() + 2)))
+                    goto done;
+
+                n->references.fetch_add(1);
+                link & pred_link = pos.preds[level]->tower()[level];
+                if (pred_link.compare_exchange_strong(pos.succs[level],
+                                                      tagged_node_ptr(n, pos.succs[level].get_tag() + 2)))
+                    break;
+                n->references.fetch_sub(1);
+
+                if (!find_position(key, pos) || pos.succs[0].get_ptr() != n)
+                    goto done;
+            }
+        }
+
+    done:
+        release(n);
+        return true;
+    }
+
+    /** Erases the element with the given key.
+     *
+     * \returns true, if the element has been erased, false if the key has not been in the map.
+     *
+     * \note Thread-safe and non-blocking
+     * */
+    bool erase(Key const & key)
+    {
+        position pos;
+        node * n;
+
+        for (;;) {
+            tagged_node_ptr next;
+            if (!find_position(key, pos, false, NULL, &next))
+                return false;
+
+            n = pos.succs[0].get_ptr();
+            if (mark(n, next))
+                break;
+        }
+
+        finish_erase(n, key);
+        return true;
+    }
+
+    /** Erases the element with the smallest key.
+     *
+     * If the operation is successful, its key and value are copied to the memory locations denoted by key and ret.
+     *
+     * \returns true, if an element has been erased, false if the map was empty.
+     *
+     * \note Thread-safe and non-blocking
+     * */
+    bool pop_front(Key & key, T & ret)
+    {
+        node * n;
+
+        for (;;) {
+            tagged_node_ptr next;
+            if (!find_first(n, next, key, ret))
+                return false;
+
+            if (mark(n, next))
+                break;
+        }
+
+        finish_erase(n, key);
+        return true;
+    }
+
+    /** Looks up the element with the smallest key.
+     *
+     * If the lookup is successful, its key and value are copied to the memory locations denoted by key and ret.
+     *
+     * \returns true, if the map was not empty.
+     *
+     * \note Thread-safe and non-blocking
+     * */
+    bool front(Key & key, T & ret)
+    {
+        node * n;
+        tagged_node_ptr next;
+        return find_first(n, next, key, ret);
+    }
+
+    /** Looks up the element with the given key.
+     *
+     * If the lookup is successful, the value is copied to memory location denoted by ret.
+     *
+     * \returns true, if the key has been found.
+     *
+     * \note Thread-safe and non-blocking
+     * */
+    bool find(Key const & key, T & ret)
+    {
+        position pos;
+        return find_position(key, pos, false, &ret);
+    }
+
+    /** \returns true, if the key has been found.
+     *
+     * \note Thread-safe and non-blocking
+     * */
+    bool contains(Key const & key)
+    {
+        position pos;
+        return find_position(key, pos);
+    }
+
+    /** Applies f(key, value) to all elements with keys in [first, last[ in ascending order.
+     *
+     * \returns number of visited elements
+     *
+     * \note Thread-safe and non-blocking, if f is non-blocking. Weakly consistent
+     * */
+    template <typename Functor>
+    size_t scan(Key const & first, Key const & last, Functor & f)
+    {
+        return scan_impl<Functor&>(first, last, f);
+    }
+
+    //! \copydoc boost::lockfree::skiplist_map::scan(Key const &, Key const &, Functor &)
+    template <typename Functor>
+    size_t scan(Key const & first, Key const & last, Functor const & f)
+    {
+        return scan_impl<Functor const &>(first, last, f);
+    }
+
+private:
+#ifndef BOOST_DOXYGEN_INVOKED
+    Compare compare_;
+    pool_allocator pool_alloc_;
+    pool_slot * const pools_;
+    node * head_;
+
+    char padding1[BOOST_LOCKFREE_CACHELINE_BYTES]; /* force height_ and size_ to a different cache line */
+    atomic<unsigned int> height_;       /* maximum height of all nodes, which have been inserted */
+    char padding2[BOOST_LOCKFREE_CACHELINE_BYTES - sizeof(atomic<unsigned int>)];
+    atomic<size_t> size_;
+#endif
+};
+
+#ifndef BOOST_DOXYGEN_INVOKED
+namespace detail {
+
+struct skiplist_set_empty
+{};
+
+template <typename Key, typename Functor>
+struct skiplist_set_visitor
+{
+    explicit skiplist_set_visitor(Functor f):
+        f(f)
+    {}
+
+    void operator()(Key const & key, skiplist_set_empty const &) const
+    {
+        f(key);
+    }
+
+    Functor f;
+};
+
+} /* namespace detail */
+#endif
+
+/** The skiplist_set class provides a multi-writer/multi-reader ordered set, lookups, insertions, erasures and range
+ *  scans are lockfree. It is a boost::lockfree::skiplist_map without values.
+ *
+ *  \b Limitation: Key is required to be trivially copyable and trivially destructible.
+ * */
+template <typename Key,
+          typename Compare = std::less<Key>,
+          typename freelist_t = caching_freelist_t,
+          typename Alloc = std::allocator<Key>
+         >
+class skiplist_set:
+    boost::noncopyable
+{
+#ifndef BOOST_DOXYGEN_INVOKED
+    typedef detail::skiplist_set_empty empty_value;
+    typedef skiplist_map<Key, empty_value, Compare, freelist_t, Alloc> map_type;
+#endif
+
+public:
+    typedef Key key_type;
+    typedef Key value_type;
+    typedef Compare key_compare;
+
+    //! \copydoc boost::lockfree::skiplist_map::skiplist_map(size_t, Compare const &)
+    explicit skiplist_set(std::size_t n = 0, Compare const & compare = Compare()):
+        map_(n, compare)
+    {}
+
+    //! \copydoc boost::lockfree::skiplist_map::skiplist_map(size_t, Compare const &, Alloc const &)
+    skiplist_set(std::size_t n, Compare const & compare, Alloc const & alloc):
+        map_(n, compare, alloc)
+    {}
+
+    //! \copydoc boost::lockfree::stack::is_lock_free
+    bool is_lock_free(void) const
+    {
+        return map_.is_lock_free();
+    }
+
+    //! \copydoc boost::lockfree::skiplist_map::size
+    std::size_t size(void) const
+    {
+        return map_.size();
+    }
+
+    //! \copydoc boost::lockfree::skiplist_map::empty
+    bool empty(void) const
+    {
+        return map_.empty();
+    }
+
+    /** Inserts key, unless the set contains it
+     *
+     * \returns true, if the key has been inserted, false if the key has already been in the set or the freelist is
+     *          not able to allocate a new node.
+     *
+     * \note Thread-safe and non-blocking
+     * \warning \b Warning: May block if node needs to be allocated from the operating system
+     * */
+    bool insert(Key const & key)
+    {
+        return map_.insert(key, empty_value());
+    }
+
+    //! \copydoc boost::lockfree::skiplist_map::erase
+    bool erase(Key const & key)
+    {
+        return map_.erase(key);
+    }
+
+    //! \copydoc boost::lockfree::skiplist_map::contains
+    bool contains(Key const & key)
+    {
+        return map_.contains(key);
+    }
+
+    /** Erases the smallest key.
+     *
+     * If the operation is successful, the key is copied to the memory location denoted by key.
+     *
+     * \returns true, if a key has been erased, false if the set was empty.
+     *
+     * \note Thread-safe and non-blocking
+     * */
+    bool pop_front(Key & key)
+    {
+        empty_value ret;
+        return map_.pop_front(key, ret);
+    }
+
+    /** Looks up the smallest key.
+     *
+     * If the lookup is successful, the key is copied to the memory location denoted by key.
+     *
+     * \returns true, if the set was not empty.
+     *
+     * \note Thread-safe and non-blocking
+     * */
+    bool front(Key & key)
+    {
+        empty_value ret;
+        return map_.front(key, ret);
+    }
+
+    /** Applies f(key) to all keys in [first, last[ in ascending order.
+     *
+     * \returns number of visited keys
+     *
+     * \note Thread-safe and non-blocking, if f is non-blocking. Weakly consistent
+     * */
+    template <typename Functor>
+    std::size_t scan(Key const & first, Key const & last, Functor & f)
+    {
+        return map_.scan(first, last, detail::skiplist_set_visitor<Key, Functor&>(f));
+    }
+
+    //! \copydoc boost::lockfree::skiplist_set::scan(Key const &, Key const &, Functor &)
+    template <typename Functor>
+    std::size_t scan(Key const & first, Key const & last, Functor const & f)
+    {
+        return map_.scan(first, last, detail::skiplist_set_visitor<Key, Functor const &>(f));
+    }
+
+private:
+#ifndef BOOST_DOXYGEN_INVOKED
+    map_type map_;
+#endif
+};
+
+} /* namespace lockfree */
+} /* namespace boost */
+
+#endif /* BOOST_LOCKFREE_SKIPLIST_HPP_INCLUDED */
@@ -10,15 +10,15 @@
 #define BOOST_LOCKFREE_STACK_HPP_INCLUDED
 
 #include <boost/checked_delete.hpp>
+#include <boost/move/utility.hpp>
 #include <boost/noncopyable.hpp>
-#include <boost/static_assert.hpp>
-#include <boost/type_traits/has_trivial_assign.hpp>
 #include <boost/type_traits/is_base_of.hpp>
 
 #include <boost/lockfree/detail/atomic.hpp>
 #include <boost/lockfree/detail/freelist.hpp>
 #include <boost/lockfree/detail/tagged_ptr.hpp>
 
+#include <utility>              /* std::forward, std::move */
 
 namespace boost {
 namespace lockfree {
@@ -32,7 +32,8 @@ namespace lockfree {
  *  from the operating system, and struct static_freelist_t uses a fixed-sized freelist. With a fixed-sized
  *  freelist, the push operation may fail, while with a caching freelist, the push operation may block.
  *
- *  \b Limitation: The class T is required to have a trivial assignment operator.
+ *  Objects are constructed in place inside the stack nodes and moved out by the pop operation, so T may be a
+ *  non-trivial or move-only type. Only the thread, which has unlinked a node, accesses its object.
  * */
 template <typename T,
           typename freelist_t = caching_freelist_t,
@@ -42,16 +43,21 @@ class stack:
     boost::noncopyable
 {
 private:
-    BOOST_STATIC_ASSERT(boost::has_trivial_assign<T>::value);
-
 #ifndef BOOST_DOXYGEN_INVOKED
     struct node
     {
         typedef detail::tagged_ptr<node> tagged_node_ptr;
 
-        node(T const & v):
+#if !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES) && !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+        template <typename... ArgumentTypes>
+        explicit node(ArgumentTypes &&... args):
+            v(std::forward<ArgumentTypes>(args)...)
+        {}
+#else
+        explicit node(T const & v):
             v(v)
         {}
+#endif
 
         tagged_node_ptr next;
         T v;
@@ -60,14 +66,46 @@ private:
 
     typedef detail::tagged_ptr<node> tagged_node_ptr;
 
-    typedef typename Alloc::template rebind<node>::other node_allocator;
+    typedef typename detail::rebind_allocator<Alloc, node>::type node_allocator;
 
     typedef typename boost::mpl::if_<boost::is_same<freelist_t, caching_freelist_t>,
                                      detail::freelist_stack<node, true, node_allocator>,
                                      detail::freelist_stack<node, false, node_allocator>
                                      >::type pool_t;
 
+    bool push_node(node * newnode)
+    {
+        if (newnode == 0)
+            return false;
+
+        tagged_node_ptr old_tos = tos.load(detail::memory_order_relaxed);
+
+        for (;;) {
+            tagged_node_ptr new_tos (newnode, old_tos.get_tag());
+            newnode->next.set_ptr(old_tos.get_ptr());
+
+            if (tos.compare_exchange_weak(old_tos, new_tos))
+                return true;
+        }
+    }
+
+    bool push_node_unsafe(node * newnode)
+    {
+        if (newnode == 0)
+            return false;
+
+        tagged_node_ptr old_tos = tos.load(detail::memory_order_relaxed);
+
+        tagged_node_ptr new_tos (newnode, old_tos.get_tag());
+        newnode->next.set_ptr(old_tos.get_ptr());
+
+        tos.store(new_tos, memory_order_relaxed);
+        return true;
+    }
+
 public:
+    typedef T value_type;
+
     /**
      * \return true, if implementation is lock-free.
      * */
@@ -88,6 +126,11 @@ public:
         pool.reserve_unsafe(n);
     }
 
+    //! Construct stack, allocate n nodes for the freelist from alloc
+    stack(std::size_t n, Alloc const & alloc):
+        tos(tagged_node_ptr(NULL, 0)), pool(alloc, n)
+    {}
+
     //! Allocate n nodes for freelist
     void reserve(std::size_t n)
     {
@@ -111,10 +154,11 @@ public:
      * */
     ~stack(void)
     {
-        if (!empty()) {
-            T dummy;
-            while(pop_unsafe(dummy))
-                ;
+        node * n = tos.load(detail::memory_order_relaxed).get_ptr();
+        while (n) {
+            node * next = n->next.get_ptr();
+            pool.destruct_unsafe(n);
+            n = next;
         }
     }
 
@@ -127,20 +171,7 @@ public:
      * */
     bool push(T const & v)
     {
-        node * newnode = pool.construct(v);
-
-        if (newnode == 0)
-            return false;
-
-        tagged_node_ptr old_tos = tos.load(detail::memory_order_relaxed);
-
-        for (;;) {
-            tagged_node_ptr new_tos (newnode, old_tos.get_tag());
-            newnode->next.set_ptr(old_tos.get_ptr());
-
-            if (tos.compare_exchange_weak(old_tos, new_tos))
-                return true;
-        }
+        return push_node(pool.construct(v));
     }
 
     /** Pushes object t to the fifo. May fail, if the freelist is not able to allocate a new fifo node.
@@ -152,24 +183,62 @@ public:
      * */
     bool push_unsafe(T const & v)
     {
-        node * newnode = pool.construct_unsafe(v);
+        return push_node_unsafe(pool.construct_unsafe(v));
+    }
 
-        if (newnode == 0)
-            return false;
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+    /** Moves object t to the stack. May fail, if the freelist is not able to allocate a new stack node.
+     *
+     * \returns true, if the push operation is successful.
+     *
+     * \note Thread-safe and non-blocking
+     * \warning \b Warning: May block if node needs to be allocated from the operating system
+     * */
+    bool push(T && v)
+    {
+        return push_node(pool.construct(std::move(v)));
+    }
 
-        tagged_node_ptr old_tos = tos.load(detail::memory_order_relaxed);
+    /** \copydoc boost::lockfree::stack::push(T && v)
+     *
+     * \note Not thread-safe
+     * */
+    bool push_unsafe(T && v)
+    {
+        return push_node_unsafe(pool.construct_unsafe(std::move(v)));
+    }
+#endif
 
-        tagged_node_ptr new_tos (newnode, old_tos.get_tag());
-        newnode->next.set_ptr(old_tos.get_ptr());
+#if !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES) && !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+    /** Constructs an object from args in place inside a stack node and pushes it. May fail, if the freelist is not
+     *  able to allocate a new stack node.
+     *
+     * \returns true, if the push operation is successful.
+     *
+     * \note Thread-safe and non-blocking
+     * \warning \b Warning: May block if node needs to be allocated from the operating system
+     * */
+    template <typename... ArgumentTypes>
+    bool emplace(ArgumentTypes &&... args)
+    {
+        return push_node(pool.construct(std::forward<ArgumentTypes>(args)...));
+    }
 
-        tos.store(new_tos, memory_order_relaxed);
-        return true;
+    /** \copydoc boost::lockfree::stack::emplace
+     *
+     * \note Not thread-safe
+     * */
+    template <typename... ArgumentTypes>
+    bool emplace_unsafe(ArgumentTypes &&... args)
+    {
+        return push_node_unsafe(pool.construct_unsafe(std::forward<ArgumentTypes>(args)...));
     }
+#endif
 
 
     /** Pops object from stack.
      *
-     * If pop operation is successful, object is written to memory location denoted by ret.
+     * If pop operation is successful, object is moved to memory location denoted by ret.
      *
      * \returns true, if the pop operation is successful, false if stack was empty.
      *
@@ -188,7 +257,7 @@ public:
             tagged_node_ptr new_tos(new_tos_ptr, old_tos.get_tag() + 1);
 
             if (tos.compare_exchange_weak(old_tos, new_tos)) {
-                ret = old_tos->v;
+                ret = boost::move(old_tos->v);
                 pool.destruct(old_tos.get_ptr());
                 return true;
             }
@@ -197,7 +266,7 @@ public:
 
     /** Pops object from stack.
      *
-     * If pop operation is successful, object is written to memory location denoted by ret.
+     * If pop operation is successful, object is moved to memory location denoted by ret.
      *
      * \returns true, if the pop operation is successful, false if stack was empty.
      *
@@ -215,7 +284,7 @@ public:
         tagged_node_ptr new_tos(new_tos_ptr, old_tos.get_tag() + 1);
 
         tos.store(new_tos, memory_order_relaxed);
-        ret = old_tos->v;
+        ret = boost::move(old_tos->v);
         pool.destruct_unsafe(old_tos.get_ptr());
         return true;
     }
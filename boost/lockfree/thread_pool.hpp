@@ -0,0 +1,292 @@
+//  work-stealing thread pool
+//
+//  Copyright (C) 2026 Tim Blechmann
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  Disclaimer: Not a Boost library.
+
+#ifndef BOOST_LOCKFREE_THREAD_POOL_HPP_INCLUDED
+#define BOOST_LOCKFREE_THREAD_POOL_HPP_INCLUDED
+
+#include <boost/bind.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/scoped_array.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <boost/lockfree/detail/atomic.hpp>
+#include <boost/lockfree/detail/branch_hints.hpp>
+#include <boost/lockfree/detail/prefix.hpp>
+#include <boost/lockfree/fifo.hpp>
+#include <boost/lockfree/work_stealing_deque.hpp>
+
+#include <cstddef>              /* for std::size_t */
+
+#ifndef BOOST_LOCKFREE_THREAD_LOCAL
+#error "boost/lockfree/thread_pool.hpp requires thread-local storage"
+#endif
+
+namespace boost {
+namespace lockfree {
+namespace detail {
+
+struct pool_task
+{
+    virtual void run(void) = 0;
+    virtual ~pool_task(void) {}
+};
+
+template <typename Functor>
+struct pool_task_impl:
+    pool_task
+{
+    explicit pool_task_impl(Functor const & f):
+        f(f)
+    {}
+
+    void run(void)
+    {
+        f();
+    }
+
+    Functor f;
+};
+
+} /* namespace detail */
+
+/** The thread_pool class provides an executor, which runs function objects on a fixed number of worker threads.
+ *
+ *  - Every worker owns a boost::lockfree::work_stealing_deque. Tasks, which are submitted from a worker thread, are
+ *    pushed to the deque of this worker and executed in lifo order.
+ *  - Tasks, which are submitted from other threads, are enqueued to a global injection queue (a
+ *    boost::lockfree::fifo).
+ *  - A worker without local tasks takes tasks from the injection queue, then steals from the other workers.
+ *  - Idle workers spin for a while, before they park on a condition variable. Submitting a task only locks the mutex
+ *    of the condition variable, if a worker is parked.
+ *
+ *  The destructor executes all remaining tasks and joins the workers.
+ *
+ *  \b Requirements: Functor must be copy-constructible and callable without arguments. Tasks must not throw.
+ * */
+class thread_pool:
+    boost::noncopyable
+{
+#ifndef BOOST_DOXYGEN_INVOKED
+    typedef std::size_t size_t;
+    typedef detail::pool_task task;
+
+    enum {
+        spin_count = 64,
+        initial_deque_size = 256
+    };
+
+    struct BOOST_LOCKFREE_CACHELINE_ALIGNMENT worker
+    {
+        worker(void):
+            pool(NULL), index(0), tasks(initial_deque_size)
+        {}
+
+        thread_pool * pool;
+        size_t index;
+        work_stealing_deque<task*> tasks;
+    };
+
+    static worker *& current_worker(void)
+    {
+        static BOOST_LOCKFREE_THREAD_LOCAL worker * current = NULL;
+        return current;
+    }
+
+    /* returns the worker of the calling thread, if it belongs to this pool */
+    worker * local_worker(void)
+    {
+        worker * w = current_worker();
+        return (w && w->pool == this) ? w : NULL;
+    }
+
+    template <typename Functor>
+    static task * make_task(Functor const & f)
+    {
+        return new detail::pool_task_impl<Functor>(f);
+    }
+
+    /* pending_ is incremented before the task is pushed, so it never underestimates the number of queued tasks */
+    void push(task * t, worker * w)
+    {
+        pending_.fetch_add(1, memory_order_relaxed);
+        if (w)
+            w->tasks.push(t);
+        else
+            while (!injection_.enqueue(t))
+                ;
+    }
+
+    /* a parking worker increments sleeping_ and then checks pending_, a submitting thread increments pending_ and
+     * then checks sleeping_. with sequential consistency, one of them observes the other */
+    void wake(size_t count)
+    {
+        atomic_thread_fence(memory_order_seq_cst);
+        if (likely(sleeping_.load(memory_order_relaxed) == 0))
+            return;
+
+        boost::mutex::scoped_lock lock(mutex_);
+        if (count == 1)
+            wakeup_.notify_one();
+        else
+            wakeup_.notify_all();
+    }
+
+    bool find_task(worker & w, task *& t)
+    {
+        if (w.tasks.pop(t))
+            return true;
+        if (injection_.dequeue(t))
+            return true;
+
+        for (size_t i = 1; i != worker_count_; ++i) {
+            size_t victim = w.index + i;
+            if (victim >= worker_count_)
+                victim -= worker_count_;
+            if (workers_[victim].tasks.steal(t))
+                return true;
+        }
+        return false;
+    }
+
+    bool has_tasks(void)
+    {
+        return pending_.load(memory_order_relaxed) != 0;
+    }
+
+    void run(size_t index)
+    {
+        worker & w = workers_[index];
+        current_worker() = &w;
+
+        for (;;) {
+            task * t;
+            bool found = false;
+            for (int i = 0; i != spin_count; ++i) {
+                if (find_task(w, t)) {
+                    found = true;
+                    break;
+                }
+                boost::this_thread::yield();
+            }
+
+            if (found) {
+                pending_.fetch_sub(1, memory_order_relaxed);
+                t->run();
+                delete t;
+                continue;
+            }
+
+            boost::mutex::scoped_lock lock(mutex_);
+            sleeping_.fetch_add(1, memory_order_relaxed);
+            atomic_thread_fence(memory_order_seq_cst);
+            if (!has_tasks()) {
+                if (stop_.load(memory_order_relaxed)) {
+                    sleeping_.fetch_sub(1, memory_order_relaxed);
+                    break;
+                }
+                wakeup_.wait(lock);
+            }
+            sleeping_.fetch_sub(1, memory_order_relaxed);
+        }
+
+        current_worker() = NULL;
+    }
+#endif
+
+public:
+    /** Construct thread_pool and start the given number of worker threads
+     *
+     * \pre workers must be at least 1
+     * */
+    explicit thread_pool(size_t workers = boost::thread::hardware_concurrency()):
+        worker_count_(workers ? workers : 1), workers_(new worker[worker_count_]), injection_(128), sleeping_(0),
+        stop_(false), pending_(0)
+    {
+        for (size_t i = 0; i != worker_count_; ++i) {
+            workers_[i].pool = this;
+            workers_[i].index = i;
+        }
+
+        for (size_t i = 0; i != worker_count_; ++i)
+            threads_.create_thread(boost::bind(&thread_pool::run, this, i));
+    }
+
+    //! Executes all remaining tasks and joins the worker threads
+    ~thread_pool(void)
+    {
+        {
+            boost::mutex::scoped_lock lock(mutex_);
+            stop_.store(true, memory_order_relaxed);
+            wakeup_.notify_all();
+        }
+        threads_.join_all();
+    }
+
+    //! \returns number of worker threads
+    size_t workers(void) const
+    {
+        return worker_count_;
+    }
+
+    /** Submits f for execution
+     *
+     * \note Thread-safe and non-blocking, unless a parked worker needs to be woken up
+     * \warning \b Warning: May block if memory needs to be allocated from the operating system
+     * */
+    template <typename Functor>
+    void submit(Functor const & f)
+    {
+        push(make_task(f), local_worker());
+        wake(1);
+    }
+
+    /** Submits all function objects of the range [first, last[ for execution. Parked workers are woken up once for
+     *  the whole batch.
+     *
+     * \note Thread-safe and non-blocking, unless parked workers need to be woken up
+     * \warning \b Warning: May block if memory needs to be allocated from the operating system
+     * */
+    template <typename InputIterator>
+    void submit(InputIterator first, InputIterator last)
+    {
+        worker * w = local_worker();
+        size_t count = 0;
+        for (; first != last; ++first, ++count)
+            push(make_task(*first), w);
+
+        if (count)
+            wake(count);
+    }
+
+private:
+#ifndef BOOST_DOXYGEN_INVOKED
+    const size_t worker_count_;
+    boost::scoped_array<worker> workers_;
+    fifo<task*> injection_;
+
+    char padding1[BOOST_LOCKFREE_CACHELINE_BYTES];
+    atomic<size_t> sleeping_;
+    atomic<bool> stop_;
+    char padding2[BOOST_LOCKFREE_CACHELINE_BYTES];
+    atomic<size_t> pending_;            /* number of submitted tasks, which have not been taken by a worker */
+    char padding3[BOOST_LOCKFREE_CACHELINE_BYTES];
+
+    boost::mutex mutex_;
+    boost::condition_variable wakeup_;
+    boost::thread_group threads_;
+#endif
+};
+
+} /* namespace lockfree */
+} /* namespace boost */
+
+#endif /* BOOST_LOCKFREE_THREAD_POOL_HPP_INCLUDED */
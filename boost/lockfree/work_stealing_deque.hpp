@@ -0,0 +1,255 @@
+//  lock-free work-stealing deque from
+//  Chase, D. and Lev, Y.,
+//  "dynamic circular work-stealing deque"
+//
+//  memory orderings from
+//  Le, N. M., Pop, A., Cohen, A. and Zappa Nardelli, F.,
+//  "correct and efficient work-stealing for weak memory models"
+//
+//  Copyright (C) 2026 Tim Blechmann
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  Disclaimer: Not a Boost library.
+
+#ifndef BOOST_LOCKFREE_WORK_STEALING_DEQUE_HPP_INCLUDED
+#define BOOST_LOCKFREE_WORK_STEALING_DEQUE_HPP_INCLUDED
+
+#include <boost/noncopyable.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/type_traits/has_trivial_assign.hpp>
+#include <boost/type_traits/has_trivial_copy.hpp>
+#include <boost/type_traits/has_trivial_destructor.hpp>
+
+#include <boost/lockfree/detail/atomic.hpp>
+#include <boost/lockfree/detail/branch_hints.hpp>
+#include <boost/lockfree/detail/freelist.hpp>
+#include <boost/lockfree/detail/prefix.hpp>
+
+#include <cstddef>              /* for std::size_t, std::ptrdiff_t */
+#include <memory>               /* for std::allocator */
+
+namespace boost {
+namespace lockfree {
+
+/** The work_stealing_deque class provides a single-owner/multi-thief deque for task schedulers.
+ *
+ *  The owner thread pushes and pops objects at the bottom of the deque in lifo order. Other threads steal objects from
+ *  the top of the deque in fifo order. push() and pop() do not need a CAS on the fast path, only pop() of the last
+ *  object and steal() use a CAS on the top index. Popping and stealing is lockfree.
+ *
+ *  The objects are stored in a circular array, which is doubled, when it is full. Thieves may still read from the old
+ *  array, so old arrays are only freed, when the deque is destroyed. The memory overhead is bounded by the size of the
+ *  current array.
+ *
+ *  \b Limitation: The class T is required to be trivially copyable and trivially destructible, e.g. a pointer to a
+ *                 task. A thief may copy an object, which is overwritten concurrently, before its CAS fails.
+ * */
+template <typename T, typename Alloc = std::allocator<T> >
+class work_stealing_deque:
+    boost::noncopyable
+{
+#ifndef BOOST_DOXYGEN_INVOKED
+    BOOST_STATIC_ASSERT(boost::has_trivial_assign<T>::value);
+    BOOST_STATIC_ASSERT(boost::has_trivial_copy<T>::value);
+    BOOST_STATIC_ASSERT(boost::has_trivial_destructor<T>::value);
+
+    typedef std::size_t size_t;
+    typedef std::ptrdiff_t index_t;
+
+    /* the slots follow the header in the same allocation */
+    struct array
+    {
+        size_t mask;
+        array * previous;
+
+        T * slots(void)
+        {
+            return reinterpret_cast<T*>(reinterpret_cast<char*>(this) + header_bytes());
+        }
+
+        T & operator[](index_t i)
+        {
+            return slots()[size_t(i) & mask];
+        }
+
+        size_t capacity(void) const
+        {
+            return mask + 1;
+        }
+    };
+
+    typedef typename detail::rebind_allocator<Alloc, char>::type byte_allocator;
+
+    static size_t header_bytes(void)
+    {
+        const size_t alignment = boost::alignment_of<T>::value;
+        return (sizeof(array) + alignment - 1) / alignment * alignment;
+    }
+
+    static size_t array_bytes(size_t capacity)
+    {
+        return header_bytes() + capacity * sizeof(T);
+    }
+
+    array * allocate_array(size_t capacity, array * previous)
+    {
+        array * ret = reinterpret_cast<array*>(alloc_.allocate(array_bytes(capacity)));
+        ret->mask = capacity - 1;
+        ret->previous = previous;
+        return ret;
+    }
+
+    /* only called by the owner */
+    array * grow(array * a, index_t bottom, index_t top)
+    {
+        array * ret = allocate_array(2 * a->capacity(), a);
+        for (index_t i = top; i != bottom; ++i)
+            (*ret)[i] = (*a)[i];
+        array_.store(ret, memory_order_release);
+        return ret;
+    }
+
+    static size_t round_up_to_power_of_two(size_t n)
+    {
+        size_t ret = 2;
+        while (ret < n)
+            ret *= 2;
+        return ret;
+    }
+#endif
+
+public:
+    typedef T value_type;
+
+    //! Construct work_stealing_deque with an initial capacity of at least n objects
+    explicit work_stealing_deque(size_t n = 64):
+        top_(0), bottom_(0)
+    {
+        array_.store(allocate_array(round_up_to_power_of_two(n), NULL), memory_order_relaxed);
+    }
+
+    //! Construct work_stealing_deque with an initial capacity of at least n objects, allocating its storage from alloc
+    work_stealing_deque(size_t n, Alloc const & alloc):
+        alloc_(alloc), top_(0), bottom_(0)
+    {
+        array_.store(allocate_array(round_up_to_power_of_two(n), NULL), memory_order_relaxed);
+    }
+
+    //! Destroys the work_stealing_deque and frees all arrays
+    ~work_stealing_deque(void)
+    {
+        array * a = array_.load(memory_order_relaxed);
+        while (a) {
+            array * previous = a->previous;
+            alloc_.deallocate(reinterpret_cast<char*>(a), array_bytes(a->capacity()));
+            a = previous;
+        }
+    }
+
+    //! \copydoc boost::lockfree::stack::is_lock_free
+    bool is_lock_free(void) const
+    {
+        return top_.is_lock_free() && bottom_.is_lock_free() && array_.is_lock_free();
+    }
+
+    /** Check if the deque is empty
+     *
+     * \warning Not thread-safe, use for debugging purposes only
+     * */
+    bool empty(void)
+    {
+        return bottom_.load(memory_order_relaxed) <= top_.load(memory_order_relaxed);
+    }
+
+    /** Pushes object t to the bottom of the deque.
+     *
+     * \note Only to be called from the owner thread. Wait-free, unless the array needs to grow
+     * \warning \b Warning: May block if the array needs to be allocated from the operating system
+     * */
+    void push(T const & t)
+    {
+        const index_t bottom = bottom_.load(memory_order_relaxed);
+        const index_t top = top_.load(memory_order_acquire);
+        array * a = array_.load(memory_order_relaxed);
+
+        if (unlikely(bottom - top > index_t(a->capacity()) - 1))
+            a = grow(a, bottom, top);
+
+        (*a)[bottom] = t;
+        atomic_thread_fence(memory_order_release);
+        bottom_.store(bottom + 1, memory_order_relaxed);
+    }
+
+    /** Pops the object from the bottom of the deque, which has been pushed last.
+     *
+     * \returns true, if the pop operation is successful, false if the deque was empty.
+     *
+     * \note Only to be called from the owner thread. Lock-free
+     * */
+    bool pop(T & ret)
+    {
+        const index_t bottom = bottom_.load(memory_order_relaxed) - 1;
+        array * a = array_.load(memory_order_relaxed);
+        bottom_.store(bottom, memory_order_relaxed);
+        atomic_thread_fence(memory_order_seq_cst);
+        index_t top = top_.load(memory_order_relaxed);
+
+        if (unlikely(top > bottom)) {
+            /* empty */
+            bottom_.store(bottom + 1, memory_order_relaxed);
+            return false;
+        }
+
+        ret = (*a)[bottom];
+        if (likely(top != bottom))
+            return true;
+
+        /* last object: race against thieves */
+        const bool success = top_.compare_exchange_strong(top, top + 1, memory_order_seq_cst, memory_order_relaxed);
+        bottom_.store(bottom + 1, memory_order_relaxed);
+        return success;
+    }
+
+    /** Steals the object from the top of the deque, which has been pushed first.
+     *
+     * \returns true, if the steal operation is successful, false if the deque was empty or another thread has popped
+     *          or stolen the object concurrently.
+     *
+     * \note Thread-safe and non-blocking
+     * */
+    bool steal(T & ret)
+    {
+        index_t top = top_.load(memory_order_acquire);
+        atomic_thread_fence(memory_order_seq_cst);
+        const index_t bottom = bottom_.load(memory_order_acquire);
+
+        if (top >= bottom)
+            return false;
+
+        array * a = array_.load(memory_order_consume);
+        T t = (*a)[top];
+        if (!top_.compare_exchange_strong(top, top + 1, memory_order_seq_cst, memory_order_relaxed))
+            return false;
+
+        ret = t;
+        return true;
+    }
+
+private:
+#ifndef BOOST_DOXYGEN_INVOKED
+    byte_allocator alloc_;
+    atomic<index_t> top_;
+    char padding1[BOOST_LOCKFREE_CACHELINE_BYTES - sizeof(atomic<index_t>)]; /* force top_ and bottom_ to different cache lines */
+    atomic<index_t> bottom_;
+    atomic<array*> array_;
+#endif
+};
+
+} /* namespace lockfree */
+} /* namespace boost */
+
+#endif /* BOOST_LOCKFREE_WORK_STEALING_DEQUE_HPP_INCLUDED */
@@ -273,7 +273,38 @@ public:
 		value and returns its old value.
 	*/
 	Type exchange(Type value, memory_order order=memory_order_seq_cst);
-	
+
+	/**
+		\brief Block until the value changes
+		\param old Value, which is expected to change
+		\param order Memory ordering constraint of the loads, see \ref memory_order
+
+		Blocks the calling thread, while the value of the variable is
+		equal to @c old. A thread, which modifies the variable, has to call
+		\ref notify_one or \ref notify_all to wake the waiting threads.
+		On Linux, threads sleep on a futex, on other platforms they
+		poll the value with an increasing backoff.
+
+		This method is available only if \c Type is an integral type.
+	*/
+	void wait(Type old, memory_order order=memory_order_seq_cst) const;
+	/**
+		\brief Wake one thread, which waits for a change of the value
+
+		Wakes at least one thread, which is blocked in \ref wait on
+		this variable. Does not enter the kernel, if no thread waits
+		on a variable, which shares its waiter count.
+
+		This method is available only if \c Type is an integral type.
+	*/
+	void notify_one();
+	/**
+		\brief Wake all threads, which wait for a change of the value
+
+		This method is available only if \c Type is an integral type.
+	*/
+	void notify_all();
+
 	/**
 		\brief Atomically add and return old value
 		\param operand Operand
@@ -0,0 +1,260 @@
+//  measures load, store, exchange, compare_exchange_strong and fetch_add of
+//  atomic<T> for every integral size and every memory order, which is valid
+//  for the operation. each operation is measured with a single thread
+//  (uncontended) and with several threads, which operate on the same object
+//  (contended). if the compiler supports c++11, std::atomic is measured as well.
+//
+//  the backend of boost::atomic is selected at compile time, the build creates
+//  one executable for each backend, e.g. via BOOST_ATOMIC_USE_FALLBACK,
+//  BOOST_ATOMIC_USE_GENERIC_CAS or BOOST_ATOMIC_USE_GCC_ATOMIC.
+//
+//  the results are written to stdout as csv, one line per measurement. the
+//  latency is the time of one operation of one thread, the throughput is the
+//  number of operations of all threads per second.
+//
+//  usage: bench_atomic [threads] [iterations], defaults to the number of
+//  hardware threads, but at least 2, and 1000000 iterations per thread
+
+#include <boost/atomic.hpp>
+#include <boost/bind.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/thread.hpp>
+
+#include <algorithm>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#if __cplusplus >= 201103L
+#include <atomic>
+#define BENCH_STD_ATOMIC
+#endif
+
+using boost::memory_order;
+using boost::memory_order_relaxed;
+using boost::memory_order_consume;
+using boost::memory_order_acquire;
+using boost::memory_order_release;
+using boost::memory_order_acq_rel;
+using boost::memory_order_seq_cst;
+
+static long iterations = 1000000;
+static volatile unsigned long sink;
+
+/* the backend of the implementation, which is measured */
+static const char * backend;
+
+static const char * backend_name(void)
+{
+#if defined(BOOST_ATOMIC_USE_FALLBACK)
+	return "fallback";
+#elif defined(BOOST_DETAIL_ATOMIC_GENERIC_CAS_HPP)
+	return "generic-cas";
+#elif defined(BOOST_DETAIL_ATOMIC_GCC_ATOMIC_HPP)
+	return "gcc-atomic";
+#elif defined(BOOST_DETAIL_ATOMIC_GCC_X86_HPP)
+	return "gcc-x86";
+#elif defined(BOOST_DETAIL_ATOMIC_GCC_PPC_HPP)
+	return "gcc-ppc";
+#elif defined(BOOST_DETAIL_ATOMIC_GCC_ALPHA_HPP)
+	return "gcc-alpha";
+#elif defined(BOOST_DETAIL_ATOMIC_GCC_ARMV6P_HPP)
+	return "gcc-armv6+";
+#elif defined(BOOST_DETAIL_ATOMIC_LINUX_ARM_HPP)
+	return "linux-arm";
+#elif defined(BOOST_DETAIL_ATOMIC_INTERLOCKED_HPP)
+	return "interlocked";
+#else
+	return "unknown";
+#endif
+}
+
+static const char * order_name(memory_order order)
+{
+	switch(order) {
+		case memory_order_relaxed: return "relaxed";
+		case memory_order_consume: return "consume";
+		case memory_order_acquire: return "acquire";
+		case memory_order_release: return "release";
+		case memory_order_acq_rel: return "acq_rel";
+		default: return "seq_cst";
+	}
+}
+
+/* the memory orders are template arguments, so the conversion is folded at
+compile time and the operations are not sequentially consistent by accident */
+template<typename T>
+memory_order convert(const boost::atomic<T> &, memory_order order)
+{
+	return order;
+}
+
+#ifdef BENCH_STD_ATOMIC
+template<typename T>
+std::memory_order convert(const std::atomic<T> &, memory_order order)
+{
+	switch(order) {
+		case memory_order_relaxed: return std::memory_order_relaxed;
+		case memory_order_consume: return std::memory_order_consume;
+		case memory_order_acquire: return std::memory_order_acquire;
+		case memory_order_release: return std::memory_order_release;
+		case memory_order_acq_rel: return std::memory_order_acq_rel;
+		default: return std::memory_order_seq_cst;
+	}
+}
+#endif
+
+template<memory_order Order>
+struct load_op {
+	static const char * name(void) {return "load";}
+	static memory_order order(void) {return Order;}
+
+	template<typename Atomic, typename T>
+	static void run(Atomic & a, T & sum) {sum += a.load(convert(a, Order));}
+};
+
+template<memory_order Order>
+struct store_op {
+	static const char * name(void) {return "store";}
+	static memory_order order(void) {return Order;}
+
+	template<typename Atomic, typename T>
+	static void run(Atomic & a, T & sum) {a.store(sum, convert(a, Order));}
+};
+
+template<memory_order Order>
+struct exchange_op {
+	static const char * name(void) {return "exchange";}
+	static memory_order order(void) {return Order;}
+
+	template<typename Atomic, typename T>
+	static void run(Atomic & a, T & sum) {sum += a.exchange(sum, convert(a, Order));}
+};
+
+/* increments the value, under contention some of the operations fail */
+template<memory_order Order>
+struct compare_exchange_op {
+	static const char * name(void) {return "compare_exchange";}
+	static memory_order order(void) {return Order;}
+
+	template<typename Atomic, typename T>
+	static void run(Atomic & a, T & sum)
+	{
+		T expected = a.load(convert(a, memory_order_relaxed));
+		sum += a.compare_exchange_strong(expected, T(expected + 1), convert(a, Order));
+	}
+};
+
+template<memory_order Order>
+struct fetch_add_op {
+	static const char * name(void) {return "fetch_add";}
+	static memory_order order(void) {return Order;}
+
+	template<typename Atomic, typename T>
+	static void run(Atomic & a, T & sum) {sum += a.fetch_add(1, convert(a, Order));}
+};
+
+/* each thread records the time of its first and of its last operation, the
+main thread may not be scheduled before the workers finish */
+struct interval {
+	boost::posix_time::ptime begin, end;
+};
+
+template<typename Operation, typename Atomic, typename T>
+void worker(Atomic * a, boost::barrier * start, interval * time)
+{
+	T sum = 0;
+	start->wait();
+	time->begin = boost::posix_time::microsec_clock::universal_time();
+	for (long i = 0; i != iterations; ++i)
+		Operation::run(*a, sum);
+	time->end = boost::posix_time::microsec_clock::universal_time();
+	sink += sum;
+}
+
+template<typename Operation, template<typename> class Atomic, typename T>
+void measure(const char * implementation, const char * type, int threads)
+{
+	Atomic<T> a(0);
+	std::vector<interval> times(threads);
+	boost::barrier start(threads);
+	boost::thread_group group;
+	for (int i = 0; i != threads; ++i)
+		group.create_thread(boost::bind(&worker<Operation, Atomic<T>, T>, &a, &start, &times[i]));
+	group.join_all();
+
+	boost::posix_time::ptime begin = times[0].begin, end = times[0].end;
+	for (int i = 1; i != threads; ++i) {
+		begin = std::min(begin, times[i].begin);
+		end = std::max(end, times[i].end);
+	}
+	double elapsed = (end - begin).total_microseconds() * 1e3;
+	if (elapsed < 1)
+		elapsed = 1;
+
+	printf("%s,%s,%s,%s,%s,%d,%.3f,%.3f\n", implementation, backend, type, Operation::name(),
+		order_name(Operation::order()), threads, elapsed / iterations, double(iterations) * threads / elapsed * 1e3);
+	fflush(stdout);
+}
+
+/* read-modify-write operations support all memory orders */
+template<template<memory_order> class Operation, template<typename> class Atomic, typename T>
+void measure_all_orders(const char * implementation, const char * type, int threads)
+{
+	measure<Operation<memory_order_relaxed>, Atomic, T>(implementation, type, threads);
+	measure<Operation<memory_order_consume>, Atomic, T>(implementation, type, threads);
+	measure<Operation<memory_order_acquire>, Atomic, T>(implementation, type, threads);
+	measure<Operation<memory_order_release>, Atomic, T>(implementation, type, threads);
+	measure<Operation<memory_order_acq_rel>, Atomic, T>(implementation, type, threads);
+	measure<Operation<memory_order_seq_cst>, Atomic, T>(implementation, type, threads);
+}
+
+template<template<typename> class Atomic, typename T>
+void measure_type(const char * implementation, const char * type, int threads)
+{
+	measure<load_op<memory_order_relaxed>, Atomic, T>(implementation, type, threads);
+	measure<load_op<memory_order_consume>, Atomic, T>(implementation, type, threads);
+	measure<load_op<memory_order_acquire>, Atomic, T>(implementation, type, threads);
+	measure<load_op<memory_order_seq_cst>, Atomic, T>(implementation, type, threads);
+
+	measure<store_op<memory_order_relaxed>, Atomic, T>(implementation, type, threads);
+	measure<store_op<memory_order_release>, Atomic, T>(implementation, type, threads);
+	measure<store_op<memory_order_seq_cst>, Atomic, T>(implementation, type, threads);
+
+	measure_all_orders<exchange_op, Atomic, T>(implementation, type, threads);
+	measure_all_orders<compare_exchange_op, Atomic, T>(implementation, type, threads);
+	measure_all_orders<fetch_add_op, Atomic, T>(implementation, type, threads);
+}
+
+template<template<typename> class Atomic>
+void measure_implementation(const char * implementation, int threads)
+{
+	measure_type<Atomic, boost::uint8_t>(implementation, "uint8", threads);
+	measure_type<Atomic, boost::uint16_t>(implementation, "uint16", threads);
+	measure_type<Atomic, boost::uint32_t>(implementation, "uint32", threads);
+	measure_type<Atomic, boost::uint64_t>(implementation, "uint64", threads);
+}
+
+int main(int argc, char * argv[])
+{
+	int threads = argc > 1 ? atoi(argv[1]) : boost::thread::hardware_concurrency();
+	if (threads < 2)
+		threads = 2;
+	if (argc > 2)
+		iterations = atol(argv[2]);
+	if (iterations < 1)
+		iterations = 1;
+
+	printf("implementation,backend,type,operation,order,threads,latency_ns,throughput_mops\n");
+	backend = backend_name();
+	measure_implementation<boost::atomic>("boost::atomic", 1);
+	measure_implementation<boost::atomic>("boost::atomic", threads);
+#ifdef BENCH_STD_ATOMIC
+	backend = "compiler";
+	measure_implementation<std::atomic>("std::atomic", 1);
+	measure_implementation<std::atomic>("std::atomic", threads);
+#endif
+	return 0;
+}
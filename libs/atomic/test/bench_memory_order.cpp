@@ -0,0 +1,134 @@
+//  measures the latency of the operations of atomic<int> for each memory order
+//  and of atomic_thread_fence in a single thread, i.e. without contention.
+//  on x86, the fence instructions mfence and "lock; or" are measured as well.
+//
+//  usage: bench_memory_order [iterations], defaults to 10000000
+
+#include <boost/atomic.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace boost;
+
+static const char * order_name(memory_order order)
+{
+	switch(order) {
+		case memory_order_relaxed: return "relaxed";
+		case memory_order_consume: return "consume";
+		case memory_order_acquire: return "acquire";
+		case memory_order_release: return "release";
+		case memory_order_acq_rel: return "acq_rel";
+		default: return "seq_cst";
+	}
+}
+
+static long iterations = 10000000;
+
+static atomic<int> value(0);
+static volatile int sink;
+
+template<typename Operation>
+double measure(Operation op)
+{
+	posix_time::ptime begin = posix_time::microsec_clock::universal_time();
+	for (long i = 0; i != iterations; ++i)
+		op();
+	posix_time::ptime end = posix_time::microsec_clock::universal_time();
+	return (end - begin).total_microseconds() * 1e3 / iterations;
+}
+
+template<memory_order Order>
+struct load_op {
+	void operator()(void) const {sink += value.load(Order);}
+};
+
+template<memory_order Order>
+struct store_op {
+	void operator()(void) const {value.store(1, Order);}
+};
+
+template<memory_order Order>
+struct exchange_op {
+	void operator()(void) const {sink += value.exchange(1, Order);}
+};
+
+template<memory_order Order>
+struct fetch_add_op {
+	void operator()(void) const {sink += value.fetch_add(1, Order);}
+};
+
+template<memory_order Order>
+struct compare_exchange_op {
+	void operator()(void) const
+	{
+		int expected = value.load(memory_order_relaxed);
+		sink += value.compare_exchange_strong(expected, expected + 1, Order);
+	}
+};
+
+template<memory_order Order>
+struct fence_op {
+	void operator()(void) const {atomic_thread_fence(Order);}
+};
+
+/* loads and stores are only defined for some of the memory orders, none marks
+the others */
+struct none {};
+
+template<typename Operation>
+void print(Operation op)
+{
+	printf("  %8.2f", measure(op));
+}
+
+static void print(none)
+{
+	printf("  %8s", "n/a");
+}
+
+template<memory_order Order, typename Load, typename Store>
+void run(Load load, Store store)
+{
+	printf("%-8s", order_name(Order));
+	print(load);
+	print(store);
+	printf("  %8.2f  %9.2f  %8.2f  %8.2f\n",
+		measure(exchange_op<Order>()),
+		measure(fetch_add_op<Order>()),
+		measure(compare_exchange_op<Order>()),
+		measure(fence_op<Order>()));
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__amd64__))
+struct mfence_op {
+	void operator()(void) const {__asm__ __volatile__("mfence" ::: "memory");}
+};
+
+struct locked_or_op {
+	void operator()(void) const {__asm__ __volatile__("lock; orq $0, (%%rsp)" ::: "memory", "cc");}
+};
+#endif
+
+int main(int argc, char * argv[])
+{
+	if (argc > 1)
+		iterations = atol(argv[1]);
+	if (iterations < 1)
+		iterations = 1;
+
+	printf("atomic<int>, ns/operation, lock-free: %d\n\n", (int)value.is_lock_free());
+	printf("order         load     store  exchange  fetch_add       cas     fence\n");
+	run<memory_order_relaxed>(load_op<memory_order_relaxed>(), store_op<memory_order_relaxed>());
+	run<memory_order_consume>(load_op<memory_order_consume>(), none());
+	run<memory_order_acquire>(load_op<memory_order_acquire>(), none());
+	run<memory_order_release>(none(), store_op<memory_order_release>());
+	run<memory_order_acq_rel>(none(), none());
+	run<memory_order_seq_cst>(load_op<memory_order_seq_cst>(), store_op<memory_order_seq_cst>());
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__amd64__))
+	printf("\nmfence: %.2f ns, lock or: %.2f ns\n", measure(mfence_op()), measure(locked_or_op()));
+#endif
+	return 0;
+}
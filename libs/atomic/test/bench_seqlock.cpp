@@ -0,0 +1,101 @@
+//  measures the throughput of loads from a 48 byte atomic<T>, which is
+//  implemented via the spinlock pool and as a seqlock, with an increasing
+//  number of reader threads and one writer thread, which stores a new value
+//  after every 1000 iterations of a delay loop. the readers check that they
+//  never observe a torn value.
+//
+//  usage: bench_seqlock [max_readers], defaults to the number of hardware threads
+
+#include <boost/atomic.hpp>
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/thread.hpp>
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace boost;
+
+static const long loads_per_reader = 2000000;
+
+template<int Tag>
+struct Config {
+	long v[6];
+};
+
+typedef Config<0> SpinlockConfig;
+typedef Config<1> SeqlockConfig;
+
+namespace boost {
+template<>
+struct atomic_use_seqlock<SeqlockConfig> : public true_type {};
+}
+
+template<typename T>
+void reader(atomic<T> * config, barrier * start)
+{
+	start->wait();
+	for (long i = 0; i != loads_per_reader; ++i) {
+		T c = config->load(memory_order_acquire);
+		for (int j = 1; j != 6; ++j)
+			assert(c.v[j] == c.v[0]);
+		(void)c;
+	}
+}
+
+template<typename T>
+void writer(atomic<T> * config, atomic<bool> * running, barrier * start)
+{
+	start->wait();
+	long n = 0;
+	while (running->load(memory_order_relaxed)) {
+		++n;
+		T c;
+		for (int j = 0; j != 6; ++j)
+			c.v[j] = n;
+		config->store(c, memory_order_release);
+		for (volatile int delay = 0; delay != 1000; ++delay)
+			;
+	}
+}
+
+template<typename T>
+double run(int readers)
+{
+	T initial = {{0, 0, 0, 0, 0, 0}};
+	atomic<T> config(initial);
+	atomic<bool> running(true);
+
+	barrier start(readers + 2);
+	thread_group reader_threads;
+	for (int i = 0; i != readers; ++i)
+		reader_threads.create_thread(bind(&reader<T>, &config, &start));
+	thread writer_thread(bind(&writer<T>, &config, &running, &start));
+
+	start.wait();
+	posix_time::ptime begin = posix_time::microsec_clock::universal_time();
+	reader_threads.join_all();
+	double elapsed = (posix_time::microsec_clock::universal_time() - begin).total_microseconds() * 1e-6;
+
+	running = false;
+	writer_thread.join();
+	return double(loads_per_reader) * readers / elapsed * 1e-6;
+}
+
+int main(int argc, char * argv[])
+{
+	int max_readers = argc > 1 ? atoi(argv[1]) : thread::hardware_concurrency();
+	if (max_readers < 1)
+		max_readers = 1;
+
+	printf("readers    spinlock Mloads/s    seqlock Mloads/s\n");
+	for (int readers = 1;; readers = (readers * 2 < max_readers) ? readers * 2 : max_readers) {
+		double spinlock = run<SpinlockConfig>(readers);
+		double seqlock = run<SeqlockConfig>(readers);
+		printf("%7d    %17.2f    %16.2f\n", readers, spinlock, seqlock);
+
+		if (readers == max_readers)
+			break;
+	}
+}
@@ -1,6 +1,7 @@
 #include <typeinfo>
 #include <boost/atomic.hpp>
 #include <stdio.h>
+#include <string.h>
 
 #include <assert.h>
 
@@ -127,6 +128,21 @@ void test_atomic_ptr(void)
 	p=--ptr;
 	assert(p==&array[0]);
 	assert(ptr==&array[0]);
+	
+	p=(ptr+=5);
+	assert(p==&array[5]);
+	assert(ptr==&array[5]);
+	p=(ptr-=3);
+	assert(p==&array[2]);
+	assert(ptr==&array[2]);
+	
+	/* negative operands */
+	p=ptr.fetch_add(-2);
+	assert(p==&array[2]);
+	assert(ptr==&array[0]);
+	p=ptr.fetch_sub(-9);
+	assert(p==&array[0]);
+	assert(ptr==&array[9]);
 }
 
 template<>
@@ -205,6 +221,98 @@ void test_atomic_struct(void)
 	assert(i.load()==one);
 }
 
+/* 16 byte structures, e.g. a pointer and a tag, are lock-free on x86_64 */
+struct Wide {
+	long a, b;
+
+	inline bool operator==(const Wide &c) const {return a==c.a && b==c.b;}
+};
+
+void test_atomic_wide_struct(void)
+{
+	atomic<Wide> i;
+	Wide n;
+
+	Wide zero={0, 0}, one={1, -1}, two={2, -2}, high={0, 1};
+
+	printf("Type=Wide, size=%ld, atomic_size=%ld, lockfree=%d\n",
+		(long)sizeof(n), (long)sizeof(i), i.is_lock_free());
+
+	assert(sizeof(i)>=sizeof(n));
+
+	bool success;
+
+	i.store(zero);
+	assert(i.load()==zero);
+
+	/* differs from the current value only in the upper half */
+	n=high;
+	success=i.compare_exchange_strong(n, two);
+	assert(!success);
+	assert(n==zero);
+	assert(i.load()==zero);
+
+	n=zero;
+	success=i.compare_exchange_strong(n, two);
+	assert(success);
+	assert(n==zero);
+	assert(i.load()==two);
+
+	n=i.exchange(one);
+	assert(n==two);
+	assert(i.load()==one);
+}
+
+/* large structures, which are implemented as a seqlock */
+struct Snapshot {
+	long v[6];
+
+	inline bool operator==(const Snapshot &c) const {return memcmp(v, c.v, sizeof(v))==0;}
+};
+
+namespace boost {
+template<>
+struct atomic_use_seqlock<Snapshot> : public true_type {};
+}
+
+void test_atomic_seqlock_struct(void)
+{
+	atomic<Snapshot> i;
+	Snapshot n;
+
+	Snapshot zero={{0, 0, 0, 0, 0, 0}}, one={{1, 1, 1, 1, 1, 1}}, two={{2, 2, 2, 2, 2, 2}}, last={{0, 0, 0, 0, 0, 1}};
+
+	printf("Type=Snapshot, size=%ld, atomic_size=%ld, lockfree=%d\n",
+		(long)sizeof(n), (long)sizeof(i), i.is_lock_free());
+
+	assert(sizeof(i)>=sizeof(n));
+
+	bool success;
+
+	i.store(zero);
+	assert(i.load()==zero);
+	assert(i.load(memory_order_acquire)==zero);
+
+	n=last;
+	success=i.compare_exchange_strong(n, two);
+	assert(!success);
+	assert(n==zero);
+	assert(i.load()==zero);
+
+	n=zero;
+	success=i.compare_exchange_weak(n, two);
+	assert(success);
+	assert(n==zero);
+	assert(i.load()==two);
+
+	n=i.exchange(one);
+	assert(n==two);
+	assert(i.load()==one);
+
+	i.store(two, memory_order_release);
+	assert(i.load(memory_order_relaxed)==two);
+}
+
 enum TestEnum {
 	Foo, Bar
 };
@@ -237,9 +345,12 @@ int main()
 	test_atomic_arithmetic<unsigned long long>();
 	
 	test_atomic_struct();
+	test_atomic_wide_struct();
+	test_atomic_seqlock_struct();
 	
 	test_atomic_base<void *>();
 	test_atomic_ptr<int>();
+	test_atomic_ptr<Wide>();
 	test_atomic_base<bool>();
 	test_atomic_base<TestEnum>();
 	
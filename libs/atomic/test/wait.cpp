@@ -0,0 +1,94 @@
+//  tests wait, notify_one and notify_all of atomic<integral>: threads, which
+//  wait for a change of a 4 or 8 byte value, have to be woken by the thread,
+//  which modifies the value.
+
+#include <boost/atomic.hpp>
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
+
+#include <assert.h>
+#include <stdio.h>
+
+using namespace boost;
+
+template<typename T>
+void wait_for(atomic<T> * value, T expected)
+{
+	T current = value->load(memory_order_acquire);
+	while (current != expected) {
+		value->wait(current, memory_order_acquire);
+		current = value->load(memory_order_acquire);
+	}
+}
+
+/* a ping-pong between two threads, each of which waits for the value, which is
+stored by the other one */
+template<typename T>
+void ping(atomic<T> * value, T rounds)
+{
+	for (T i = 0; i != rounds; ++i) {
+		wait_for(value, T(2 * i + 1));
+		value->store(T(2 * i + 2), memory_order_release);
+		value->notify_one();
+	}
+}
+
+template<typename T>
+void test_ping_pong(void)
+{
+	const T rounds = 10000;
+	atomic<T> value(0);
+
+	thread t(bind(&ping<T>, &value, rounds));
+	for (T i = 0; i != rounds; ++i) {
+		value.store(T(2 * i + 1), memory_order_release);
+		value.notify_one();
+		wait_for(&value, T(2 * i + 2));
+	}
+	t.join();
+	assert(value.load() == 2 * rounds);
+}
+
+template<typename T>
+void test_notify_all(void)
+{
+	const int waiters = 4;
+	atomic<T> value(0);
+
+	thread_group group;
+	for (int i = 0; i != waiters; ++i)
+		group.create_thread(bind(&wait_for<T>, &value, T(1)));
+
+	this_thread::sleep(posix_time::milliseconds(10));
+	value.store(1, memory_order_release);
+	value.notify_all();
+	group.join_all();
+}
+
+template<typename T>
+void test_no_waiter(void)
+{
+	atomic<T> value(1);
+
+	/* the value differs, so wait returns immediately */
+	value.wait(0);
+	value.notify_one();
+	value.notify_all();
+}
+
+int main()
+{
+	test_no_waiter<int>();
+	test_no_waiter<long long>();
+	test_no_waiter<unsigned short>();
+
+	test_ping_pong<int>();
+	test_ping_pong<unsigned int>();
+	test_ping_pong<long long>();
+	test_ping_pong<unsigned long long>();
+
+	test_notify_all<int>();
+	test_notify_all<long long>();
+
+	printf("wait/notify tests passed\n");
+}
@@ -0,0 +1,174 @@
+#include <boost/lockfree/awaitable_queue.hpp>
+#include <boost/lockfree/fifo.hpp>
+#include <boost/lockfree/ringbuffer.hpp>
+#include <boost/lockfree/stack.hpp>
+
+#include <climits>
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <boost/thread.hpp>
+#include <exception>
+#include <iostream>
+
+#include "test_helpers.hpp"
+
+using namespace boost;
+using namespace boost::lockfree;
+using namespace std;
+
+namespace {
+
+/* eagerly started, detached coroutine */
+struct task
+{
+    struct promise_type
+    {
+        task get_return_object(void) { return task(); }
+        std::suspend_never initial_suspend(void) { return std::suspend_never(); }
+        std::suspend_never final_suspend(void) noexcept { return std::suspend_never(); }
+        void return_void(void) {}
+        void unhandled_exception(void) { std::terminate(); }
+    };
+};
+
+template <typename Queue>
+task pop_one(awaitable_queue<Queue> & q, int & result, bool & done)
+{
+    result = co_await q.pop();
+    done = true;
+}
+
+template <typename Queue>
+task push_one(awaitable_queue<Queue> & q, int value, bool & done)
+{
+    co_await q.push(value);
+    done = true;
+}
+
+}
+
+template <typename Queue>
+void awaitable_pop_push(awaitable_queue<Queue> & q)
+{
+    int result = 0;
+    bool done = false;
+
+    pop_one(q, result, done);
+    BOOST_REQUIRE(!done);
+
+    bool pushed = false;
+    push_one(q, 42, pushed);
+    BOOST_REQUIRE(pushed);
+    BOOST_REQUIRE(done);
+    BOOST_REQUIRE_EQUAL(result, 42);
+    BOOST_REQUIRE(q.empty());
+
+    /* fast path */
+    push_one(q, 43, pushed);
+    done = false;
+    pop_one(q, result, done);
+    BOOST_REQUIRE(done);
+    BOOST_REQUIRE_EQUAL(result, 43);
+}
+
+BOOST_AUTO_TEST_CASE( awaitable_queue_simple_test )
+{
+    awaitable_queue<ringbuffer<int, 16> > rb;
+    awaitable_pop_push(rb);
+
+    awaitable_queue<fifo<int> > f(16);
+    awaitable_pop_push(f);
+
+    awaitable_queue<stack<int> > s(16);
+    awaitable_pop_push(s);
+}
+
+BOOST_AUTO_TEST_CASE( awaitable_queue_full_test )
+{
+    awaitable_queue<ringbuffer<int, 4> > q;
+
+    bool done[5] = {false};
+    for (int i = 0; i != 5; ++i)
+        push_one(q, i, done[i]);
+
+    /* ringbuffer holds 3 elements */
+    BOOST_REQUIRE(done[2]);
+    BOOST_REQUIRE(!done[3]);
+    BOOST_REQUIRE(!done[4]);
+
+    int out;
+    BOOST_REQUIRE(q.try_pop(out));
+    BOOST_REQUIRE_EQUAL(out, 0);
+    BOOST_REQUIRE(done[3]);
+    BOOST_REQUIRE(!done[4]);
+
+    for (int i = 1; i != 5; ++i) {
+        BOOST_REQUIRE(q.try_pop(out));
+        BOOST_REQUIRE_EQUAL(out, i);
+    }
+    BOOST_REQUIRE(done[4]);
+    BOOST_REQUIRE(!q.try_pop(out));
+}
+
+static const int nodes_per_coroutine = 100000;
+static const int producers = 4;
+static const int consumers = 4;
+
+struct awaitable_queue_tester
+{
+    awaitable_queue<fifo<int, static_freelist_t> > q;
+
+    boost::lockfree::detail::atomic<int> finished_producers, finished_consumers;
+
+    static_hashed_set<int, 1<<16 > working_set;
+
+    awaitable_queue_tester(void):
+        q(64), finished_producers(0), finished_consumers(0)
+    {}
+
+    task produce(void)
+    {
+        for (int i = 0; i != nodes_per_coroutine; ++i) {
+            int id = generate_id<int>();
+            working_set.insert(id);
+            co_await q.push(id);
+        }
+        ++finished_producers;
+    }
+
+    task consume(void)
+    {
+        for (int i = 0; i != nodes_per_coroutine; ++i) {
+            int id = co_await q.pop();
+            bool erased = working_set.erase(id);
+            assert(erased);
+        }
+        ++finished_consumers;
+    }
+
+    void run(void)
+    {
+        thread_group threads;
+
+        for (int i = 0; i != consumers; ++i)
+            threads.create_thread(boost::bind(&awaitable_queue_tester::consume, this));
+        for (int i = 0; i != producers; ++i)
+            threads.create_thread(boost::bind(&awaitable_queue_tester::produce, this));
+
+        threads.join_all();
+
+        /* coroutines may be resumed on other threads. all of them have completed, when the last thread returned */
+        BOOST_REQUIRE_EQUAL(finished_producers, producers);
+        BOOST_REQUIRE_EQUAL(finished_consumers, consumers);
+        BOOST_REQUIRE(q.empty());
+        BOOST_REQUIRE_EQUAL(working_set.count_nodes(), 0);
+    }
+};
+
+BOOST_AUTO_TEST_CASE( awaitable_queue_test )
+{
+    awaitable_queue_tester tester;
+    tester.run();
+}
@@ -0,0 +1,96 @@
+//  measures system calls per message of eventfd_queue under bursty load
+//
+//  for every configuration, one producer enqueues bursts of messages, separated by a short pause. the consumer waits in
+//  epoll_wait and drains the queue. the number of eventfd writes is obtained from the eventfd counter, so the producer
+//  is not instrumented.
+
+#include <boost/lockfree/eventfd_queue.hpp>
+#include <boost/lockfree/fifo.hpp>
+#include <boost/lockfree/ringbuffer.hpp>
+
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
+
+#include <cstdio>
+
+#include <sys/epoll.h>
+
+const long messages = 1000000;
+
+template <typename Queue>
+struct bench
+{
+    bench(long burst, long pause_us):
+        q(4096), burst(burst), pause_us(pause_us), received(0), writes(0), reads(0), waits(0)
+    {}
+
+    boost::lockfree::eventfd_queue<Queue> q;
+    const long burst, pause_us;
+    long received, writes, reads, waits;
+
+    void produce(void)
+    {
+        for (long i = 0; i != messages; ++i) {
+            while (!q.enqueue(i))
+                ;
+            if ((i + 1) % burst == 0)
+                boost::this_thread::sleep(boost::posix_time::microseconds(pause_us));
+        }
+    }
+
+    void consume(void)
+    {
+        int epfd = epoll_create1(EPOLL_CLOEXEC);
+        epoll_event ev;
+        ev.events = EPOLLIN;
+        ev.data.fd = q.native_handle();
+        epoll_ctl(epfd, EPOLL_CTL_ADD, q.native_handle(), &ev);
+
+        while (received != messages) {
+            epoll_event event;
+            ++waits;
+            if (epoll_wait(epfd, &event, 1, -1) != 1)
+                continue;
+
+            std::size_t signalled = q.acknowledge();
+            ++reads;
+            writes += signalled;
+
+            long buffer[64];
+            for (;;) {
+                std::size_t count = q.dequeue(buffer, 64);
+                received += count;
+                if (count == 0 && q.rearm())
+                    break;
+            }
+        }
+        close(epfd);
+    }
+
+    void run(const char * name)
+    {
+        boost::thread consumer(boost::bind(&bench::consume, this));
+        boost::thread producer(boost::bind(&bench::produce, this));
+        producer.join();
+        consumer.join();
+
+        long syscalls = writes + reads + waits;
+        printf("%-10s burst %5ld: %8ld writes, %8ld reads, %8ld epoll_waits, %.4f syscalls/message\n",
+               name, burst, writes, reads, waits, double(syscalls) / messages);
+    }
+};
+
+int main()
+{
+    const long bursts[] = {1, 16, 256, 4096};
+
+    for (int i = 0; i != sizeof(bursts)/sizeof(bursts[0]); ++i) {
+        bench<boost::lockfree::ringbuffer<long, 0> > rb(bursts[i], 20);
+        rb.run("ringbuffer");
+    }
+
+    for (int i = 0; i != sizeof(bursts)/sizeof(bursts[0]); ++i) {
+        bench<boost::lockfree::fifo<long> > f(bursts[i], 20);
+        f.run("fifo");
+    }
+}
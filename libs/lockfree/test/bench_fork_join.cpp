@@ -0,0 +1,160 @@
+//  compares work_stealing_deque and a shared stack as task pool of a fork-join computation
+//
+//  the benchmark computes fib(n) by recursive decomposition: a task n > 1 spawns the tasks n - 1 and n - 2, a task
+//  n < 2 contributes n to the result. with work_stealing_deque, every worker owns a deque and steals from the other
+//  workers, when its deque is empty. with the stack, all workers push to and pop from one shared stack.
+//
+//  usage: bench_fork_join [max_threads], defaults to the number of hardware threads
+
+#include <boost/lockfree/stack.hpp>
+#include <boost/lockfree/work_stealing_deque.hpp>
+
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/scoped_array.hpp>
+#include <boost/thread.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+
+using boost::lockfree::detail::atomic;
+
+const int n = 30;
+
+long fib(int n)
+{
+    return n < 2 ? n : fib(n - 1) + fib(n - 2);
+}
+
+/* tasks, which have been spawned but not completed. a task n > 1 adds one outstanding task. */
+struct termination
+{
+    atomic<long> outstanding;
+    char padding[BOOST_LOCKFREE_CACHELINE_BYTES];
+    atomic<long> result;
+
+    termination(void):
+        outstanding(1), result(0)
+    {}
+
+    bool done(void)
+    {
+        return outstanding.load(boost::lockfree::memory_order_acquire) == 0;
+    }
+
+    void complete(long local_result)
+    {
+        result.fetch_add(local_result, boost::lockfree::memory_order_relaxed);
+    }
+};
+
+struct deque_pool
+{
+    boost::scoped_array<boost::lockfree::work_stealing_deque<int> > deques;
+    const int threads;
+    termination state;
+
+    explicit deque_pool(int threads):
+        deques(new boost::lockfree::work_stealing_deque<int>[threads]), threads(threads)
+    {
+        deques[0].push(n);
+    }
+
+    bool get_task(int worker, int & task)
+    {
+        if (deques[worker].pop(task))
+            return true;
+        for (int i = 1; i != threads; ++i)
+            if (deques[(worker + i) % threads].steal(task))
+                return true;
+        return false;
+    }
+
+    void work(int worker)
+    {
+        long result = 0;
+        while (!state.done()) {
+            int task;
+            if (!get_task(worker, task))
+                continue;
+
+            if (task < 2) {
+                result += task;
+                state.outstanding.fetch_sub(1, boost::lockfree::memory_order_release);
+            } else {
+                state.outstanding.fetch_add(1, boost::lockfree::memory_order_relaxed);
+                deques[worker].push(task - 1);
+                deques[worker].push(task - 2);
+            }
+        }
+        state.complete(result);
+    }
+};
+
+struct stack_pool
+{
+    boost::lockfree::stack<int> tasks;
+    termination state;
+
+    explicit stack_pool(int):
+        tasks(1024)
+    {
+        tasks.push(n);
+    }
+
+    void work(int)
+    {
+        long result = 0;
+        while (!state.done()) {
+            int task;
+            if (!tasks.pop(task))
+                continue;
+
+            if (task < 2) {
+                result += task;
+                state.outstanding.fetch_sub(1, boost::lockfree::memory_order_release);
+            } else {
+                state.outstanding.fetch_add(1, boost::lockfree::memory_order_relaxed);
+                tasks.push(task - 1);
+                tasks.push(task - 2);
+            }
+        }
+        state.complete(result);
+    }
+};
+
+template <typename Pool>
+double run(int threads)
+{
+    Pool pool(threads);
+
+    boost::posix_time::ptime begin = boost::posix_time::microsec_clock::universal_time();
+    boost::thread_group group;
+    for (int i = 0; i != threads; ++i)
+        group.create_thread(boost::bind(&Pool::work, &pool, i));
+    group.join_all();
+    double elapsed = (boost::posix_time::microsec_clock::universal_time() - begin).total_microseconds() * 1e-6;
+
+    if (pool.state.result != fib(n)) {
+        printf("wrong result\n");
+        std::exit(1);
+    }
+    return elapsed;
+}
+
+int main(int argc, char * argv[])
+{
+    int max_threads = argc > 1 ? std::atoi(argv[1]) : boost::thread::hardware_concurrency();
+    if (max_threads < 1)
+        max_threads = 1;
+
+    printf("fib(%d)\nthreads    work_stealing_deque s    stack s\n", n);
+    for (int threads = 1;; threads = (threads * 2 < max_threads) ? threads * 2 : max_threads) {
+        double deque_time = run<deque_pool>(threads);
+        double stack_time = run<stack_pool>(threads);
+        printf("%7d    %21.3f    %7.3f\n", threads, deque_time, stack_time);
+
+        if (threads == max_threads)
+            break;
+    }
+}
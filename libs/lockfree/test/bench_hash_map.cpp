@@ -0,0 +1,115 @@
+//  measures the throughput of hash_map and of a hash set with a mutex per bucket (static_hashed_set from
+//  test_helpers.hpp) for a read-heavy workload with an increasing number of threads
+//
+//  the tables are prefilled with half of the key range. every thread performs 90% lookups, 5% insertions and 5%
+//  erasures of random keys.
+//
+//  usage: bench_hash_map [max_threads], defaults to the number of hardware threads
+
+#include "test_helpers.hpp"
+
+#include <boost/lockfree/hash_map.hpp>
+
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/thread.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+const long operations_per_thread = 1000000;
+const long key_range = 1 << 16;
+const unsigned int buckets = 1 << 10;
+
+typedef boost::lockfree::hash_map<long, long> lockfree_map;
+typedef static_hashed_set<long, buckets> mutex_set;
+
+bool insert(lockfree_map & m, long key)
+{
+    return m.insert(key, key);
+}
+
+bool insert(mutex_set & s, long key)
+{
+    return s.insert(key);
+}
+
+bool find(lockfree_map & m, long key)
+{
+    return m.contains(key);
+}
+
+bool find(mutex_set & s, long key)
+{
+    return s.find(key);
+}
+
+bool erase(lockfree_map & m, long key)
+{
+    return m.erase(key);
+}
+
+bool erase(mutex_set & s, long key)
+{
+    return s.erase(key);
+}
+
+template <typename Table>
+void worker(Table * table, boost::barrier * start, unsigned int seed, long * hits)
+{
+    start->wait();
+
+    long found = 0;
+    for (long i = 0; i != operations_per_thread; ++i) {
+        seed = seed * 1103515245u + 12345u;
+        const long key = (seed >> 8) % key_range;
+        const unsigned int operation = (seed >> 4) % 20;
+
+        if (operation == 0)
+            insert(*table, key);
+        else if (operation == 1)
+            erase(*table, key);
+        else
+            found += find(*table, key);
+    }
+    *hits = found;
+}
+
+template <typename Table>
+double run(int threads)
+{
+    Table table;
+    for (long key = 0; key < key_range; key += 2)
+        insert(table, key);
+
+    std::vector<long> hits(threads);
+    boost::barrier start(threads + 1);
+    boost::thread_group group;
+    for (int i = 0; i != threads; ++i)
+        group.create_thread(boost::bind(&worker<Table>, &table, &start, i + 1, &hits[i]));
+
+    start.wait();
+    boost::posix_time::ptime begin = boost::posix_time::microsec_clock::universal_time();
+    group.join_all();
+    double elapsed = (boost::posix_time::microsec_clock::universal_time() - begin).total_microseconds() * 1e-6;
+
+    return double(operations_per_thread) * threads / elapsed * 1e-6;
+}
+
+int main(int argc, char * argv[])
+{
+    int max_threads = argc > 1 ? std::atoi(argv[1]) : boost::thread::hardware_concurrency();
+    if (max_threads < 1)
+        max_threads = 1;
+
+    printf("threads    hash_map Mops/s    static_hashed_set Mops/s\n");
+    for (int threads = 1;; threads = (threads * 2 < max_threads) ? threads * 2 : max_threads) {
+        double lockfree_ops = run<lockfree_map>(threads);
+        double mutex_ops = run<mutex_set>(threads);
+        printf("%7d    %15.2f    %24.2f\n", threads, lockfree_ops, mutex_ops);
+
+        if (threads == max_threads)
+            break;
+    }
+}
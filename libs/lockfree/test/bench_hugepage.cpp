@@ -0,0 +1,74 @@
+//  measures sequential throughput of a large ringbuffer with different allocation strategies
+//
+//  a 256mb ringbuffer is repeatedly filled and drained by a single thread, so every pass touches all pages of the
+//  buffer. with 4kb pages, this needs 65536 TLB entries per pass. the first pass includes the page faults, unless the
+//  buffer has been pre-faulted.
+
+#include <boost/lockfree/hugepage_allocator.hpp>
+#include <boost/lockfree/ringbuffer.hpp>
+
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+
+#include <cstdio>
+#include <exception>
+#include <memory>
+
+typedef long value_type;
+
+const std::size_t ring_bytes = 256 * 1024 * 1024;
+const std::size_t ring_size = ring_bytes / sizeof(value_type);
+const std::size_t batch = 4096;
+const int passes = 5;
+
+double seconds_since(boost::posix_time::ptime start)
+{
+    return (boost::posix_time::microsec_clock::universal_time() - start).total_microseconds() * 1e-6;
+}
+
+template <typename Alloc>
+void run(const char * name, Alloc const & alloc)
+{
+    boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+    boost::lockfree::ringbuffer<value_type, 0, Alloc> rb(ring_size, alloc);
+    double setup = seconds_since(start);
+
+    static value_type buffer[batch];
+    printf("%-26s setup %7.3fs, pass MB/s:", name, setup);
+
+    for (int pass = 0; pass != passes; ++pass) {
+        start = boost::posix_time::microsec_clock::universal_time();
+
+        std::size_t enqueued = 0;
+        while (std::size_t count = rb.enqueue(buffer, batch))
+            enqueued += count;
+
+        std::size_t dequeued = 0;
+        while (std::size_t count = rb.dequeue(buffer, batch))
+            dequeued += count;
+
+        double elapsed = seconds_since(start);
+        printf(" %8.0f", double(enqueued + dequeued) * sizeof(value_type) / elapsed / (1024 * 1024));
+    }
+    printf("\n");
+}
+
+int main()
+{
+    typedef boost::lockfree::hugepage_allocator<value_type> hugepage_allocator;
+
+    run("std::allocator", std::allocator<value_type>());
+    run("4k pages", hugepage_allocator(-1, 0));
+    run("4k pages, prefault", hugepage_allocator(-1, hugepage_allocator::prefault));
+    run("transparent", hugepage_allocator(-1, hugepage_allocator::transparent_hugepages));
+    run("transparent, prefault", hugepage_allocator(-1, hugepage_allocator::transparent_hugepages |
+                                                        hugepage_allocator::prefault));
+    run("explicit, prefault", hugepage_allocator(-1, hugepage_allocator::explicit_hugepages |
+                                                     hugepage_allocator::prefault));
+
+    try {
+        run("transparent, node 0", hugepage_allocator(0, hugepage_allocator::transparent_hugepages |
+                                                         hugepage_allocator::prefault));
+    } catch (std::exception const & e) {
+        printf("numa binding failed: %s\n", e.what());
+    }
+}
@@ -0,0 +1,165 @@
+//  measures the throughput of object_pool with and without per-thread caches, of malloc/free and of a
+//  boost::singleton_pool (guarded by a mutex) for allocation churn with an increasing number of threads
+//
+//  every thread owns a window of slots and repeatedly picks a random slot: an empty slot gets a new message, an
+//  occupied slot is freed.
+//
+//  usage: bench_object_pool [max_threads], defaults to the number of hardware threads
+
+#include <boost/lockfree/object_pool.hpp>
+
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/pool/singleton_pool.hpp>
+#include <boost/thread.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+const long operations_per_thread = 2000000;
+const int window = 256;
+
+struct message
+{
+    long id;
+    char payload[56];
+};
+
+struct malloc_allocator
+{
+    explicit malloc_allocator(int)
+    {}
+
+    message * allocate(void)
+    {
+        return static_cast<message*>(std::malloc(sizeof(message)));
+    }
+
+    void deallocate(message * m)
+    {
+        std::free(m);
+    }
+};
+
+struct singleton_pool_tag
+{};
+
+typedef boost::singleton_pool<singleton_pool_tag, sizeof(message)> boost_pool;
+
+struct singleton_pool_allocator
+{
+    explicit singleton_pool_allocator(int)
+    {}
+
+    message * allocate(void)
+    {
+        return static_cast<message*>(boost_pool::malloc());
+    }
+
+    void deallocate(message * m)
+    {
+        boost_pool::free(m);
+    }
+};
+
+struct shared_pool_allocator
+{
+    explicit shared_pool_allocator(int threads):
+        pool(threads * window)
+    {}
+
+    message * allocate(void)
+    {
+        return pool.allocate();
+    }
+
+    void deallocate(message * m)
+    {
+        pool.deallocate(m);
+    }
+
+    boost::lockfree::object_pool<message> pool;
+};
+
+struct cached_pool_allocator
+{
+    /* the threads of earlier runs are numbered before the threads of this run, so there is a cache for every thread,
+     * that the benchmark may create */
+    explicit cached_pool_allocator(int threads):
+        pool(threads * window, 1024, 64)
+    {}
+
+    message * allocate(void)
+    {
+        return pool.allocate();
+    }
+
+    void deallocate(message * m)
+    {
+        pool.deallocate(m);
+    }
+
+    boost::lockfree::object_pool<message> pool;
+};
+
+template <typename Allocator>
+void worker(Allocator * allocator, boost::barrier * start, unsigned int seed)
+{
+    std::vector<message*> slots(window, (message*)NULL);
+    start->wait();
+
+    for (long i = 0; i != operations_per_thread; ++i) {
+        seed = seed * 1103515245u + 12345u;
+        message *& slot = slots[(seed >> 8) % window];
+        if (slot) {
+            allocator->deallocate(slot);
+            slot = NULL;
+        } else {
+            slot = allocator->allocate();
+            slot->id = i;
+        }
+    }
+
+    for (int i = 0; i != window; ++i)
+        if (slots[i])
+            allocator->deallocate(slots[i]);
+}
+
+template <typename Allocator>
+double run(int threads)
+{
+    Allocator allocator(threads);
+
+    boost::barrier start(threads + 1);
+    boost::thread_group group;
+    for (int i = 0; i != threads; ++i)
+        group.create_thread(boost::bind(&worker<Allocator>, &allocator, &start, i + 1));
+
+    start.wait();
+    boost::posix_time::ptime begin = boost::posix_time::microsec_clock::universal_time();
+    group.join_all();
+    double elapsed = (boost::posix_time::microsec_clock::universal_time() - begin).total_microseconds() * 1e-6;
+
+    return double(operations_per_thread) * threads / elapsed * 1e-6;
+}
+
+int main(int argc, char * argv[])
+{
+    int max_threads = argc > 1 ? std::atoi(argv[1]) : boost::thread::hardware_concurrency();
+    if (max_threads < 1)
+        max_threads = 1;
+
+    printf("threads    malloc Mops/s    singleton_pool Mops/s    object_pool Mops/s    cached object_pool Mops/s\n");
+    for (int threads = 1;; threads = (threads * 2 < max_threads) ? threads * 2 : max_threads) {
+        double malloc_ops = run<malloc_allocator>(threads);
+        double boost_pool_ops = run<singleton_pool_allocator>(threads);
+        double shared_ops = run<shared_pool_allocator>(threads);
+        double cached_ops = run<cached_pool_allocator>(threads);
+        printf("%7d    %13.2f    %21.2f    %18.2f    %25.2f\n", threads, malloc_ops, boost_pool_ops, shared_ops,
+               cached_ops);
+
+        if (threads == max_threads)
+            break;
+    }
+}
@@ -0,0 +1,185 @@
+//  measures the throughput and the rank error of priority_queue with a single sub-queue (exact) and with two
+//  sub-queues per thread (relaxed) and of a std::priority_queue, which is guarded by a mutex, with an increasing number
+//  of threads
+//
+//  throughput: the queues are prefilled with random priorities, every thread alternately pops an element and pushes
+//  it back with a later priority, like a scheduler, which re-arms timers.
+//
+//  rank error: the queues are prefilled with the priorities 0 .. n-1 in a random order and drained by all threads.
+//  every popped element gets a global sequence number, the rank error of an element is the distance between its
+//  priority and its sequence number.
+//
+//  usage: bench_priority_queue [max_threads], defaults to the number of hardware threads
+
+#include <boost/lockfree/priority_queue.hpp>
+
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/thread.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <queue>
+#include <vector>
+
+const long operations_per_thread = 500000;
+const long prefill = 1 << 14;
+
+class mutex_queue
+{
+public:
+    explicit mutex_queue(int)
+    {}
+
+    bool push(long value)
+    {
+        boost::mutex::scoped_lock lock(mutex_);
+        queue_.push(value);
+        return true;
+    }
+
+    bool pop(long & ret)
+    {
+        boost::mutex::scoped_lock lock(mutex_);
+        if (queue_.empty())
+            return false;
+        ret = queue_.top();
+        queue_.pop();
+        return true;
+    }
+
+private:
+    boost::mutex mutex_;
+    std::priority_queue<long, std::vector<long>, std::greater<long> > queue_;
+};
+
+class exact_queue:
+    public boost::lockfree::priority_queue<long>
+{
+public:
+    explicit exact_queue(int)
+    {}
+};
+
+class relaxed_queue:
+    public boost::lockfree::priority_queue<long>
+{
+public:
+    explicit relaxed_queue(int threads):
+        boost::lockfree::priority_queue<long>(2 * threads)
+    {}
+};
+
+template <typename Queue>
+void throughput_worker(Queue * queue, boost::barrier * start, unsigned int seed)
+{
+    start->wait();
+
+    for (long i = 0; i != operations_per_thread; ++i) {
+        long value;
+        if (queue->pop(value)) {
+            seed = seed * 1103515245u + 12345u;
+            queue->push(value + (seed >> 8) % prefill);
+        }
+    }
+}
+
+template <typename Queue>
+double throughput(int threads)
+{
+    Queue queue(threads);
+    unsigned int seed = 42;
+    for (long i = 0; i != prefill; ++i) {
+        seed = seed * 1103515245u + 12345u;
+        queue.push((seed >> 8) % prefill);
+    }
+
+    boost::barrier start(threads + 1);
+    boost::thread_group group;
+    for (int i = 0; i != threads; ++i)
+        group.create_thread(boost::bind(&throughput_worker<Queue>, &queue, &start, i + 1));
+
+    start.wait();
+    boost::posix_time::ptime begin = boost::posix_time::microsec_clock::universal_time();
+    group.join_all();
+    double elapsed = (boost::posix_time::microsec_clock::universal_time() - begin).total_microseconds() * 1e-6;
+
+    /* every operation is a pop and a push */
+    return 2.0 * operations_per_thread * threads / elapsed * 1e-6;
+}
+
+struct rank_error
+{
+    double mean;
+    long max;
+};
+
+template <typename Queue>
+void rank_worker(Queue * queue, boost::barrier * start, boost::lockfree::detail::atomic<long> * sequence,
+                 long * sum, long * max)
+{
+    start->wait();
+
+    long value;
+    while (queue->pop(value)) {
+        const long error = std::labs(value - sequence->fetch_add(1));
+        *sum += error;
+        *max = std::max(*max, error);
+    }
+}
+
+template <typename Queue>
+rank_error measure_rank_error(int threads)
+{
+    Queue queue(threads);
+    std::vector<long> values;
+    for (long i = 0; i != prefill; ++i)
+        values.push_back(i);
+    std::random_shuffle(values.begin(), values.end());
+    for (long i = 0; i != prefill; ++i)
+        queue.push(values[i]);
+
+    boost::lockfree::detail::atomic<long> sequence(0);
+    std::vector<long> sums(threads), maxima(threads);
+    boost::barrier start(threads + 1);
+    boost::thread_group group;
+    for (int i = 0; i != threads; ++i)
+        group.create_thread(boost::bind(&rank_worker<Queue>, &queue, &start, &sequence, &sums[i], &maxima[i]));
+
+    start.wait();
+    group.join_all();
+
+    rank_error ret = {0, 0};
+    for (int i = 0; i != threads; ++i) {
+        ret.mean += sums[i];
+        ret.max = std::max(ret.max, maxima[i]);
+    }
+    ret.mean /= prefill;
+    return ret;
+}
+
+int main(int argc, char * argv[])
+{
+    int max_threads = argc > 1 ? std::atoi(argv[1]) : boost::thread::hardware_concurrency();
+    if (max_threads < 1)
+        max_threads = 1;
+
+    printf("threads    queue      Mops/s    mean rank error    max rank error\n");
+    for (int threads = 1;; threads = (threads * 2 < max_threads) ? threads * 2 : max_threads) {
+        rank_error exact = measure_rank_error<exact_queue>(threads);
+        rank_error relaxed = measure_rank_error<relaxed_queue>(threads);
+        rank_error locked = measure_rank_error<mutex_queue>(threads);
+
+        printf("%7d    exact    %8.2f    %15.2f    %14ld\n", threads, throughput<exact_queue>(threads),
+               exact.mean, exact.max);
+        printf("%7d    relaxed  %8.2f    %15.2f    %14ld\n", threads, throughput<relaxed_queue>(threads),
+               relaxed.mean, relaxed.max);
+        printf("%7d    mutex    %8.2f    %15.2f    %14ld\n", threads, throughput<mutex_queue>(threads),
+               locked.mean, locked.max);
+
+        if (threads == max_threads)
+            break;
+    }
+}
@@ -0,0 +1,65 @@
+//  measures the throughput of sharded_fifo and fifo with an increasing number of threads
+//
+//  every thread alternately enqueues and dequeues an element, so the queue stays close to empty and all operations
+//  contend on the head and tail pointers of a single fifo. the sharded_fifo has one shard per thread.
+//
+//  usage: bench_sharded [max_threads], defaults to the number of hardware threads
+
+#include <boost/lockfree/fifo.hpp>
+#include <boost/lockfree/sharded_fifo.hpp>
+
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/thread.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+
+const long operations_per_thread = 1000000;
+
+template <typename Queue>
+void worker(Queue * q, boost::barrier * start)
+{
+    start->wait();
+    long out;
+    for (long i = 0; i != operations_per_thread; ++i) {
+        q->enqueue(i);
+        q->dequeue(out);
+    }
+}
+
+template <typename Queue>
+double run(Queue & q, int threads)
+{
+    boost::barrier start(threads + 1);
+    boost::thread_group group;
+    for (int i = 0; i != threads; ++i)
+        group.create_thread(boost::bind(&worker<Queue>, &q, &start));
+
+    start.wait();
+    boost::posix_time::ptime begin = boost::posix_time::microsec_clock::universal_time();
+    group.join_all();
+    double elapsed = (boost::posix_time::microsec_clock::universal_time() - begin).total_microseconds() * 1e-6;
+
+    return 2.0 * operations_per_thread * threads / elapsed * 1e-6;
+}
+
+int main(int argc, char * argv[])
+{
+    int max_threads = argc > 1 ? std::atoi(argv[1]) : boost::thread::hardware_concurrency();
+    if (max_threads < 1)
+        max_threads = 1;
+
+    printf("threads    fifo Mops/s    sharded_fifo Mops/s\n");
+    for (int threads = 1;; threads = (threads * 2 < max_threads) ? threads * 2 : max_threads) {
+        boost::lockfree::fifo<long> f(threads * 16);
+        boost::lockfree::sharded_fifo<long> sf(threads, 16);
+
+        double fifo_ops = run(f, threads);
+        double sharded_ops = run(sf, threads);
+        printf("%7d    %11.2f    %19.2f\n", threads, fifo_ops, sharded_ops);
+
+        if (threads == max_threads)
+            break;
+    }
+}
@@ -0,0 +1,143 @@
+//  measures the throughput of skiplist_map and of a std::map, which is guarded by a mutex, for different ratios of
+//  lookups and modifications with an increasing number of threads
+//
+//  the maps are prefilled with half of the key range. the modifications are insertions and erasures of random keys in
+//  equal parts, every 64th lookup is a scan over 16 keys.
+//
+//  usage: bench_skiplist [max_threads], defaults to the number of hardware threads
+
+#include <boost/lockfree/skiplist.hpp>
+
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/thread.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <vector>
+
+const long operations_per_thread = 500000;
+const long key_range = 1 << 16;
+
+class mutex_map
+{
+public:
+    bool insert(long key, long value)
+    {
+        boost::mutex::scoped_lock lock(mutex_);
+        return map_.insert(std::make_pair(key, value)).second;
+    }
+
+    bool erase(long key)
+    {
+        boost::mutex::scoped_lock lock(mutex_);
+        return map_.erase(key) != 0;
+    }
+
+    bool find(long key, long & ret)
+    {
+        boost::mutex::scoped_lock lock(mutex_);
+        std::map<long, long>::const_iterator it = map_.find(key);
+        if (it == map_.end())
+            return false;
+        ret = it->second;
+        return true;
+    }
+
+    template <typename Functor>
+    std::size_t scan(long first, long last, Functor & f)
+    {
+        boost::mutex::scoped_lock lock(mutex_);
+        std::size_t count = 0;
+        std::map<long, long>::const_iterator end = map_.lower_bound(last);
+        for (std::map<long, long>::const_iterator it = map_.lower_bound(first); it != end; ++it, ++count)
+            f(it->first, it->second);
+        return count;
+    }
+
+private:
+    boost::mutex mutex_;
+    std::map<long, long> map_;
+};
+
+typedef boost::lockfree::skiplist_map<long, long> lockfree_map;
+
+struct sum
+{
+    long value;
+
+    void operator()(long, long v)
+    {
+        value += v;
+    }
+};
+
+template <typename Map>
+void worker(Map * map, boost::barrier * start, unsigned int seed, int read_percentage, long * result)
+{
+    start->wait();
+
+    sum s = {0};
+    for (long i = 0; i != operations_per_thread; ++i) {
+        seed = seed * 1103515245u + 12345u;
+        const long key = (seed >> 8) % key_range;
+        const int operation = (seed >> 4) % 100;
+
+        if (operation >= read_percentage) {
+            if (operation & 1)
+                map->insert(key, key);
+            else
+                map->erase(key);
+        } else if ((i & 63) == 0)
+            map->scan(key, key + 16, s);
+        else {
+            long value;
+            if (map->find(key, value))
+                s.value += value;
+        }
+    }
+    *result = s.value;
+}
+
+template <typename Map>
+double run(int threads, int read_percentage)
+{
+    Map map;
+    for (long key = 0; key < key_range; key += 2)
+        map.insert(key, key);
+
+    std::vector<long> results(threads);
+    boost::barrier start(threads + 1);
+    boost::thread_group group;
+    for (int i = 0; i != threads; ++i)
+        group.create_thread(boost::bind(&worker<Map>, &map, &start, i + 1, read_percentage, &results[i]));
+
+    start.wait();
+    boost::posix_time::ptime begin = boost::posix_time::microsec_clock::universal_time();
+    group.join_all();
+    double elapsed = (boost::posix_time::microsec_clock::universal_time() - begin).total_microseconds() * 1e-6;
+
+    return double(operations_per_thread) * threads / elapsed * 1e-6;
+}
+
+int main(int argc, char * argv[])
+{
+    int max_threads = argc > 1 ? std::atoi(argv[1]) : boost::thread::hardware_concurrency();
+    if (max_threads < 1)
+        max_threads = 1;
+
+    const int read_percentages[] = {90, 50, 10};
+
+    printf("reads    threads    skiplist_map Mops/s    mutex std::map Mops/s\n");
+    for (int r = 0; r != 3; ++r) {
+        for (int threads = 1;; threads = (threads * 2 < max_threads) ? threads * 2 : max_threads) {
+            double lockfree_ops = run<lockfree_map>(threads, read_percentages[r]);
+            double mutex_ops = run<mutex_map>(threads, read_percentages[r]);
+            printf("%4d%%    %7d    %19.2f    %21.2f\n", read_percentages[r], threads, lockfree_ops, mutex_ops);
+
+            if (threads == max_threads)
+                break;
+        }
+    }
+}
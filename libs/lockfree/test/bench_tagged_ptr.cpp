@@ -0,0 +1,95 @@
+//  measures the throughput of fifo and stack with an increasing number of threads, for the tagged pointer layout,
+//  which is selected at compile time
+//
+//  the benchmark is built twice: bench_tagged_ptr_compressed uses the default 48 bit pointer / 16 bit tag layout of
+//  x86_64, bench_tagged_ptr_dcas defines BOOST_LOCKFREE_NO_PTR_COMPRESSION and uses full-width pointers and tags,
+//  which are updated via cmpxchg16b. every thread alternately pushes and pops an element, so all operations contend on
+//  the same head and tail pointers.
+//
+//  usage: bench_tagged_ptr_compressed|bench_tagged_ptr_dcas [max_threads], defaults to the number of hardware threads
+
+#include <boost/lockfree/fifo.hpp>
+#include <boost/lockfree/stack.hpp>
+
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/thread.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+
+const long operations_per_thread = 1000000;
+
+bool push(boost::lockfree::fifo<long> & f, long value)
+{
+    return f.enqueue(value);
+}
+
+bool pop(boost::lockfree::fifo<long> & f, long & ret)
+{
+    return f.dequeue(ret);
+}
+
+bool push(boost::lockfree::stack<long> & s, long value)
+{
+    return s.push(value);
+}
+
+bool pop(boost::lockfree::stack<long> & s, long & ret)
+{
+    return s.pop(ret);
+}
+
+template <typename Queue>
+void worker(Queue * q, boost::barrier * start)
+{
+    start->wait();
+    long out;
+    for (long i = 0; i != operations_per_thread; ++i) {
+        push(*q, i);
+        pop(*q, out);
+    }
+}
+
+template <typename Queue>
+double run(int threads)
+{
+    Queue q(threads * 16);
+    boost::barrier start(threads + 1);
+    boost::thread_group group;
+    for (int i = 0; i != threads; ++i)
+        group.create_thread(boost::bind(&worker<Queue>, &q, &start));
+
+    start.wait();
+    boost::posix_time::ptime begin = boost::posix_time::microsec_clock::universal_time();
+    group.join_all();
+    double elapsed = (boost::posix_time::microsec_clock::universal_time() - begin).total_microseconds() * 1e-6;
+
+    return 2.0 * operations_per_thread * threads / elapsed * 1e-6;
+}
+
+int main(int argc, char * argv[])
+{
+    int max_threads = argc > 1 ? std::atoi(argv[1]) : boost::thread::hardware_concurrency();
+    if (max_threads < 1)
+        max_threads = 1;
+
+#ifdef BOOST_LOCKFREE_PTR_COMPRESSION
+    const char * layout = "compressed";
+#else
+    const char * layout = "dcas";
+#endif
+    printf("layout: %s, sizeof(tagged_ptr): %d, lock-free: %d\n", layout,
+           int(sizeof(boost::lockfree::detail::tagged_ptr<long>)),
+           int(boost::lockfree::detail::atomic<boost::lockfree::detail::tagged_ptr<long> >().is_lock_free()));
+
+    printf("threads    fifo Mops/s    stack Mops/s\n");
+    for (int threads = 1;; threads = (threads * 2 < max_threads) ? threads * 2 : max_threads) {
+        double fifo_ops = run<boost::lockfree::fifo<long> >(threads);
+        double stack_ops = run<boost::lockfree::stack<long> >(threads);
+        printf("%7d    %11.2f    %12.2f\n", threads, fifo_ops, stack_ops);
+
+        if (threads == max_threads)
+            break;
+    }
+}
@@ -0,0 +1,204 @@
+//  compares the work-stealing thread_pool with a thread pool, which is based on a mutex and a condition variable
+//
+//  throughput: fine-grained tasks are submitted from an external thread (in batches) and from the workers themselves
+//  (recursive spawning). latency: a single task is submitted to an idle pool and the time until it starts is measured.
+//
+//  usage: bench_thread_pool [workers], defaults to the number of hardware threads
+
+#include <boost/lockfree/thread_pool.hpp>
+
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/function.hpp>
+#include <boost/thread.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <vector>
+
+using boost::lockfree::detail::atomic;
+
+class mutex_pool:
+    boost::noncopyable
+{
+public:
+    explicit mutex_pool(std::size_t workers):
+        stop_(false)
+    {
+        for (std::size_t i = 0; i != workers; ++i)
+            threads_.create_thread(boost::bind(&mutex_pool::run, this));
+    }
+
+    ~mutex_pool(void)
+    {
+        {
+            boost::mutex::scoped_lock lock(mutex_);
+            stop_ = true;
+            wakeup_.notify_all();
+        }
+        threads_.join_all();
+    }
+
+    template <typename Functor>
+    void submit(Functor const & f)
+    {
+        boost::mutex::scoped_lock lock(mutex_);
+        tasks_.push_back(f);
+        wakeup_.notify_one();
+    }
+
+    template <typename InputIterator>
+    void submit(InputIterator first, InputIterator last)
+    {
+        boost::mutex::scoped_lock lock(mutex_);
+        tasks_.insert(tasks_.end(), first, last);
+        wakeup_.notify_all();
+    }
+
+private:
+    void run(void)
+    {
+        for (;;) {
+            boost::function<void (void)> task;
+            {
+                boost::mutex::scoped_lock lock(mutex_);
+                while (tasks_.empty() && !stop_)
+                    wakeup_.wait(lock);
+                if (tasks_.empty())
+                    return;
+                task.swap(tasks_.front());
+                tasks_.pop_front();
+            }
+            task();
+        }
+    }
+
+    std::deque<boost::function<void (void)> > tasks_;
+    bool stop_;
+    boost::mutex mutex_;
+    boost::condition_variable wakeup_;
+    boost::thread_group threads_;
+};
+
+double seconds_since(boost::posix_time::ptime start)
+{
+    return (boost::posix_time::microsec_clock::universal_time() - start).total_microseconds() * 1e-6;
+}
+
+void wait_for(atomic<long> & counter, long value)
+{
+    while (counter.load() != value)
+        boost::thread::yield();
+}
+
+struct increment
+{
+    atomic<long> * counter;
+
+    void operator()(void) const
+    {
+        counter->fetch_add(1, boost::lockfree::memory_order_relaxed);
+    }
+};
+
+template <typename Pool>
+struct spawn
+{
+    Pool * pool;
+    atomic<long> * leaves;
+    int depth;
+
+    void operator()(void) const
+    {
+        if (depth == 0) {
+            leaves->fetch_add(1, boost::lockfree::memory_order_relaxed);
+            return;
+        }
+
+        spawn child = {pool, leaves, depth - 1};
+        pool->submit(child);
+        pool->submit(child);
+    }
+};
+
+struct record_latency
+{
+    boost::posix_time::ptime submitted;
+    double * latency;
+    atomic<long> * done;
+
+    void operator()(void) const
+    {
+        *latency = seconds_since(submitted) * 1e6;
+        done->store(1);
+    }
+};
+
+const long external_tasks = 1L << 20;
+const long batch = 256;
+const int spawn_depth = 20;
+const int latency_samples = 200;
+
+template <typename Pool>
+void bench(const char * name, std::size_t workers)
+{
+    /* external submission */
+    atomic<long> counter(0);
+    double external, internal;
+    {
+        Pool pool(workers);
+        increment task = {&counter};
+        std::vector<increment> tasks(batch, task);
+
+        boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+        for (long i = 0; i < external_tasks; i += batch)
+            pool.submit(tasks.begin(), tasks.end());
+        wait_for(counter, external_tasks);
+        external = seconds_since(start);
+    }
+
+    /* recursive spawning */
+    {
+        Pool pool(workers);
+        atomic<long> leaves(0);
+        spawn<Pool> root = {&pool, &leaves, spawn_depth};
+
+        boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+        pool.submit(root);
+        wait_for(leaves, 1L << spawn_depth);
+        internal = seconds_since(start);
+    }
+
+    /* wake-up latency of an idle pool */
+    std::vector<double> latencies(latency_samples);
+    {
+        Pool pool(workers);
+        for (int i = 0; i != latency_samples; ++i) {
+            boost::this_thread::sleep(boost::posix_time::milliseconds(1));
+
+            atomic<long> done(0);
+            record_latency task = {boost::posix_time::microsec_clock::universal_time(), &latencies[i], &done};
+            pool.submit(task);
+            wait_for(done, 1);
+        }
+    }
+    std::sort(latencies.begin(), latencies.end());
+
+    const long spawned = (2L << spawn_depth) - 1;
+    printf("%-12s external %6.2f Mtasks/s, spawned %6.2f Mtasks/s, latency median %6.1fus, 99%% %6.1fus\n",
+           name, external_tasks / external * 1e-6, spawned / internal * 1e-6,
+           latencies[latency_samples / 2], latencies[latency_samples * 99 / 100]);
+}
+
+int main(int argc, char * argv[])
+{
+    int workers = argc > 1 ? std::atoi(argv[1]) : boost::thread::hardware_concurrency();
+    if (workers < 1)
+        workers = 1;
+
+    printf("%d workers\n", workers);
+    bench<boost::lockfree::thread_pool>("thread_pool", workers);
+    bench<mutex_pool>("mutex_pool", workers);
+}
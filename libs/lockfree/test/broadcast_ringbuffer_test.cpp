@@ -0,0 +1,134 @@
+#include <boost/lockfree/broadcast_ringbuffer.hpp>
+
+#include <climits>
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <boost/thread.hpp>
+#include <string>
+
+using namespace boost;
+using namespace boost::lockfree;
+using namespace std;
+
+BOOST_AUTO_TEST_CASE( broadcast_ringbuffer_simple_test )
+{
+    broadcast_ringbuffer<int> rb(4, 2);
+    BOOST_REQUIRE_EQUAL(rb.consumers(), 2u);
+    BOOST_REQUIRE(rb.empty(0));
+
+    for (int i = 0; i != 4; ++i)
+        BOOST_REQUIRE(rb.enqueue(i));
+    BOOST_REQUIRE(!rb.enqueue(4));
+
+    /* the producer is gated on the slowest consumer */
+    int out;
+    for (int i = 0; i != 4; ++i) {
+        BOOST_REQUIRE(rb.dequeue(0, out));
+        BOOST_REQUIRE_EQUAL(out, i);
+    }
+    BOOST_REQUIRE(!rb.dequeue(0, out));
+    BOOST_REQUIRE(!rb.enqueue(4));
+
+    BOOST_REQUIRE(rb.dequeue(1, out));
+    BOOST_REQUIRE_EQUAL(out, 0);
+    BOOST_REQUIRE(rb.enqueue(4));
+    BOOST_REQUIRE(!rb.enqueue(5));
+
+    int data[4];
+    BOOST_REQUIRE_EQUAL(rb.dequeue(1, data, 4), 4u);
+    BOOST_REQUIRE_EQUAL(data[0], 1);
+    BOOST_REQUIRE_EQUAL(data[3], 4);
+    BOOST_REQUIRE(rb.empty(1));
+    BOOST_REQUIRE(!rb.empty(0));
+}
+
+struct string_collector
+{
+    string result;
+
+    void operator()(string const & s)
+    {
+        result += s;
+    }
+};
+
+BOOST_AUTO_TEST_CASE( broadcast_ringbuffer_consume_all_test )
+{
+    broadcast_ringbuffer<string> rb(3, 3);
+
+    const string strings[] = {"a", "b", "c", "d", "e"};
+    BOOST_REQUIRE_EQUAL(rb.enqueue(strings, 5), 3u);
+
+    string_collector collectors[3];
+    for (int i = 0; i != 3; ++i) {
+        BOOST_REQUIRE_EQUAL(rb.consume_all(i, collectors[i]), 3u);
+        BOOST_REQUIRE_EQUAL(collectors[i].result, "abc");
+    }
+
+    /* slots are reused */
+    BOOST_REQUIRE_EQUAL(rb.enqueue(strings + 3, 2), 2u);
+    for (int i = 0; i != 3; ++i) {
+        BOOST_REQUIRE_EQUAL(rb.consume_all(i, collectors[i]), 2u);
+        BOOST_REQUIRE_EQUAL(collectors[i].result, "abcde");
+    }
+}
+
+static const long nodes = 1000000;
+static const int consumer_count = 3;
+
+struct broadcast_ringbuffer_tester
+{
+    broadcast_ringbuffer<long> rb;
+    long sums[consumer_count];
+
+    broadcast_ringbuffer_tester(void):
+        rb(1024, consumer_count)
+    {}
+
+    void produce(void)
+    {
+        for (long i = 0; i != nodes; ++i)
+            while (!rb.enqueue(i))
+                boost::thread::yield();
+    }
+
+    /* every consumer receives every element in order */
+    void consume(int consumer)
+    {
+        long expected = 0, sum = 0;
+        long buffer[64];
+        while (expected != nodes) {
+            size_t count = rb.dequeue(consumer, buffer, 64);
+            for (size_t i = 0; i != count; ++i) {
+                if (buffer[i] == expected)
+                    sum += buffer[i];
+                ++expected;
+            }
+            if (count == 0)
+                boost::thread::yield();
+        }
+        sums[consumer] = sum;
+    }
+
+    void run(void)
+    {
+        thread_group consumers;
+        for (int i = 0; i != consumer_count; ++i)
+            consumers.create_thread(boost::bind(&broadcast_ringbuffer_tester::consume, this, i));
+        produce();
+        consumers.join_all();
+
+        for (int i = 0; i != consumer_count; ++i) {
+            BOOST_REQUIRE_EQUAL(sums[i], nodes * (nodes - 1) / 2);
+            BOOST_REQUIRE(rb.empty(i));
+        }
+    }
+};
+
+BOOST_AUTO_TEST_CASE( broadcast_ringbuffer_test )
+{
+    broadcast_ringbuffer_tester tester;
+    tester.run();
+}
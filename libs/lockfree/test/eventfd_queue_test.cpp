@@ -0,0 +1,177 @@
+#include <boost/lockfree/eventfd_queue.hpp>
+#include <boost/lockfree/fifo.hpp>
+
+#include <climits>
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <boost/thread.hpp>
+#include <iostream>
+
+#include <poll.h>
+#include <sys/epoll.h>
+
+#include "test_helpers.hpp"
+
+using namespace boost;
+using namespace boost::lockfree;
+using namespace std;
+
+namespace {
+
+bool readable(int fd)
+{
+    pollfd pfd;
+    pfd.fd = fd;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    return poll(&pfd, 1, 0) == 1;
+}
+
+struct counter
+{
+    counter(void):
+        count(0), sum(0)
+    {}
+
+    void operator()(int i)
+    {
+        ++count;
+        sum += i;
+    }
+
+    long count, sum;
+};
+
+}
+
+BOOST_AUTO_TEST_CASE( simple_eventfd_queue_test )
+{
+    eventfd_queue<ringbuffer<int, 64> > q;
+
+    BOOST_REQUIRE(q.empty());
+    BOOST_REQUIRE(!readable(q.native_handle()));
+
+    BOOST_REQUIRE(q.enqueue(1));
+    BOOST_REQUIRE(readable(q.native_handle()));
+    BOOST_REQUIRE(q.enqueue(2));
+
+    counter c;
+    BOOST_REQUIRE_EQUAL(q.consume_all(c), 2u);
+    BOOST_REQUIRE_EQUAL(c.sum, 3);
+
+    BOOST_REQUIRE(q.empty());
+    BOOST_REQUIRE(!readable(q.native_handle()));
+}
+
+BOOST_AUTO_TEST_CASE( eventfd_queue_coalescing_test )
+{
+    eventfd_queue<fifo<int> > q(128);
+
+    for (int i = 0; i != 100; ++i)
+        BOOST_REQUIRE(q.enqueue(i));
+
+    /* only the first enqueue has written to the eventfd */
+    BOOST_REQUIRE_EQUAL(q.acknowledge(), 1u);
+
+    int out[128];
+    BOOST_REQUIRE_EQUAL(q.dequeue(out, 128), 100u);
+    for (int i = 0; i != 100; ++i)
+        BOOST_REQUIRE_EQUAL(out[i], i);
+
+    BOOST_REQUIRE(q.rearm());
+    BOOST_REQUIRE(!readable(q.native_handle()));
+
+    BOOST_REQUIRE(q.enqueue(1));
+    BOOST_REQUIRE_EQUAL(q.acknowledge(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE( eventfd_queue_rearm_test )
+{
+    eventfd_queue<ringbuffer<int, 0> > q(16);
+
+    BOOST_REQUIRE(q.enqueue(1));
+    q.acknowledge();
+
+    /* consumer is active, so this enqueue is not signalled. rearm has to detect it */
+    BOOST_REQUIRE(q.enqueue(2));
+    BOOST_REQUIRE(!readable(q.native_handle()));
+    BOOST_REQUIRE(!q.rearm());
+
+    int out;
+    BOOST_REQUIRE(q.dequeue(out));
+    BOOST_REQUIRE(q.dequeue(out));
+    BOOST_REQUIRE(q.rearm());
+}
+
+static const long nodes_per_thread = 200000;
+
+template <typename Queue>
+struct eventfd_queue_tester
+{
+    eventfd_queue<Queue> q;
+    counter received;
+
+    eventfd_queue_tester(void):
+        q(1024)
+    {}
+
+    void add(void)
+    {
+        for (long i = 0; i != nodes_per_thread; ++i) {
+            while (!q.enqueue(i))
+                thread::yield();
+
+            /* produce in bursts */
+            if (i % 1000 == 0)
+                thread::sleep(get_system_time() + posix_time::microseconds(50));
+        }
+    }
+
+    void get(void)
+    {
+        int epfd = epoll_create1(EPOLL_CLOEXEC);
+        assert(epfd != -1);
+
+        epoll_event ev;
+        ev.events = EPOLLIN;
+        ev.data.fd = q.native_handle();
+        int status = epoll_ctl(epfd, EPOLL_CTL_ADD, q.native_handle(), &ev);
+        assert(status == 0);
+
+        while (received.count != nodes_per_thread) {
+            epoll_event event;
+            int ready = epoll_wait(epfd, &event, 1, 1000);
+            assert(ready >= 0);
+            if (ready == 1)
+                q.consume_all(received);
+        }
+        close(epfd);
+    }
+
+    void run(void)
+    {
+        thread reader(boost::bind(&eventfd_queue_tester::get, this));
+        thread writer(boost::bind(&eventfd_queue_tester::add, this));
+
+        writer.join();
+        reader.join();
+
+        BOOST_REQUIRE_EQUAL(received.count, nodes_per_thread);
+        BOOST_REQUIRE_EQUAL(received.sum, nodes_per_thread * (nodes_per_thread - 1) / 2);
+        BOOST_REQUIRE(q.empty());
+    }
+};
+
+BOOST_AUTO_TEST_CASE( eventfd_queue_test_ringbuffer )
+{
+    eventfd_queue_tester<ringbuffer<long, 0> > tester;
+    tester.run();
+}
+
+BOOST_AUTO_TEST_CASE( eventfd_queue_test_fifo )
+{
+    eventfd_queue_tester<fifo<long> > tester;
+    tester.run();
+}
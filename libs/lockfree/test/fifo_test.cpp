@@ -9,6 +9,7 @@
 #include <boost/thread.hpp>
 #include <iostream>
 #include <memory>
+#include <string>
 
 
 #include "test_helpers.hpp"
@@ -91,10 +92,90 @@ BOOST_AUTO_TEST_CASE( fifo_specialization_test )
     BOOST_REQUIRE(f.empty());
 }
 
-template <typename freelist_t>
+/* non-trivial element type, which owns heap memory */
+struct boxed_int
+{
+    boxed_int(void):
+        value(new int(0))
+    {}
+
+    boxed_int(int i):
+        value(new int(i))
+    {}
+
+    boxed_int(boxed_int const & rhs):
+        value(new int(*rhs.value))
+    {}
+
+    boxed_int & operator=(boxed_int const & rhs)
+    {
+        *value = *rhs.value;
+        return *this;
+    }
+
+    ~boxed_int(void)
+    {
+        delete value;
+    }
+
+    operator int(void) const
+    {
+        return *value;
+    }
+
+    int * value;
+};
+
+BOOST_AUTO_TEST_CASE( fifo_nontrivial_test )
+{
+    fifo<std::string> f(64);
+
+    f.enqueue("foo");
+    f.enqueue_unsafe(std::string(100, 'x'));
+
+    std::string out;
+    BOOST_REQUIRE(f.dequeue(out));
+    BOOST_REQUIRE_EQUAL(out, "foo");
+    BOOST_REQUIRE(f.dequeue_unsafe(out));
+    BOOST_REQUIRE_EQUAL(out, std::string(100, 'x'));
+    BOOST_REQUIRE(!f.dequeue(out));
+
+    /* remaining objects are destroyed by the fifo */
+    f.enqueue("bar");
+    f.enqueue("baz");
+    BOOST_REQUIRE(f.dequeue(out));
+    BOOST_REQUIRE_EQUAL(out, "bar");
+}
+
+#if !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES) && !defined(BOOST_NO_CXX11_SMART_PTR)
+BOOST_AUTO_TEST_CASE( fifo_move_only_test )
+{
+    fifo<std::unique_ptr<int> > f(64);
+
+    BOOST_REQUIRE(f.enqueue(std::unique_ptr<int>(new int(1))));
+    BOOST_REQUIRE(f.emplace(new int(2)));
+    BOOST_REQUIRE(f.emplace_unsafe(new int(3)));
+
+    std::unique_ptr<int> out;
+    for (int i = 1; i != 4; ++i) {
+        BOOST_REQUIRE(f.dequeue(out));
+        BOOST_REQUIRE_EQUAL(*out, i);
+    }
+    BOOST_REQUIRE(f.empty());
+
+    fifo<std::pair<int, std::string> > f2(4);
+    BOOST_REQUIRE(f2.emplace(1, "one"));
+    std::pair<int, std::string> p;
+    BOOST_REQUIRE(f2.dequeue(p));
+    BOOST_REQUIRE_EQUAL(p.first, 1);
+    BOOST_REQUIRE_EQUAL(p.second, "one");
+}
+#endif
+
+template <typename freelist_t, typename T = int>
 struct fifo_tester
 {
-    fifo<int, freelist_t> sf;
+    fifo<T, freelist_t> sf;
 
     boost::lockfree::detail::atomic<long> fifo_cnt, received_nodes;
 
@@ -133,7 +214,7 @@ struct fifo_tester
 
     bool get_element(void)
     {
-        int data;
+        T data;
 
         bool success = sf.dequeue(data);
 
@@ -155,8 +236,9 @@ struct fifo_tester
     {
         for(;;)
         {
+            bool writers_done = not running;
             bool success = get_element();
-            if (not running and not success)
+            if (writers_done and not success)
                 return;
             if (not success)
                 thread::yield();
@@ -204,3 +286,9 @@ BOOST_AUTO_TEST_CASE( fifo_test_static )
     fifo_tester<boost::lockfree::static_freelist_t> test1;
     test1.run();
 }
+
+BOOST_AUTO_TEST_CASE( fifo_test_nontrivial )
+{
+    fifo_tester<boost::lockfree::caching_freelist_t, boxed_int> test1;
+    test1.run();
+}
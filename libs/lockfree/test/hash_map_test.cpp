@@ -0,0 +1,189 @@
+#include <boost/lockfree/hash_map.hpp>
+
+#include <climits>
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <boost/thread.hpp>
+
+using namespace boost;
+using namespace boost::lockfree;
+using namespace std;
+
+namespace {
+
+/* forces all keys into the same run of the split-ordered list */
+struct constant_hash
+{
+    std::size_t operator()(long) const
+    {
+        return 42;
+    }
+};
+
+}
+
+BOOST_AUTO_TEST_CASE( hash_map_simple_test )
+{
+    hash_map<long, long> m;
+    BOOST_REQUIRE(m.empty());
+
+    BOOST_REQUIRE(m.insert(1, 10));
+    BOOST_REQUIRE(m.insert(2, 20));
+    BOOST_REQUIRE(!m.insert(1, 11));
+    BOOST_REQUIRE_EQUAL(m.size(), 2u);
+
+    long out;
+    BOOST_REQUIRE(m.find(1, out)); BOOST_REQUIRE_EQUAL(out, 10);
+    BOOST_REQUIRE(m.find(2, out)); BOOST_REQUIRE_EQUAL(out, 20);
+    BOOST_REQUIRE(!m.contains(3));
+
+    BOOST_REQUIRE(m.erase(1));
+    BOOST_REQUIRE(!m.erase(1));
+    BOOST_REQUIRE(!m.contains(1));
+    BOOST_REQUIRE(m.contains(2));
+
+    BOOST_REQUIRE(m.insert(1, 12));
+    BOOST_REQUIRE(m.find(1, out)); BOOST_REQUIRE_EQUAL(out, 12);
+    BOOST_REQUIRE_EQUAL(m.size(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE( hash_map_grow_test )
+{
+    hash_map<long, long> m;
+    const size_t initial_buckets = m.bucket_count();
+
+    for (long i = 0; i != 100000; ++i)
+        BOOST_REQUIRE(m.insert(i, -i));
+
+    BOOST_REQUIRE_GT(m.bucket_count(), initial_buckets);
+    BOOST_REQUIRE_EQUAL(m.size(), 100000u);
+
+    for (long i = 0; i != 100000; ++i) {
+        long out;
+        BOOST_REQUIRE(m.find(i, out));
+        BOOST_REQUIRE_EQUAL(out, -i);
+    }
+
+    for (long i = 0; i != 100000; i += 2)
+        BOOST_REQUIRE(m.erase(i));
+
+    for (long i = 0; i != 100000; ++i)
+        BOOST_REQUIRE_EQUAL(m.contains(i), (i % 2) == 1);
+}
+
+BOOST_AUTO_TEST_CASE( hash_map_collision_test )
+{
+    hash_map<long, long, constant_hash> m;
+
+    for (long i = 0; i != 64; ++i)
+        BOOST_REQUIRE(m.insert(i, i));
+    for (long i = 0; i != 64; ++i)
+        BOOST_REQUIRE(!m.insert(i, i));
+
+    for (long i = 0; i < 64; i += 3)
+        BOOST_REQUIRE(m.erase(i));
+
+    for (long i = 0; i != 64; ++i)
+        BOOST_REQUIRE_EQUAL(m.contains(i), (i % 3) != 0);
+}
+
+BOOST_AUTO_TEST_CASE( hash_map_static_freelist_test )
+{
+    hash_map<long, long, boost::hash<long>, std::equal_to<long>, static_freelist_t> m(8);
+
+    /* some nodes are used by the dummy nodes of the buckets */
+    long inserted = 0;
+    while (m.insert(inserted, inserted))
+        ++inserted;
+
+    BOOST_REQUIRE_GT(inserted, 0);
+    BOOST_REQUIRE_LE(inserted, 8);
+
+    BOOST_REQUIRE(m.erase(0));
+    BOOST_REQUIRE(m.insert(100, 100));
+}
+
+namespace {
+
+const long keys_per_thread = 20000;
+const int writer_threads = 2;
+const int reader_threads = 2;
+
+struct hash_map_tester
+{
+    hash_map<long, long> m;
+    boost::lockfree::detail::atomic<bool> running;
+
+    hash_map_tester(void):
+        running(true)
+    {}
+
+    /* every writer owns the keys [first, first + keys_per_thread[ and inserts and erases them repeatedly */
+    void write(long first)
+    {
+        for (int round = 0; round != 4; ++round) {
+            for (long i = first; i != first + keys_per_thread; ++i) {
+                bool inserted = m.insert(i, i * 2);
+                assert(inserted);
+            }
+            for (long i = first; i != first + keys_per_thread; i += 2) {
+                bool erased = m.erase(i);
+                assert(erased);
+            }
+            if (round != 3)
+                for (long i = first + 1; i < first + keys_per_thread; i += 2) {
+                    bool erased = m.erase(i);
+                    assert(erased);
+                }
+        }
+    }
+
+    /* the keys [-keys_per_thread, 0[ are never modified, so they must always be found */
+    void read(void)
+    {
+        long count = 0;
+        while (running.load() || count < keys_per_thread) {
+            for (long i = -keys_per_thread; i != 0; ++i, ++count) {
+                long out;
+                bool found = m.find(i, out);
+                assert(found);
+                assert(out == i * 2);
+                (void)found;
+            }
+
+            long out;
+            for (long i = 0; i != writer_threads * keys_per_thread; ++i)
+                if (m.find(i, out))
+                    assert(out == i * 2);
+
+            boost::thread::yield();
+        }
+    }
+};
+
+}
+
+BOOST_AUTO_TEST_CASE( hash_map_threaded_test )
+{
+    hash_map_tester tester;
+    BOOST_WARN(tester.m.is_lock_free());
+
+    for (long i = -keys_per_thread; i != 0; ++i)
+        BOOST_REQUIRE(tester.m.insert(i, i * 2));
+
+    thread_group readers, writers;
+    for (int i = 0; i != reader_threads; ++i)
+        readers.create_thread(boost::bind(&hash_map_tester::read, &tester));
+    for (int i = 0; i != writer_threads; ++i)
+        writers.create_thread(boost::bind(&hash_map_tester::write, &tester, i * keys_per_thread));
+
+    writers.join_all();
+    tester.running.store(false);
+    readers.join_all();
+
+    BOOST_REQUIRE_EQUAL(tester.m.size(), size_t(keys_per_thread + writer_threads * keys_per_thread / 2));
+    for (long i = 0; i != writer_threads * keys_per_thread; ++i)
+        BOOST_REQUIRE_EQUAL(tester.m.contains(i), (i % 2) == 1);
+}
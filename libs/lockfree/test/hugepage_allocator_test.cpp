@@ -0,0 +1,126 @@
+#include <boost/lockfree/hugepage_allocator.hpp>
+#include <boost/lockfree/fifo.hpp>
+#include <boost/lockfree/ringbuffer.hpp>
+#include <boost/lockfree/stack.hpp>
+
+#include <climits>
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <boost/thread.hpp>
+#include <set>
+
+#include "test_helpers.hpp"
+
+using namespace boost;
+using namespace boost::lockfree;
+using namespace std;
+
+BOOST_AUTO_TEST_CASE( hugepage_allocator_test )
+{
+    hugepage_allocator<long> alloc;
+
+    /* mapped individually */
+    const size_t large = 3 * 1024 * 1024 / sizeof(long);
+    long * p = alloc.allocate(large);
+    for (size_t i = 0; i != large; ++i)
+        p[i] = i;
+    BOOST_REQUIRE_EQUAL(p[large - 1], long(large - 1));
+    alloc.deallocate(p, large);
+
+    /* carved out of chunks, cache-line aligned and spanning several chunks */
+    std::set<long*> small;
+    for (int i = 0; i != 100000; ++i) {
+        long * q = alloc.allocate(1);
+        BOOST_REQUIRE_EQUAL(reinterpret_cast<size_t>(q) % BOOST_LOCKFREE_CACHELINE_BYTES, 0u);
+        *q = i;
+        BOOST_REQUIRE(small.insert(q).second);
+    }
+
+    /* rebound copies share their chunks */
+    hugepage_allocator<char> rebound(alloc);
+    BOOST_REQUIRE(rebound == alloc);
+    BOOST_REQUIRE(hugepage_allocator<long>() != alloc);
+}
+
+BOOST_AUTO_TEST_CASE( hugepage_allocator_flags_test )
+{
+    /* falls back to transparent huge pages, if no huge pages are reserved */
+    hugepage_allocator<char> alloc(0, hugepage_allocator<char>::explicit_hugepages | hugepage_allocator<char>::prefault);
+
+    char * p = alloc.allocate(4 * 1024 * 1024);
+    p[0] = p[4 * 1024 * 1024 - 1] = 1;
+    alloc.deallocate(p, 4 * 1024 * 1024);
+
+    char * q = alloc.allocate(100);
+    q[99] = 1;
+    alloc.deallocate(q, 100);
+}
+
+BOOST_AUTO_TEST_CASE( hugepage_allocator_numa_test )
+{
+    /* nonexistent numa node */
+    hugepage_allocator<char> alloc(100000);
+    BOOST_REQUIRE_THROW(alloc.allocate(1 << 20), boost::system::system_error);
+}
+
+BOOST_AUTO_TEST_CASE( hugepage_ringbuffer_test )
+{
+    typedef hugepage_allocator<int> allocator;
+    ringbuffer<int, 0, allocator> rb(1 << 20, allocator(0, allocator::transparent_hugepages | allocator::prefault));
+
+    for (int i = 0; i != 1000; ++i)
+        BOOST_REQUIRE(rb.enqueue(i));
+
+    int out;
+    for (int i = 0; i != 1000; ++i) {
+        BOOST_REQUIRE(rb.dequeue(out));
+        BOOST_REQUIRE_EQUAL(out, i);
+    }
+    BOOST_REQUIRE(rb.empty());
+}
+
+static const int nodes_per_thread = 100000;
+
+template <typename Stack>
+void push_nodes(Stack * stk)
+{
+    for (int i = 0; i != nodes_per_thread; ++i) {
+        bool pushed = stk->push(i);
+        assert(pushed);
+    }
+}
+
+BOOST_AUTO_TEST_CASE( hugepage_stack_test )
+{
+    typedef stack<int, caching_freelist_t, hugepage_allocator<int> > stack_type;
+    stack_type stk(16, hugepage_allocator<int>(0));
+
+    /* the caching freelist allocates nodes concurrently */
+    thread_group writers;
+    for (int i = 0; i != 4; ++i)
+        writers.create_thread(boost::bind(&push_nodes<stack_type>, &stk));
+    writers.join_all();
+
+    long sum = 0;
+    int out;
+    while (stk.pop(out))
+        sum += out;
+    BOOST_REQUIRE_EQUAL(sum, 4L * nodes_per_thread * (nodes_per_thread - 1) / 2);
+}
+
+BOOST_AUTO_TEST_CASE( hugepage_fifo_test )
+{
+    fifo<int, caching_freelist_t, hugepage_allocator<int> > f(128, hugepage_allocator<int>());
+
+    for (int i = 0; i != 1000; ++i)
+        BOOST_REQUIRE(f.enqueue(i));
+
+    int out;
+    for (int i = 0; i != 1000; ++i) {
+        BOOST_REQUIRE(f.dequeue(out));
+        BOOST_REQUIRE_EQUAL(out, i);
+    }
+    BOOST_REQUIRE(f.empty());
+}
@@ -0,0 +1,138 @@
+#include <boost/lockfree/interprocess_ringbuffer.hpp>
+
+#include <climits>
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace boost;
+using namespace boost::lockfree;
+using namespace std;
+
+namespace {
+
+/* unique shared memory name, which is removed at the end of the test */
+struct shm_name
+{
+    shm_name(const char * suffix)
+    {
+        char buffer[64];
+        snprintf(buffer, sizeof(buffer), "/boost_lockfree_test_%d_%s", int(getpid()), suffix);
+        name = buffer;
+    }
+
+    ~shm_name(void)
+    {
+        interprocess_ringbuffer<int>::remove(name.c_str());
+    }
+
+    std::string name;
+};
+
+}
+
+BOOST_AUTO_TEST_CASE( interprocess_ringbuffer_simple_test )
+{
+    shm_name name("simple");
+
+    interprocess_ringbuffer<int> producer(create_only, name.name.c_str(), 64);
+    interprocess_ringbuffer<int> consumer(open_only, name.name.c_str());
+
+    BOOST_REQUIRE(producer.empty());
+    BOOST_REQUIRE(producer.enqueue(1));
+    BOOST_REQUIRE(!consumer.empty());
+
+    int data[100];
+    for (int i = 0; i != 100; ++i)
+        data[i] = i + 2;
+    BOOST_REQUIRE_EQUAL(producer.enqueue(data, 100), 62u);
+
+    int out;
+    BOOST_REQUIRE(consumer.dequeue(out));
+    BOOST_REQUIRE_EQUAL(out, 1);
+    BOOST_REQUIRE_EQUAL(consumer.dequeue(data, 100), 62u);
+    BOOST_REQUIRE_EQUAL(data[61], 63);
+    BOOST_REQUIRE(producer.empty());
+}
+
+BOOST_AUTO_TEST_CASE( interprocess_ringbuffer_header_test )
+{
+    shm_name name("header");
+
+    BOOST_REQUIRE_THROW(interprocess_ringbuffer<int>(open_only, name.name.c_str()), boost::system::system_error);
+
+    interprocess_ringbuffer<int> rb(create_only, name.name.c_str(), 64);
+    BOOST_REQUIRE_THROW(interprocess_ringbuffer<int>(create_only, name.name.c_str(), 64), boost::system::system_error);
+
+    /* element size does not match */
+    BOOST_REQUIRE_THROW(interprocess_ringbuffer<long long>(open_only, name.name.c_str()), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE( interprocess_ringbuffer_file_test )
+{
+    FILE * file = tmpfile();
+    BOOST_REQUIRE(file);
+
+    interprocess_ringbuffer<int> producer(create_only, fileno(file), 16);
+    interprocess_ringbuffer<int> consumer(open_only, fileno(file));
+    fclose(file);
+
+    BOOST_REQUIRE(producer.enqueue(42));
+    int out;
+    BOOST_REQUIRE(consumer.dequeue(out));
+    BOOST_REQUIRE_EQUAL(out, 42);
+}
+
+static const long nodes = 1000000;
+
+BOOST_AUTO_TEST_CASE( interprocess_ringbuffer_test )
+{
+    shm_name name("fork");
+    interprocess_ringbuffer<long> rb(create_only, name.name.c_str(), 1024);
+
+    pid_t child = fork();
+    BOOST_REQUIRE(child != -1);
+
+    if (child == 0) {
+        /* producer process */
+        interprocess_ringbuffer<long> producer(open_only, name.name.c_str());
+        for (long i = 0; i != nodes; ++i)
+            while (!producer.enqueue(i))
+                usleep(0);
+        _exit(0);
+    }
+
+    bool sequence_ok = true;
+    long expected = 0;
+    long buffer[256];
+    int status;
+    bool exited = false;
+    while (expected != nodes) {
+        size_t count = rb.dequeue(buffer, 256);
+        for (size_t i = 0; i != count; ++i)
+            if (buffer[i] != expected++)
+                sequence_ok = false;
+        if (count == 0) {
+            /* the producer has exited early and the ring is drained, do not wait for the missing elements */
+            if (exited)
+                break;
+            exited = waitpid(child, &status, WNOHANG) == child;
+            if (!exited)
+                usleep(0);
+        }
+    }
+
+    if (!exited)
+        BOOST_REQUIRE_EQUAL(waitpid(child, &status, 0), child);
+    BOOST_REQUIRE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    BOOST_REQUIRE_EQUAL(expected, nodes);
+    BOOST_REQUIRE(sequence_ok);
+    BOOST_REQUIRE(rb.empty());
+}
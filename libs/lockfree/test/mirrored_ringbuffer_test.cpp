@@ -0,0 +1,131 @@
+#include <boost/lockfree/mirrored_ringbuffer.hpp>
+
+#include <climits>
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <boost/thread.hpp>
+#include <iterator>
+#include <vector>
+
+#include <unistd.h>
+
+using namespace boost;
+using namespace boost::lockfree;
+using namespace std;
+
+struct triple
+{
+    char c[3];
+};
+
+BOOST_AUTO_TEST_CASE( mirrored_ringbuffer_capacity_test )
+{
+    const size_t page_size = sysconf(_SC_PAGESIZE);
+
+    mirrored_ringbuffer<int> rb(100);
+    BOOST_REQUIRE_EQUAL(rb.capacity(), page_size / sizeof(int));
+
+    /* element size, which does not divide the page size */
+    mirrored_ringbuffer<triple> rb3(100);
+    BOOST_REQUIRE_EQUAL(rb3.capacity() * sizeof(triple) % page_size, 0u);
+}
+
+BOOST_AUTO_TEST_CASE( mirrored_ringbuffer_wrap_test )
+{
+    mirrored_ringbuffer<int> rb(1);
+    const size_t capacity = rb.capacity();
+
+    vector<int> data(capacity);
+    for (size_t i = 0; i != capacity; ++i)
+        data[i] = i;
+
+    /* move the indices close to the end of the buffer */
+    BOOST_REQUIRE_EQUAL(rb.enqueue(&data[0], capacity - 10), capacity - 10);
+    BOOST_REQUIRE_EQUAL(rb.dequeue(&data[0], capacity - 10), capacity - 10);
+
+    /* writes and reads across the wrap-around point are contiguous */
+    size_t size;
+    int * span = rb.write_span(size);
+    BOOST_REQUIRE_EQUAL(size, capacity - 1);
+    for (size_t i = 0; i != 100; ++i)
+        span[i] = 1000 + i;
+    rb.commit_write(100);
+
+    int out[100];
+    BOOST_REQUIRE(rb.dequeue(out[0]));
+    BOOST_REQUIRE_EQUAL(out[0], 1000);
+    BOOST_REQUIRE_EQUAL(rb.dequeue(out, 20), 20u);
+    BOOST_REQUIRE_EQUAL(out[19], 1020);
+
+    int const * read = rb.read_span(size);
+    BOOST_REQUIRE_EQUAL(size, 79u);
+    BOOST_REQUIRE_EQUAL(read[0], 1021);
+    BOOST_REQUIRE_EQUAL(read[78], 1099);
+    rb.commit_read(79);
+    BOOST_REQUIRE(rb.empty());
+
+    vector<int> result;
+    BOOST_REQUIRE(rb.enqueue(data.begin(), data.begin() + 50) == data.begin() + 50);
+    BOOST_REQUIRE_EQUAL(rb.dequeue(back_inserter(result)), 50u);
+    BOOST_REQUIRE(std::equal(result.begin(), result.end(), data.begin()));
+}
+
+static const long nodes = 2000000;
+
+struct mirrored_ringbuffer_tester
+{
+    mirrored_ringbuffer<long> rb;
+    bool sequence_ok;
+
+    mirrored_ringbuffer_tester(void):
+        rb(4096), sequence_ok(true)
+    {}
+
+    void add(void)
+    {
+        long i = 0;
+        while (i != nodes) {
+            size_t size;
+            long * span = rb.write_span(size);
+            size = std::min<size_t>(size, nodes - i);
+            for (size_t j = 0; j != size; ++j)
+                span[j] = i++;
+            rb.commit_write(size);
+            if (size == 0)
+                thread::yield();
+        }
+    }
+
+    void get(void)
+    {
+        long expected = 0;
+        long buffer[1000];
+        while (expected != nodes) {
+            size_t count = rb.dequeue(buffer, 1000);
+            if (count == 0)
+                thread::yield();
+            for (size_t j = 0; j != count; ++j)
+                if (buffer[j] != expected++)
+                    sequence_ok = false;
+        }
+    }
+
+    void run(void)
+    {
+        thread reader(boost::bind(&mirrored_ringbuffer_tester::get, this));
+        thread writer(boost::bind(&mirrored_ringbuffer_tester::add, this));
+        writer.join();
+        reader.join();
+
+        BOOST_REQUIRE(sequence_ok);
+        BOOST_REQUIRE(rb.empty());
+    }
+};
+
+BOOST_AUTO_TEST_CASE( mirrored_ringbuffer_test )
+{
+    mirrored_ringbuffer_tester tester;
+    tester.run();
+}
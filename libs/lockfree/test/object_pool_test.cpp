@@ -0,0 +1,208 @@
+#include <boost/lockfree/object_pool.hpp>
+
+#include <climits>
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <boost/thread.hpp>
+
+#include <set>
+#include <vector>
+
+using namespace boost;
+using namespace boost::lockfree;
+using namespace std;
+
+namespace {
+
+boost::lockfree::detail::atomic<int> live_objects(0);
+
+struct counted
+{
+    explicit counted(long value = 0):
+        value(value)
+    {
+        live_objects.fetch_add(1);
+    }
+
+    ~counted(void)
+    {
+        live_objects.fetch_sub(1);
+    }
+
+    long value;
+    char payload[40];
+};
+
+}
+
+BOOST_AUTO_TEST_CASE( object_pool_construct_test )
+{
+    object_pool<counted> pool(4);
+    BOOST_WARN(pool.is_lock_free());
+
+    counted * a = pool.construct();
+    counted * b = pool.construct(42L);
+    BOOST_REQUIRE(a && b && a != b);
+    BOOST_REQUIRE_EQUAL(a->value, 0);
+    BOOST_REQUIRE_EQUAL(b->value, 42);
+    BOOST_REQUIRE_EQUAL(live_objects.load(), 2);
+
+    pool.destruct(a);
+    pool.destruct_unsafe(b);
+    BOOST_REQUIRE_EQUAL(live_objects.load(), 0);
+
+    /* the pool grows beyond the reserved objects */
+    vector<counted*> objects;
+    for (int i = 0; i != 16; ++i)
+        objects.push_back(pool.construct_unsafe(long(i)));
+    BOOST_REQUIRE_EQUAL(set<counted*>(objects.begin(), objects.end()).size(), 16u);
+    for (int i = 0; i != 16; ++i) {
+        BOOST_REQUIRE_EQUAL(objects[i]->value, i);
+        pool.destruct(objects[i]);
+    }
+    BOOST_REQUIRE_EQUAL(live_objects.load(), 0);
+}
+
+BOOST_AUTO_TEST_CASE( object_pool_fixed_capacity_test )
+{
+    object_pool<char, static_freelist_t> pool(8);
+
+    vector<char*> objects;
+    for (int i = 0; i != 8; ++i) {
+        char * c = pool.allocate();
+        BOOST_REQUIRE(c);
+        *c = char(i);
+        objects.push_back(c);
+    }
+    BOOST_REQUIRE(pool.allocate() == NULL);
+
+    pool.deallocate(objects.back());
+    BOOST_REQUIRE(pool.allocate() == objects.back());
+
+    for (int i = 0; i != 8; ++i)
+        pool.deallocate(objects[i]);
+}
+
+BOOST_AUTO_TEST_CASE( object_pool_thread_cache_test )
+{
+    /* cache size 4: the fifth deallocation overflows the cache of the calling thread */
+    object_pool<long, static_freelist_t> pool(8, 64, 4);
+
+    vector<long*> objects;
+    for (int i = 0; i != 8; ++i)
+        objects.push_back(pool.allocate());
+    BOOST_REQUIRE(pool.allocate() == NULL);
+
+    for (int i = 0; i != 8; ++i)
+        pool.deallocate(objects[i]);
+
+    /* the objects in the cache and in the shared freelist are allocated again */
+    set<long*> reallocated;
+    for (int i = 0; i != 8; ++i)
+        reallocated.insert(pool.allocate());
+    BOOST_REQUIRE(pool.allocate() == NULL);
+    BOOST_REQUIRE(reallocated == set<long*>(objects.begin(), objects.end()));
+
+    for (set<long*>::iterator it = reallocated.begin(); it != reallocated.end(); ++it)
+        pool.deallocate(*it);
+}
+
+namespace {
+
+void assign_thread_index(void)
+{
+    boost::lockfree::detail::thread_index();
+}
+
+template <typename Pool>
+void allocate_and_deallocate(Pool * pool, int count)
+{
+    vector<long*> objects;
+    for (int i = 0; i != count; ++i)
+        objects.push_back(pool->allocate());
+    for (int i = 0; i != count; ++i)
+        pool->deallocate(objects[i]);
+}
+
+}
+
+BOOST_AUTO_TEST_CASE( object_pool_fresh_thread_cache_test )
+{
+    /* the indices of the following threads are larger than the number of caches */
+    for (int i = 0; i != 4; ++i) {
+        boost::thread t(&assign_thread_index);
+        t.join();
+    }
+
+    typedef object_pool<long, static_freelist_t> pool_type;
+    pool_type pool(4, 2, 8);
+
+    /* the objects are kept in the cache of the thread, so the shared freelist is empty */
+    boost::thread t(boost::bind(&allocate_and_deallocate<pool_type>, &pool, 4));
+    t.join();
+    BOOST_REQUIRE(pool.allocate_unsafe() == NULL);
+
+    /* the cached objects of the thread, which has exited, are allocated by another thread */
+    vector<long*> objects;
+    for (int i = 0; i != 4; ++i) {
+        objects.push_back(pool.allocate());
+        BOOST_REQUIRE(objects.back());
+    }
+    BOOST_REQUIRE(pool.allocate() == NULL);
+
+    for (int i = 0; i != 4; ++i)
+        pool.deallocate(objects[i]);
+}
+
+namespace {
+
+const int thread_count = 4;
+const int objects_per_thread = 64;
+const int rounds = 2000;
+
+/* every thread allocates a batch of objects, checks that no other thread owns them and frees them */
+template <typename Pool>
+void churn(Pool * pool, long id)
+{
+    for (int round = 0; round != rounds; ++round) {
+        counted * objects[objects_per_thread];
+        for (int i = 0; i != objects_per_thread; ++i) {
+            objects[i] = pool->construct(id);
+            assert(objects[i]);
+        }
+
+        boost::thread::yield();
+
+        for (int i = 0; i != objects_per_thread; ++i) {
+            assert(objects[i]->value == id);
+            pool->destruct(objects[i]);
+        }
+    }
+}
+
+template <typename Pool>
+void run_threaded_test(Pool & pool)
+{
+    thread_group threads;
+    for (int i = 0; i != thread_count; ++i)
+        threads.create_thread(boost::bind(&churn<Pool>, &pool, long(i)));
+    threads.join_all();
+
+    BOOST_REQUIRE_EQUAL(live_objects.load(), 0);
+}
+
+}
+
+BOOST_AUTO_TEST_CASE( object_pool_threaded_test )
+{
+    object_pool<counted> shared;
+    run_threaded_test(shared);
+
+    object_pool<counted> cached(0, thread_count + 2, 16);
+    run_threaded_test(cached);
+
+    object_pool<counted, static_freelist_t> fixed(thread_count * objects_per_thread, 2, 8);
+    run_threaded_test(fixed);
+}
@@ -0,0 +1,122 @@
+#include <boost/lockfree/overwrite_ringbuffer.hpp>
+
+#include <climits>
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <boost/thread.hpp>
+
+using namespace boost;
+using namespace boost::lockfree;
+using namespace std;
+
+BOOST_AUTO_TEST_CASE( overwrite_ringbuffer_simple_test )
+{
+    overwrite_ringbuffer<int> rb(4);
+    BOOST_REQUIRE(rb.empty());
+
+    int out;
+    BOOST_REQUIRE(!rb.dequeue(out));
+
+    for (int i = 0; i != 4; ++i)
+        rb.enqueue(i);
+
+    for (int i = 0; i != 4; ++i) {
+        BOOST_REQUIRE(rb.dequeue(out));
+        BOOST_REQUIRE_EQUAL(out, i);
+    }
+    BOOST_REQUIRE(!rb.dequeue(out));
+    BOOST_REQUIRE(rb.empty());
+    BOOST_REQUIRE_EQUAL(rb.skipped(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE( overwrite_ringbuffer_lapped_test )
+{
+    overwrite_ringbuffer<int> rb(4);
+
+    for (int i = 0; i != 10; ++i)
+        rb.enqueue(i);
+
+    /* the consumer continues with the oldest element, which cannot be overwritten by the next enqueue */
+    int out;
+    for (int i = 7; i != 10; ++i) {
+        BOOST_REQUIRE(rb.dequeue(out));
+        BOOST_REQUIRE_EQUAL(out, i);
+    }
+    BOOST_REQUIRE(!rb.dequeue(out));
+    BOOST_REQUIRE_EQUAL(rb.skipped(), 7u);
+
+    rb.enqueue(10);
+    BOOST_REQUIRE(rb.dequeue(out));
+    BOOST_REQUIRE_EQUAL(out, 10);
+}
+
+namespace {
+
+struct telemetry_sample
+{
+    long values[8];
+};
+
+}
+
+static const long samples = 2000000;
+
+struct overwrite_ringbuffer_tester
+{
+    overwrite_ringbuffer<telemetry_sample> rb;
+    boost::lockfree::detail::atomic<bool> running;
+
+    overwrite_ringbuffer_tester(void):
+        rb(64), running(true)
+    {}
+
+    void produce(void)
+    {
+        for (long i = 0; i != samples; ++i) {
+            telemetry_sample s;
+            for (int j = 0; j != 8; ++j)
+                s.values[j] = i;
+            rb.enqueue(s);
+        }
+        running = false;
+    }
+
+    void run(void)
+    {
+        boost::thread producer(boost::bind(&overwrite_ringbuffer_tester::produce, this));
+
+        long received = 0, last = -1;
+        bool consistent = true;
+        for (;;) {
+            /* sample running before dequeueing, so that no element is missed after the producer has finished */
+            bool producer_running = running;
+
+            telemetry_sample s;
+            if (rb.dequeue(s)) {
+                ++received;
+                for (int j = 0; j != 8; ++j)
+                    if (s.values[j] != s.values[0])
+                        consistent = false;     /* torn read */
+                if (s.values[0] <= last)
+                    consistent = false;
+                last = s.values[0];
+            } else if (producer_running)
+                boost::thread::yield();
+            else
+                break;
+        }
+        producer.join();
+
+        BOOST_REQUIRE(consistent);
+        BOOST_REQUIRE_EQUAL(last, samples - 1);
+        BOOST_REQUIRE_EQUAL(received + long(rb.skipped()), samples);
+    }
+};
+
+BOOST_AUTO_TEST_CASE( overwrite_ringbuffer_test )
+{
+    overwrite_ringbuffer_tester tester;
+    tester.run();
+}
@@ -0,0 +1,173 @@
+#include <boost/lockfree/pipeline.hpp>
+
+#include <climits>
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <boost/thread.hpp>
+
+using namespace boost;
+using namespace boost::lockfree;
+using namespace std;
+
+namespace {
+
+struct entry
+{
+    long raw;
+    long decoded;
+    long enriched;
+};
+
+struct append
+{
+    int stage;
+    vector<int> * log;
+
+    void operator()(int & value) const
+    {
+        value = value * 10 + stage;
+        log->push_back(stage);
+    }
+};
+
+}
+
+BOOST_AUTO_TEST_CASE( pipeline_simple_test )
+{
+    /* diamond: 0 -> {1, 2} -> 3 */
+    pipeline<int> p(4, 4);
+    p.add_dependency(1, 0);
+    p.add_dependency(2, 0);
+    p.add_dependency(3, 1);
+    p.add_dependency(3, 2);
+    BOOST_REQUIRE_EQUAL(p.stages(), 4u);
+
+    vector<int> log;
+    append stages[4];
+    for (int i = 0; i != 4; ++i) {
+        stages[i].stage = i;
+        stages[i].log = &log;
+    }
+
+    for (int i = 1; i != 5; ++i)
+        BOOST_REQUIRE(p.enqueue(i));
+    BOOST_REQUIRE(!p.enqueue(5));
+    BOOST_REQUIRE(!p.empty());
+
+    /* downstream stages wait for their upstream stages */
+    BOOST_REQUIRE_EQUAL(p.consume_all(3, stages[3]), 0u);
+    BOOST_REQUIRE_EQUAL(p.consume_all(1, stages[1]), 0u);
+    BOOST_REQUIRE_EQUAL(p.consume_all(0, stages[0]), 4u);
+    BOOST_REQUIRE_EQUAL(p.consume_all(1, stages[1]), 4u);
+    BOOST_REQUIRE_EQUAL(p.consume_all(3, stages[3]), 0u);
+    BOOST_REQUIRE(!p.enqueue(5));
+    BOOST_REQUIRE_EQUAL(p.consume_all(2, stages[2]), 4u);
+    BOOST_REQUIRE_EQUAL(p.consume_all(3, stages[3]), 4u);
+    BOOST_REQUIRE(p.empty());
+    BOOST_REQUIRE_EQUAL(log.size(), 16u);
+
+    /* the slot has been processed in place by all stages */
+    int * slot = p.claim();
+    BOOST_REQUIRE(slot);
+    BOOST_REQUIRE_EQUAL(*slot, 10123);
+    *slot = 5;
+    p.publish();
+    BOOST_REQUIRE(!p.empty());
+}
+
+static const long entries = 1000000;
+
+struct pipeline_tester
+{
+    pipeline<entry> p;
+    long sum;
+
+    pipeline_tester(void):
+        p(256, 3), sum(0)
+    {
+        p.add_dependency(1, 0);
+        p.add_dependency(2, 1);
+    }
+
+    struct decode
+    {
+        void operator()(entry & e) const
+        {
+            e.decoded = e.raw * 2;
+        }
+    };
+
+    struct enrich
+    {
+        void operator()(entry & e) const
+        {
+            e.enriched = e.decoded + 1;
+        }
+    };
+
+    struct persist
+    {
+        long & sum;
+        long processed;
+
+        persist(long & sum):
+            sum(sum), processed(0)
+        {}
+
+        void operator()(entry const & e)
+        {
+            if (e.enriched == e.raw * 2 + 1)
+                sum += e.raw;
+            ++processed;
+        }
+    };
+
+    template <typename Stage>
+    void run_stage(int stage)
+    {
+        Stage f;
+        long processed = 0;
+        while (processed != entries) {
+            size_t count = p.consume_all(stage, f);
+            processed += count;
+            if (count == 0)
+                boost::thread::yield();
+        }
+    }
+
+    void run_persist(void)
+    {
+        persist f(sum);
+        while (f.processed != entries)
+            if (p.consume_all(2, f) == 0)
+                boost::thread::yield();
+    }
+
+    void run(void)
+    {
+        thread_group stages;
+        stages.create_thread(boost::bind(&pipeline_tester::run_stage<decode>, this, 0));
+        stages.create_thread(boost::bind(&pipeline_tester::run_stage<enrich>, this, 1));
+        stages.create_thread(boost::bind(&pipeline_tester::run_persist, this));
+
+        for (long i = 0; i != entries; ++i) {
+            entry * e;
+            while (!(e = p.claim()))
+                boost::thread::yield();
+            e->raw = i;
+            p.publish();
+        }
+        stages.join_all();
+
+        BOOST_REQUIRE_EQUAL(sum, entries * (entries - 1) / 2);
+        BOOST_REQUIRE(p.empty());
+    }
+};
+
+BOOST_AUTO_TEST_CASE( pipeline_test )
+{
+    pipeline_tester tester;
+    tester.run();
+}
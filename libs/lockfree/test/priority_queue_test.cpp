@@ -0,0 +1,177 @@
+#include <boost/lockfree/priority_queue.hpp>
+
+#include <climits>
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <boost/thread.hpp>
+
+#include <functional>
+#include <vector>
+
+using namespace boost;
+using boost::lockfree::priority_queue;
+
+namespace {
+
+struct deadline
+{
+    long time;
+    long id;
+};
+
+struct earlier
+{
+    bool operator()(deadline const & lhs, deadline const & rhs) const
+    {
+        return lhs.time < rhs.time;
+    }
+};
+
+}
+
+BOOST_AUTO_TEST_CASE( priority_queue_exact_test )
+{
+    priority_queue<long> q;
+    BOOST_REQUIRE(q.empty());
+    BOOST_REQUIRE_EQUAL(q.queues(), 1u);
+
+    /* push in a scrambled order */
+    for (long i = 0; i != 1000; ++i)
+        BOOST_REQUIRE(q.push((i * 7919) % 1000));
+    BOOST_REQUIRE_EQUAL(q.size(), 1000u);
+
+    long out;
+    for (long i = 0; i != 1000; ++i) {
+        BOOST_REQUIRE(q.pop(out));
+        BOOST_REQUIRE_EQUAL(out, i);
+    }
+    BOOST_REQUIRE(!q.pop(out));
+    BOOST_REQUIRE(q.empty());
+}
+
+BOOST_AUTO_TEST_CASE( priority_queue_equal_priorities_test )
+{
+    priority_queue<deadline, earlier> q;
+
+    for (long i = 0; i != 100; ++i) {
+        deadline d = {i % 4, i};
+        BOOST_REQUIRE(q.push(d));
+    }
+
+    /* equal deadlines are popped in the order of their insertion */
+    deadline out;
+    for (long time = 0; time != 4; ++time)
+        for (long id = time; id < 100; id += 4) {
+            BOOST_REQUIRE(q.pop(out));
+            BOOST_REQUIRE_EQUAL(out.time, time);
+            BOOST_REQUIRE_EQUAL(out.id, id);
+        }
+    BOOST_REQUIRE(!q.pop(out));
+}
+
+BOOST_AUTO_TEST_CASE( priority_queue_greater_test )
+{
+    priority_queue<long, std::greater<long> > q(4);
+
+    for (long i = 0; i != 100; ++i)
+        BOOST_REQUIRE(q.push(i));
+
+    /* the relaxed order returns every element exactly once */
+    std::vector<bool> popped(100, false);
+    long out;
+    while (q.pop(out)) {
+        BOOST_REQUIRE(!popped[out]);
+        popped[out] = true;
+    }
+
+    for (long i = 0; i != 100; ++i)
+        BOOST_REQUIRE(popped[i]);
+}
+
+BOOST_AUTO_TEST_CASE( priority_queue_static_freelist_test )
+{
+    priority_queue<long, std::less<long>, boost::lockfree::static_freelist_t> q(2, 64);
+
+    long pushed = 0;
+    while (q.push(pushed))
+        ++pushed;
+
+    BOOST_REQUIRE_GT(pushed, 0);
+    BOOST_REQUIRE_LE(pushed, 128);
+    BOOST_REQUIRE_EQUAL(q.size(), size_t(pushed));
+
+    /* popped nodes are returned to the freelists */
+    long out;
+    for (long i = 0; i != pushed; ++i)
+        BOOST_REQUIRE(q.pop(out));
+    BOOST_REQUIRE(q.empty());
+    BOOST_REQUIRE(q.push(1000));
+}
+
+namespace {
+
+const long elements_per_thread = 20000;
+const int producer_threads = 2;
+const int consumer_threads = 2;
+
+struct priority_queue_tester
+{
+    priority_queue<long> q;
+    boost::lockfree::detail::atomic<long> consumed;
+    std::vector<boost::lockfree::detail::atomic<int> *> counts;
+
+    priority_queue_tester(void):
+        q(2 * (producer_threads + consumer_threads)), consumed(0)
+    {
+        for (long i = 0; i != producer_threads * elements_per_thread; ++i)
+            counts.push_back(new boost::lockfree::detail::atomic<int>(0));
+    }
+
+    ~priority_queue_tester(void)
+    {
+        for (size_t i = 0; i != counts.size(); ++i)
+            delete counts[i];
+    }
+
+    void produce(long first)
+    {
+        for (long i = first; i < producer_threads * elements_per_thread; i += producer_threads) {
+            bool pushed = q.push(i);
+            assert(pushed);
+            (void)pushed;
+        }
+    }
+
+    void consume(void)
+    {
+        while (consumed.load() != producer_threads * elements_per_thread) {
+            long out;
+            if (q.pop(out)) {
+                counts[out]->fetch_add(1);
+                consumed.fetch_add(1);
+            } else
+                boost::thread::yield();
+        }
+    }
+};
+
+}
+
+BOOST_AUTO_TEST_CASE( priority_queue_threaded_test )
+{
+    priority_queue_tester tester;
+    BOOST_WARN(tester.q.is_lock_free());
+
+    thread_group threads;
+    for (int i = 0; i != producer_threads; ++i)
+        threads.create_thread(boost::bind(&priority_queue_tester::produce, &tester, i));
+    for (int i = 0; i != consumer_threads; ++i)
+        threads.create_thread(boost::bind(&priority_queue_tester::consume, &tester));
+    threads.join_all();
+
+    BOOST_REQUIRE(tester.q.empty());
+    for (long i = 0; i != producer_threads * elements_per_thread; ++i)
+        BOOST_REQUIRE_EQUAL(tester.counts[i]->load(), 1);
+}
@@ -0,0 +1,156 @@
+#include <boost/lockfree/record_ringbuffer.hpp>
+
+#include <climits>
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <boost/thread.hpp>
+#include <cstring>
+#include <string>
+
+using namespace boost;
+using namespace boost::lockfree;
+using namespace std;
+
+static string to_string(record_view const & view)
+{
+    return string(view.data, view.size);
+}
+
+BOOST_AUTO_TEST_CASE( record_ringbuffer_simple_test )
+{
+    record_ringbuffer<> rb(256);
+    BOOST_REQUIRE(rb.empty());
+
+    BOOST_REQUIRE(rb.enqueue("hello", 5));
+    BOOST_REQUIRE(rb.enqueue("", 0));
+    BOOST_REQUIRE(rb.enqueue("lock-free world", 15));
+
+    record_ringbuffer<>::read_cursor cursor = rb.read();
+    record_view view = record_view();
+    BOOST_REQUIRE(cursor.next(view));
+    BOOST_REQUIRE_EQUAL(to_string(view), "hello");
+    BOOST_REQUIRE(cursor.next(view));
+    BOOST_REQUIRE_EQUAL(view.size, 0u);
+    BOOST_REQUIRE(cursor.next(view));
+    BOOST_REQUIRE_EQUAL(to_string(view), "lock-free world");
+    BOOST_REQUIRE(!cursor.next(view));
+
+    BOOST_REQUIRE(!rb.empty());
+    rb.commit_read(cursor);
+    BOOST_REQUIRE(rb.empty());
+}
+
+BOOST_AUTO_TEST_CASE( record_ringbuffer_reserve_test )
+{
+    record_ringbuffer<> rb(256);
+
+    /* reserve the worst case, commit the actual size */
+    char * payload = rb.reserve(100);
+    BOOST_REQUIRE(payload);
+    std::memcpy(payload, "abc", 3);
+    BOOST_REQUIRE(rb.empty());
+    rb.commit(3);
+
+    record_ringbuffer<>::read_cursor cursor = rb.read();
+    record_view view = record_view();
+    BOOST_REQUIRE(cursor.next(view));
+    BOOST_REQUIRE_EQUAL(to_string(view), "abc");
+    BOOST_REQUIRE(!cursor.next(view));
+    rb.commit_read(cursor);
+}
+
+BOOST_AUTO_TEST_CASE( record_ringbuffer_wraparound_test )
+{
+    record_ringbuffer<> rb(256);
+    const size_t max_record = rb.max_record_size();
+    BOOST_REQUIRE(max_record >= 100);
+
+    const string big(max_record, 'x');
+
+    /* records of the maximum size fit after the consumer caught up, no matter where the indices are */
+    for (int i = 0; i != 100; ++i) {
+        BOOST_REQUIRE(rb.enqueue(big.data(), big.size()));
+
+        record_ringbuffer<>::read_cursor cursor = rb.read();
+        record_view view = record_view();
+        BOOST_REQUIRE(cursor.next(view));
+        BOOST_REQUIRE(to_string(view) == big);
+        BOOST_REQUIRE(!cursor.next(view));
+        rb.commit_read(cursor);
+        BOOST_REQUIRE(rb.empty());
+
+        /* move the indices */
+        string small(i % 13, 'a' + i % 26);
+        BOOST_REQUIRE(rb.enqueue(small.data(), small.size()));
+
+        cursor = rb.read();
+        BOOST_REQUIRE(cursor.next(view));
+        BOOST_REQUIRE_EQUAL(to_string(view), small);
+        rb.commit_read(cursor);
+    }
+}
+
+static const int records = 1000000;
+
+struct record_ringbuffer_tester
+{
+    record_ringbuffer<> rb;
+    volatile bool sequence_ok;
+
+    record_ringbuffer_tester(void):
+        rb(4096), sequence_ok(true)
+    {}
+
+    /* record i holds i % 200 bytes with the value i */
+    void produce(void)
+    {
+        for (int i = 0; i != records; ++i) {
+            const size_t size = i % 200;
+            char * payload;
+            while (!(payload = rb.reserve(size)))
+                boost::thread::yield();
+            std::memset(payload, char(i), size);
+            rb.commit();
+        }
+    }
+
+    void consume(void)
+    {
+        int expected = 0;
+        while (expected != records) {
+            record_ringbuffer<>::read_cursor cursor = rb.read();
+            record_view view = record_view();
+            bool progress = false;
+            while (cursor.next(view)) {
+                progress = true;
+                if (view.size != size_t(expected % 200))
+                    sequence_ok = false;
+                for (size_t i = 0; i != view.size; ++i)
+                    if (view.data[i] != char(expected))
+                        sequence_ok = false;
+                ++expected;
+            }
+            rb.commit_read(cursor);
+            if (!progress)
+                boost::thread::yield();
+        }
+    }
+
+    void run(void)
+    {
+        boost::thread producer(boost::bind(&record_ringbuffer_tester::produce, this));
+        consume();
+        producer.join();
+
+        BOOST_REQUIRE(sequence_ok);
+        BOOST_REQUIRE(rb.empty());
+    }
+};
+
+BOOST_AUTO_TEST_CASE( record_ringbuffer_test )
+{
+    record_ringbuffer_tester tester;
+    tester.run();
+}
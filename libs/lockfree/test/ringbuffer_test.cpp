@@ -9,6 +9,7 @@
 #include <boost/thread.hpp>
 #include <iostream>
 #include <memory>
+#include <string>
 
 
 #include "test_helpers.hpp"
@@ -206,13 +207,174 @@ BOOST_AUTO_TEST_CASE( ringbuffer_buffer_dequeue_test )
 }
 
 
+/* counts live objects */
+struct counted
+{
+    counted(int i = 0):
+        value(i)
+    {
+        ++live;
+    }
+
+    counted(counted const & rhs):
+        value(rhs.value)
+    {
+        ++live;
+    }
+
+    counted & operator=(counted const & rhs)
+    {
+        value = rhs.value;
+        return *this;
+    }
+
+    ~counted(void)
+    {
+        --live;
+    }
+
+    int value;
+    static int live;
+};
+
+int counted::live = 0;
+
+template <typename Ringbuffer>
+void ringbuffer_lifetime(Ringbuffer & rb)
+{
+    /* storage is not initialized */
+    BOOST_REQUIRE_EQUAL(counted::live, 0);
+
+    for (int i = 0; i != 20; ++i)
+        BOOST_REQUIRE(rb.enqueue(counted(i)));
+    BOOST_REQUIRE_EQUAL(counted::live, 20);
+
+    {
+        counted out;
+        for (int i = 0; i != 5; ++i) {
+            BOOST_REQUIRE(rb.dequeue(out));
+            BOOST_REQUIRE_EQUAL(out.value, i);
+        }
+
+        counted buffer[10];
+        BOOST_REQUIRE_EQUAL(rb.dequeue(buffer), 10u);
+        BOOST_REQUIRE_EQUAL(buffer[9].value, 14);
+
+        /* wrap around */
+        BOOST_REQUIRE_EQUAL(rb.enqueue(buffer), 10u);
+        BOOST_REQUIRE_EQUAL(counted::live, 5 + 10 + 1 + 10);
+    }
+
+    rb.reset();
+    BOOST_REQUIRE(rb.empty());
+    BOOST_REQUIRE_EQUAL(counted::live, 0);
+
+    BOOST_REQUIRE(rb.enqueue(counted(1)));
+}
+
+BOOST_AUTO_TEST_CASE( ringbuffer_lifetime_test )
+{
+    {
+        ringbuffer<counted, 24> rb;
+        ringbuffer_lifetime(rb);
+    }
+    BOOST_REQUIRE_EQUAL(counted::live, 0);
+
+    {
+        ringbuffer<counted, 0> rb(24);
+        ringbuffer_lifetime(rb);
+    }
+    BOOST_REQUIRE_EQUAL(counted::live, 0);
+}
+
+int value_of(int i)
+{
+    return i;
+}
+
+int value_of(counted const & c)
+{
+    return c.value;
+}
+
+/* the elements before the end of the buffer are written before the elements at its beginning */
+template <typename T>
+void ringbuffer_dequeue_wraparound(void)
+{
+    for (int offset = 0; offset != 8; ++offset) {
+        ringbuffer<T, 0> rb(8);
+
+        /* move the indices */
+        T out;
+        for (int i = 0; i != offset; ++i) {
+            BOOST_REQUIRE(rb.enqueue(T(i)));
+            BOOST_REQUIRE(rb.dequeue(out));
+        }
+
+        int count = 0;
+        while (rb.enqueue(T(count)))
+            ++count;
+
+        std::vector<T> appended;
+        BOOST_REQUIRE_EQUAL(rb.dequeue(std::back_inserter(appended)), size_t(count));
+        BOOST_REQUIRE_EQUAL(appended.size(), size_t(count));
+        for (int i = 0; i != count; ++i)
+            BOOST_REQUIRE_EQUAL(value_of(appended[i]), i);
+
+        for (int i = 0; i != count; ++i)
+            BOOST_REQUIRE(rb.enqueue(T(i)));
+
+        std::vector<T> assigned(count);
+        BOOST_REQUIRE_EQUAL(rb.dequeue(assigned.begin()), size_t(count));
+        for (int i = 0; i != count; ++i)
+            BOOST_REQUIRE_EQUAL(value_of(assigned[i]), i);
+    }
+}
+
+BOOST_AUTO_TEST_CASE( ringbuffer_dequeue_wraparound_test )
+{
+    ringbuffer_dequeue_wraparound<int>();
+    ringbuffer_dequeue_wraparound<counted>();
+    BOOST_REQUIRE_EQUAL(counted::live, 0);
+}
+
+#if !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES) && !defined(BOOST_NO_CXX11_SMART_PTR)
+BOOST_AUTO_TEST_CASE( ringbuffer_move_only_test )
+{
+    ringbuffer<std::unique_ptr<int>, 0> rb(4);
+
+    BOOST_REQUIRE(rb.enqueue(std::unique_ptr<int>(new int(1))));
+    BOOST_REQUIRE(rb.emplace(new int(2)));
+    BOOST_REQUIRE(rb.emplace(new int(3)));
+
+    /* ringbuffer is full, the argument is not moved from */
+    std::unique_ptr<int> four(new int(4));
+    BOOST_REQUIRE(!rb.enqueue(std::move(four)));
+    BOOST_REQUIRE(four);
+
+    std::unique_ptr<int> out;
+    for (int i = 1; i != 4; ++i) {
+        BOOST_REQUIRE(rb.dequeue(out));
+        BOOST_REQUIRE_EQUAL(*out, i);
+    }
+    BOOST_REQUIRE(rb.empty());
+
+    ringbuffer<std::pair<int, std::string>, 4> rb2;
+    BOOST_REQUIRE(rb2.emplace(1, "one"));
+    std::pair<int, std::string> p;
+    BOOST_REQUIRE(rb2.dequeue(p));
+    BOOST_REQUIRE_EQUAL(p.second, "one");
+}
+#endif
+
+
 static const uint nodes_per_thread = 500000;
 
 struct ringbuffer_tester
 {
     ringbuffer<int, 128> sf;
 
-    atomic<long> ringbuffer_cnt, received_nodes;
+    boost::lockfree::detail::atomic<long> ringbuffer_cnt, received_nodes;
 
     static_hashed_set<int, 1<<16 > working_set;
 
@@ -259,8 +421,11 @@ struct ringbuffer_tester
     {
         for(;;)
         {
+            /* sample running before dequeueing, so that elements, which are enqueued before the writer finishes,
+             * are not missed */
+            bool writer_running = running;
             bool success = get_element();
-            if (not running and not success)
+            if (not writer_running and not success)
                 return;
         }
     }
@@ -298,10 +463,10 @@ struct ringbuffer_tester_buffering
 {
     ringbuffer<int, 128> sf;
 
-    atomic<long> ringbuffer_cnt;
+    boost::lockfree::detail::atomic<long> ringbuffer_cnt;
 
     static_hashed_set<int, 1<<16 > working_set;
-    atomic<long> received_nodes;
+    boost::lockfree::detail::atomic<long> received_nodes;
 
     ringbuffer_tester_buffering(void):
         ringbuffer_cnt(0), received_nodes(0)
@@ -363,8 +528,11 @@ struct ringbuffer_tester_buffering
     {
         for(;;)
         {
+            /* sample running before dequeueing, so that elements, which are enqueued before the writer finishes,
+             * are not missed */
+            bool writer_running = running;
             bool success = get_elements();
-            if (not running and not success)
+            if (not writer_running and not success)
                 return;
         }
     }
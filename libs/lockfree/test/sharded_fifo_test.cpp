@@ -0,0 +1,111 @@
+#include <boost/lockfree/sharded_fifo.hpp>
+
+#include <climits>
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <boost/thread.hpp>
+
+#include "test_helpers.hpp"
+
+using namespace boost;
+using namespace boost::lockfree;
+using namespace std;
+
+BOOST_AUTO_TEST_CASE( sharded_fifo_simple_test )
+{
+    sharded_fifo<int> f(4, 16);
+    BOOST_REQUIRE_EQUAL(f.shards(), 4u);
+    BOOST_REQUIRE(f.empty());
+
+    /* fifo order within a shard */
+    for (int i = 0; i != 10; ++i)
+        BOOST_REQUIRE(f.enqueue(i));
+    BOOST_REQUIRE(!f.empty());
+
+    int out;
+    for (int i = 0; i != 10; ++i) {
+        BOOST_REQUIRE(f.dequeue(out));
+        BOOST_REQUIRE_EQUAL(out, i);
+    }
+    BOOST_REQUIRE(!f.dequeue(out));
+    BOOST_REQUIRE(f.empty());
+}
+
+BOOST_AUTO_TEST_CASE( sharded_fifo_steal_test )
+{
+    sharded_fifo<int> f(4);
+
+    BOOST_REQUIRE(f.enqueue(1, 2));
+    BOOST_REQUIRE(f.enqueue(2, 3));
+
+    /* the local shard is preferred, afterwards shards are visited in round-robin order */
+    int out;
+    BOOST_REQUIRE(f.enqueue(3, 0));
+    BOOST_REQUIRE(f.dequeue(out, 0));
+    BOOST_REQUIRE_EQUAL(out, 3);
+    BOOST_REQUIRE(f.dequeue(out, 3));
+    BOOST_REQUIRE_EQUAL(out, 2);
+    BOOST_REQUIRE(f.dequeue(out, 3));
+    BOOST_REQUIRE_EQUAL(out, 1);
+    BOOST_REQUIRE(!f.dequeue(out, 1));
+}
+
+static const int nodes_per_thread = 100000;
+static const int thread_count = 4;
+
+struct sharded_fifo_tester
+{
+    sharded_fifo<int> f;
+    static_hashed_set<int, 1<<16 > working_set;
+    boost::lockfree::detail::atomic<int> dequeued;
+
+    sharded_fifo_tester(void):
+        f(thread_count, 128), dequeued(0)
+    {}
+
+    /* the producers only use their local shard, the consumers steal from all shards */
+    void produce(void)
+    {
+        for (int i = 0; i != nodes_per_thread; ++i) {
+            int id = generate_id<int>();
+            bool inserted = working_set.insert(id);
+            assert(inserted);
+            while (!f.enqueue(id))
+                ;
+        }
+    }
+
+    void consume(void)
+    {
+        while (dequeued != thread_count * nodes_per_thread) {
+            int id;
+            if (f.dequeue(id)) {
+                bool erased = working_set.erase(id);
+                assert(erased);
+                ++dequeued;
+            } else
+                boost::thread::yield();
+        }
+    }
+
+    void run(void)
+    {
+        thread_group threads;
+        for (int i = 0; i != thread_count; ++i) {
+            threads.create_thread(boost::bind(&sharded_fifo_tester::produce, this));
+            threads.create_thread(boost::bind(&sharded_fifo_tester::consume, this));
+        }
+        threads.join_all();
+
+        BOOST_REQUIRE_EQUAL(working_set.count_nodes(), 0);
+        BOOST_REQUIRE(f.empty());
+    }
+};
+
+BOOST_AUTO_TEST_CASE( sharded_fifo_test )
+{
+    sharded_fifo_tester tester;
+    tester.run();
+}
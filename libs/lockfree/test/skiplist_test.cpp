@@ -0,0 +1,389 @@
+#include <boost/lockfree/skiplist.hpp>
+
+#include <climits>
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <boost/thread.hpp>
+
+#include <functional>
+#include <vector>
+
+using namespace boost;
+using namespace boost::lockfree;
+using namespace std;
+
+namespace {
+
+struct collect
+{
+    vector<long> keys;
+    vector<long> values;
+
+    void operator()(long key, long value)
+    {
+        keys.push_back(key);
+        values.push_back(value);
+    }
+
+    void operator()(long key)
+    {
+        keys.push_back(key);
+    }
+};
+
+}
+
+BOOST_AUTO_TEST_CASE( skiplist_map_simple_test )
+{
+    skiplist_map<long, long> m;
+    BOOST_REQUIRE(m.empty());
+
+    BOOST_REQUIRE(m.insert(2, 20));
+    BOOST_REQUIRE(m.insert(1, 10));
+    BOOST_REQUIRE(m.insert(3, 30));
+    BOOST_REQUIRE(!m.insert(1, 11));
+    BOOST_REQUIRE_EQUAL(m.size(), 3u);
+
+    long out;
+    BOOST_REQUIRE(m.find(1, out)); BOOST_REQUIRE_EQUAL(out, 10);
+    BOOST_REQUIRE(m.find(3, out)); BOOST_REQUIRE_EQUAL(out, 30);
+    BOOST_REQUIRE(!m.contains(4));
+
+    BOOST_REQUIRE(m.erase(2));
+    BOOST_REQUIRE(!m.erase(2));
+    BOOST_REQUIRE(!m.contains(2));
+
+    BOOST_REQUIRE(m.insert(2, 22));
+    BOOST_REQUIRE(m.find(2, out)); BOOST_REQUIRE_EQUAL(out, 22);
+    BOOST_REQUIRE_EQUAL(m.size(), 3u);
+}
+
+BOOST_AUTO_TEST_CASE( skiplist_map_scan_test )
+{
+    skiplist_map<long, long> m;
+
+    /* insert in a scrambled order */
+    for (long i = 0; i != 1000; ++i) {
+        long key = (i * 7919) % 1000;
+        BOOST_REQUIRE(m.insert(key, -key));
+    }
+
+    collect c;
+    BOOST_REQUIRE_EQUAL(m.scan(100, 200, c), 100u);
+    BOOST_REQUIRE_EQUAL(c.keys.size(), 100u);
+    for (long i = 0; i != 100; ++i) {
+        BOOST_REQUIRE_EQUAL(c.keys[i], 100 + i);
+        BOOST_REQUIRE_EQUAL(c.values[i], -(100 + i));
+    }
+
+    for (long i = 0; i < 1000; i += 2)
+        BOOST_REQUIRE(m.erase(i));
+
+    collect odd;
+    BOOST_REQUIRE_EQUAL(m.scan(0, 1000, odd), 500u);
+    for (long i = 0; i != 500; ++i)
+        BOOST_REQUIRE_EQUAL(odd.keys[i], 2 * i + 1);
+
+    collect none;
+    BOOST_REQUIRE_EQUAL(m.scan(2000, 3000, none), 0u);
+}
+
+BOOST_AUTO_TEST_CASE( skiplist_set_test )
+{
+    skiplist_set<long, std::greater<long> > s;
+
+    for (long i = 0; i != 100; ++i)
+        BOOST_REQUIRE(s.insert(i));
+    BOOST_REQUIRE(!s.insert(42));
+    BOOST_REQUIRE(s.erase(42));
+    BOOST_REQUIRE(!s.contains(42));
+    BOOST_REQUIRE_EQUAL(s.size(), 99u);
+
+    /* descending order */
+    collect c;
+    BOOST_REQUIRE_EQUAL(s.scan(50, 40, c), 9u);
+    BOOST_REQUIRE_EQUAL(c.keys.front(), 50);
+    BOOST_REQUIRE_EQUAL(c.keys.back(), 41);
+}
+
+BOOST_AUTO_TEST_CASE( skiplist_pop_front_test )
+{
+    skiplist_map<long, long> m;
+
+    long key, value;
+    BOOST_REQUIRE(!m.front(key, value));
+    BOOST_REQUIRE(!m.pop_front(key, value));
+
+    for (long i = 0; i != 100; ++i)
+        BOOST_REQUIRE(m.insert((i * 37) % 100, i));
+
+    BOOST_REQUIRE(m.erase(0));
+    BOOST_REQUIRE(m.front(key, value));
+    BOOST_REQUIRE_EQUAL(key, 1);
+    BOOST_REQUIRE_EQUAL(m.size(), 99u);
+
+    for (long i = 1; i != 100; ++i) {
+        BOOST_REQUIRE(m.pop_front(key, value));
+        BOOST_REQUIRE_EQUAL(key, i);
+        BOOST_REQUIRE_EQUAL((value * 37) % 100, i);
+    }
+    BOOST_REQUIRE(m.empty());
+
+    skiplist_set<long, std::greater<long> > s;
+    for (long i = 0; i != 10; ++i)
+        BOOST_REQUIRE(s.insert(i));
+    BOOST_REQUIRE(s.front(key));
+    BOOST_REQUIRE_EQUAL(key, 9);
+    BOOST_REQUIRE(s.pop_front(key));
+    BOOST_REQUIRE_EQUAL(key, 9);
+    BOOST_REQUIRE(!s.contains(9));
+}
+
+BOOST_AUTO_TEST_CASE( skiplist_static_freelist_test )
+{
+    skiplist_map<long, long, std::less<long>, static_freelist_t> m(64);
+
+    long inserted = 0;
+    while (m.insert(inserted, inserted))
+        ++inserted;
+
+    BOOST_REQUIRE_GT(inserted, 0);
+    BOOST_REQUIRE_LE(inserted, 64);
+
+    /* erased nodes are returned to the freelists */
+    for (long i = 0; i != inserted; ++i)
+        BOOST_REQUIRE(m.erase(i));
+    BOOST_REQUIRE(m.empty());
+    BOOST_REQUIRE(m.insert(1000, 1000));
+}
+
+namespace boost {
+namespace lockfree {
+namespace detail {
+
+template <>
+struct skiplist_access<skiplist_map<long, long> >
+{
+    typedef skiplist_map<long, long> map;
+    typedef map::node node;
+
+    /* erases the first node of level 1 like erase(), but stops after marking its lowest level, as if the erasing
+     * thread was preempted */
+    static node * begin_erase(map & m)
+    {
+        node * n = m.head_->tower()[1].load().get_ptr();
+        bool marked = m.mark(n, n->tower()[0].load());
+        BOOST_REQUIRE(marked);
+        return n;
+    }
+
+    static void finish_erase(map & m, node * n)
+    {
+        m.finish_erase(n, n->key);
+    }
+};
+
+} /* namespace detail */
+} /* namespace lockfree */
+} /* namespace boost */
+
+namespace {
+
+struct find_functor
+{
+    skiplist_map<long, long> & m;
+    long key;
+    bool & found;
+
+    find_functor(skiplist_map<long, long> & m, long key, bool & found):
+        m(m), key(key), found(found)
+    {}
+
+    void operator()(void)
+    {
+        long out;
+        found = m.find(key, out) && out == key;
+    }
+};
+
+}
+
+BOOST_AUTO_TEST_CASE( skiplist_unfinished_erase_test )
+{
+    typedef boost::lockfree::detail::skiplist_access<skiplist_map<long, long> > access;
+
+    skiplist_map<long, long> m;
+    for (long i = 0; i != 1000; ++i)
+        BOOST_REQUIRE(m.insert(i, i));
+
+    /* the node is marked on level 0, but still linked on level 1, so the search for the next key drops from the node
+     * to its marked lowest level */
+    access::node * n = access::begin_erase(m);
+    const long key = n->key;
+    BOOST_REQUIRE_LT(key, 999);
+
+    bool found = false;
+    boost::thread finder(find_functor(m, key + 1, found));
+    BOOST_REQUIRE(finder.timed_join(boost::posix_time::seconds(10)));
+    BOOST_REQUIRE(found);
+    BOOST_REQUIRE(!m.contains(key));
+
+    access::finish_erase(m, n);
+    BOOST_REQUIRE_EQUAL(m.size(), 999u);
+    BOOST_REQUIRE(m.insert(key, key));
+}
+
+namespace {
+
+const long keys_per_thread = 10000;
+const int writer_threads = 2;
+const int reader_threads = 2;
+
+struct skiplist_tester
+{
+    skiplist_map<long, long> m;
+    boost::lockfree::detail::atomic<bool> running;
+
+    skiplist_tester(void):
+        running(true)
+    {}
+
+    /* every writer owns the keys first, first + writer_threads, ... and inserts and erases them repeatedly */
+    void write(long first)
+    {
+        const long end = writer_threads * keys_per_thread;
+        for (int round = 0; round != 4; ++round) {
+            for (long i = first; i < end; i += writer_threads) {
+                bool inserted = m.insert(i, i * 2);
+                assert(inserted);
+            }
+            if (round != 3)
+                for (long i = first; i < end; i += writer_threads) {
+                    bool erased = m.erase(i);
+                    assert(erased);
+                }
+        }
+    }
+
+    /* the keys [-keys_per_thread, 0[ are never modified, so they must always be found and scanned in order */
+    void read(void)
+    {
+        long rounds = 0;
+        while (running.load() || rounds == 0) {
+            for (long i = -keys_per_thread; i != 0; ++i) {
+                long out;
+                bool found = m.find(i, out);
+                assert(found);
+                assert(out == i * 2);
+                (void)found;
+            }
+
+            collect c;
+            m.scan(-keys_per_thread, writer_threads * keys_per_thread, c);
+            assert(c.keys.size() >= size_t(keys_per_thread));
+            for (size_t i = 1; i != c.keys.size(); ++i)
+                assert(c.keys[i - 1] < c.keys[i]);
+            for (size_t i = 0; i != c.keys.size(); ++i)
+                assert(c.values[i] == c.keys[i] * 2);
+
+            ++rounds;
+            boost::thread::yield();
+        }
+    }
+};
+
+}
+
+BOOST_AUTO_TEST_CASE( skiplist_threaded_test )
+{
+    skiplist_tester tester;
+    BOOST_WARN(tester.m.is_lock_free());
+
+    for (long i = -keys_per_thread; i != 0; ++i)
+        BOOST_REQUIRE(tester.m.insert(i, i * 2));
+
+    thread_group readers, writers;
+    for (int i = 0; i != reader_threads; ++i)
+        readers.create_thread(boost::bind(&skiplist_tester::read, &tester));
+    for (int i = 0; i != writer_threads; ++i)
+        writers.create_thread(boost::bind(&skiplist_tester::write, &tester, i));
+
+    writers.join_all();
+    tester.running.store(false);
+    readers.join_all();
+
+    BOOST_REQUIRE_EQUAL(tester.m.size(), size_t((writer_threads + 1) * keys_per_thread));
+
+    collect c;
+    BOOST_REQUIRE_EQUAL(tester.m.scan(-keys_per_thread, writer_threads * keys_per_thread, c),
+                        size_t((writer_threads + 1) * keys_per_thread));
+}
+
+namespace {
+
+const long contended_keys = 16;
+const int contended_rounds = 200000;
+
+/* all threads insert and erase the same few keys, so that nodes are freed and reused, while other threads still
+ * traverse, mark or help to erase them */
+struct skiplist_contention_tester
+{
+    skiplist_map<long, long> m;
+    boost::lockfree::detail::atomic<long> inserted, erased;
+
+    skiplist_contention_tester(void):
+        inserted(0), erased(0)
+    {}
+
+    void insert_erase(int id)
+    {
+        long local_inserted = 0, local_erased = 0;
+        for (int i = 0; i != contended_rounds; ++i) {
+            const long key = (i * 7 + id) % contended_keys;
+            if (m.insert(key, key * 2))
+                ++local_inserted;
+
+            long out;
+            if (i % 3 == 0) {
+                long front;
+                if (m.pop_front(front, out)) {
+                    assert(out == front * 2);
+                    ++local_erased;
+                }
+            } else if (m.erase((key + id) % contended_keys))
+                ++local_erased;
+        }
+        inserted += local_inserted;
+        erased += local_erased;
+    }
+};
+
+}
+
+BOOST_AUTO_TEST_CASE( skiplist_contended_reuse_test )
+{
+    skiplist_contention_tester tester;
+
+    thread_group threads;
+    for (int i = 0; i != 4; ++i)
+        threads.create_thread(boost::bind(&skiplist_contention_tester::insert_erase, &tester, i));
+    threads.join_all();
+
+    const size_t remaining = size_t(tester.inserted.load() - tester.erased.load());
+    BOOST_REQUIRE_EQUAL(tester.m.size(), remaining);
+
+    collect c;
+    BOOST_REQUIRE_EQUAL(tester.m.scan(0, contended_keys, c), remaining);
+    for (size_t i = 1; i < c.keys.size(); ++i)
+        BOOST_REQUIRE_LT(c.keys[i - 1], c.keys[i]);
+
+    /* every node has been returned to the freelist exactly once, so all keys can be inserted again */
+    long key, value;
+    while (tester.m.pop_front(key, value))
+        BOOST_REQUIRE_EQUAL(value, key * 2);
+    for (long i = 0; i != contended_keys; ++i)
+        BOOST_REQUIRE(tester.m.insert(i, i));
+    BOOST_REQUIRE_EQUAL(tester.m.size(), size_t(contended_keys));
+}
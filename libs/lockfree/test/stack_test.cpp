@@ -9,6 +9,8 @@
 
 #include <boost/thread.hpp>
 #include <iostream>
+#include <memory>
+#include <string>
 
 
 BOOST_AUTO_TEST_CASE( simple_stack_test )
@@ -29,6 +31,39 @@ BOOST_AUTO_TEST_CASE( simple_stack_test )
     BOOST_REQUIRE(!stk.pop_unsafe(out));
 }
 
+BOOST_AUTO_TEST_CASE( stack_nontrivial_test )
+{
+    boost::lockfree::stack<std::string> stk(16);
+
+    stk.push("foo");
+    stk.push_unsafe(std::string(100, 'x'));
+
+    std::string out;
+    BOOST_REQUIRE(stk.pop(out)); BOOST_REQUIRE_EQUAL(out, std::string(100, 'x'));
+    BOOST_REQUIRE(stk.pop_unsafe(out)); BOOST_REQUIRE_EQUAL(out, "foo");
+    BOOST_REQUIRE(!stk.pop(out));
+
+    /* remaining objects are destroyed by the stack */
+    stk.push("bar");
+}
+
+#if !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES) && !defined(BOOST_NO_CXX11_SMART_PTR)
+BOOST_AUTO_TEST_CASE( stack_move_only_test )
+{
+    boost::lockfree::stack<std::unique_ptr<int> > stk;
+
+    BOOST_REQUIRE(stk.push(std::unique_ptr<int>(new int(1))));
+    BOOST_REQUIRE(stk.emplace(new int(2)));
+    BOOST_REQUIRE(stk.emplace_unsafe(new int(3)));
+
+    std::unique_ptr<int> out;
+    for (int i = 3; i != 0; --i) {
+        BOOST_REQUIRE(stk.pop(out));
+        BOOST_REQUIRE_EQUAL(*out, i);
+    }
+    BOOST_REQUIRE(stk.empty());
+}
+#endif
 
 using namespace boost;
 using namespace std;
@@ -75,6 +110,9 @@ struct stack_tester
     {
         for (;;)
         {
+            /* read the flag before popping, a failed pop after the writers have finished means that the stack is
+             * drained */
+            bool writers_done = not running.load();
             long id;
 
             bool got = stk.pop(id);
@@ -85,7 +123,7 @@ struct stack_tester
                 ++pop_count;
             }
             else
-                if (not running.load())
+                if (writers_done)
                     return;
         }
     }
@@ -1,4 +1,5 @@
 #include <boost/lockfree/detail/tagged_ptr.hpp>
+#include <boost/lockfree/detail/atomic.hpp>
 
 #include <climits>
 #define BOOST_TEST_DYN_LINK
@@ -29,3 +30,23 @@ BOOST_AUTO_TEST_CASE( tagged_ptr_test )
     }
 
 }
+
+BOOST_AUTO_TEST_CASE( atomic_tagged_ptr_test )
+{
+    using namespace boost::lockfree::detail;
+    int a(1), b(2);
+
+    atomic<tagged_ptr<int> > p(tagged_ptr<int>(&a, 0));
+    BOOST_WARN(p.is_lock_free());
+
+    /* a compare-and-swap fails, if only the tag differs */
+    tagged_ptr<int> expected(&a, 1);
+    BOOST_REQUIRE(!p.compare_exchange_strong(expected, tagged_ptr<int>(&b, 2)));
+    BOOST_REQUIRE_EQUAL(expected.get_ptr(), &a);
+    BOOST_REQUIRE_EQUAL(expected.get_tag(), 0);
+
+    BOOST_REQUIRE(p.compare_exchange_strong(expected, tagged_ptr<int>(&b, 2)));
+    tagged_ptr<int> current = p.load();
+    BOOST_REQUIRE_EQUAL(current.get_ptr(), &b);
+    BOOST_REQUIRE_EQUAL(current.get_tag(), 2);
+}
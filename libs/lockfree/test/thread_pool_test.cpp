@@ -0,0 +1,99 @@
+#include <boost/lockfree/thread_pool.hpp>
+
+#include <climits>
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <boost/thread.hpp>
+#include <vector>
+
+using namespace boost;
+using namespace boost::lockfree;
+using namespace std;
+
+namespace {
+
+struct increment
+{
+    boost::lockfree::detail::atomic<long> * counter;
+
+    void operator()(void) const
+    {
+        ++*counter;
+    }
+};
+
+/* spawns the subtasks from the worker thread */
+struct spawn
+{
+    thread_pool * pool;
+    boost::lockfree::detail::atomic<long> * leaves;
+    int depth;
+
+    void operator()(void) const
+    {
+        if (depth == 0) {
+            ++*leaves;
+            return;
+        }
+
+        spawn child = {pool, leaves, depth - 1};
+        pool->submit(child);
+        pool->submit(child);
+    }
+};
+
+void wait_for(boost::lockfree::detail::atomic<long> & counter, long value)
+{
+    while (counter != value)
+        boost::thread::yield();
+}
+
+}
+
+BOOST_AUTO_TEST_CASE( thread_pool_simple_test )
+{
+    boost::lockfree::detail::atomic<long> counter(0);
+    {
+        thread_pool pool(4);
+        BOOST_REQUIRE_EQUAL(pool.workers(), 4u);
+
+        increment task = {&counter};
+        for (int i = 0; i != 10000; ++i)
+            pool.submit(task);
+    }
+
+    /* the destructor runs all remaining tasks */
+    BOOST_REQUIRE_EQUAL(counter, 10000);
+}
+
+BOOST_AUTO_TEST_CASE( thread_pool_batch_test )
+{
+    boost::lockfree::detail::atomic<long> counter(0);
+    thread_pool pool(3);
+
+    increment task = {&counter};
+    vector<increment> batch(1000, task);
+
+    /* wake up parked workers */
+    for (int i = 0; i != 5; ++i) {
+        boost::this_thread::sleep(boost::posix_time::milliseconds(20));
+        pool.submit(batch.begin(), batch.end());
+        wait_for(counter, (i + 1) * 1000);
+    }
+
+    boost::this_thread::sleep(boost::posix_time::milliseconds(20));
+    pool.submit(task);
+    wait_for(counter, 5001);
+}
+
+BOOST_AUTO_TEST_CASE( thread_pool_nested_test )
+{
+    boost::lockfree::detail::atomic<long> leaves(0);
+    thread_pool pool(4);
+
+    spawn root = {&pool, &leaves, 16};
+    pool.submit(root);
+    wait_for(leaves, 1 << 16);
+}
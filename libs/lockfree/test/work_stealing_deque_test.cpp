@@ -0,0 +1,131 @@
+#include <boost/lockfree/work_stealing_deque.hpp>
+
+#include <climits>
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <boost/thread.hpp>
+
+using namespace boost;
+using namespace boost::lockfree;
+using namespace std;
+
+BOOST_AUTO_TEST_CASE( work_stealing_deque_simple_test )
+{
+    work_stealing_deque<int> d(4);
+    BOOST_REQUIRE(d.empty());
+
+    int out;
+    BOOST_REQUIRE(!d.pop(out));
+    BOOST_REQUIRE(!d.steal(out));
+
+    /* the array grows beyond its initial capacity */
+    for (int i = 0; i != 100; ++i)
+        d.push(i);
+    BOOST_REQUIRE(!d.empty());
+
+    /* the owner pops in lifo order, thieves steal in fifo order */
+    BOOST_REQUIRE(d.pop(out));
+    BOOST_REQUIRE_EQUAL(out, 99);
+    BOOST_REQUIRE(d.steal(out));
+    BOOST_REQUIRE_EQUAL(out, 0);
+
+    for (int i = 98; i != 0; --i) {
+        BOOST_REQUIRE(d.pop(out));
+        BOOST_REQUIRE_EQUAL(out, i);
+    }
+    BOOST_REQUIRE(!d.pop(out));
+    BOOST_REQUIRE(!d.steal(out));
+    BOOST_REQUIRE(d.empty());
+}
+
+BOOST_AUTO_TEST_CASE( work_stealing_deque_wraparound_test )
+{
+    work_stealing_deque<int> d(8);
+
+    int out;
+    for (int i = 0; i != 1000; ++i) {
+        d.push(2 * i);
+        d.push(2 * i + 1);
+        BOOST_REQUIRE(d.steal(out));
+        BOOST_REQUIRE_EQUAL(out, 2 * i);
+        BOOST_REQUIRE(d.pop(out));
+        BOOST_REQUIRE_EQUAL(out, 2 * i + 1);
+    }
+    BOOST_REQUIRE(d.empty());
+}
+
+static const long nodes = 1000000;
+static const int thieves = 3;
+
+struct work_stealing_deque_tester
+{
+    work_stealing_deque<long> d;
+    boost::lockfree::detail::atomic<long> taken;
+    long sums[thieves + 1];
+    long counts[thieves + 1];
+
+    work_stealing_deque_tester(void):
+        d(16), taken(0)
+    {}
+
+    void account(int thread, long value)
+    {
+        sums[thread] += value;
+        counts[thread] += 1;
+        ++taken;
+    }
+
+    /* the owner pushes all nodes and pops every other one */
+    void own(void)
+    {
+        sums[0] = counts[0] = 0;
+        for (long i = 0; i != nodes; ++i) {
+            d.push(i);
+            long out;
+            if (i % 2 && d.pop(out))
+                account(0, out);
+        }
+
+        long out;
+        while (d.pop(out))
+            account(0, out);
+    }
+
+    void steal(int thread)
+    {
+        sums[thread] = counts[thread] = 0;
+        while (taken != nodes) {
+            long out;
+            if (d.steal(out))
+                account(thread, out);
+            else
+                boost::thread::yield();
+        }
+    }
+
+    void run(void)
+    {
+        thread_group threads;
+        for (int i = 1; i <= thieves; ++i)
+            threads.create_thread(boost::bind(&work_stealing_deque_tester::steal, this, i));
+        own();
+        threads.join_all();
+
+        long sum = 0, count = 0;
+        for (int i = 0; i <= thieves; ++i) {
+            sum += sums[i];
+            count += counts[i];
+        }
+        BOOST_REQUIRE_EQUAL(count, nodes);
+        BOOST_REQUIRE_EQUAL(sum, nodes * (nodes - 1) / 2);
+        BOOST_REQUIRE(d.empty());
+    }
+};
+
+BOOST_AUTO_TEST_CASE( work_stealing_deque_test )
+{
+    work_stealing_deque_tester tester;
+    tester.run();
+}